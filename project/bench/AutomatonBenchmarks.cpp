@@ -0,0 +1,173 @@
+/*
+ * AutomatonBenchmarks.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Microbenchmark delle operazioni sugli automi: ricerca di uno stato per nome, traduzione di un DFA e
+ * ri-traduzione (incrementale o completa) con ESC.
+ * L'argomento è il numero di stati dell'automa.
+ *
+ */
+
+#include "Benchmark.hpp"
+
+#include "Automaton.hpp"
+#include "Configurations.hpp"
+#include "EmbeddedSubsetConstruction.hpp"
+#include "Translation.hpp"
+
+#define BENCH_ALPHABET_SIZE 	8		// Cardinalità dell'alfabeto del DFA da tradurre
+
+namespace translated_automata {
+
+	/**
+	 * Ricerca di uno stato per nome, scorrendo gli stati in un ordine che non segue quello di inserimento
+	 * (tempo per ricerca).
+	 */
+	static void BM_AutomatonGetState(BenchmarkState& state) {
+		unsigned int size = state.getArgument();
+		NFA* nfa = new NFA();
+		vector<string> names;
+		for (unsigned int i = 0; i < size; i++) {
+			names.push_back("s" + std::to_string(i));
+			nfa->addState(new StateNFA(names.back()));
+		}
+
+		unsigned int index = 0;
+		while (state.keepRunning()) {
+			doNotOptimize(nfa->getState(names[index]));
+			index = (index + 7919) % size;
+		}
+
+		delete nfa;
+	}
+	BENCHMARK(BM_AutomatonGetState)->range(8, 4096);
+
+	/**
+	 * Costruisce un DFA completo con "size" stati sull'alfabeto a0, a1, ... del benchmark.
+	 */
+	static DFA* buildCompleteDFA(unsigned int size) {
+		DFA* dfa = new DFA();
+		vector<StateDFA*> states;
+		for (unsigned int i = 0; i < size; i++) {
+			StateDFA* dfa_state = new StateDFA("q" + std::to_string(i), i % 5 == 0);
+			dfa->addState(dfa_state);
+			states.push_back(dfa_state);
+		}
+		dfa->setInitialState(states[0]);
+
+		for (unsigned int l = 0; l < BENCH_ALPHABET_SIZE; l++) {
+			string label = "a" + std::to_string(l);
+			for (unsigned int i = 0; i < size; i++) {
+				dfa->connectStates(states[i], states[(i * 31 + l * 17 + 1) % size], label);
+			}
+		}
+		return dfa;
+	}
+
+	/**
+	 * Traduzione di un DFA completo, con una traduzione che unisce le label a coppie e produce
+	 * quindi un NFA (tempo per stato del DFA).
+	 */
+	static void BM_TranslationTranslate(BenchmarkState& state) {
+		unsigned int size = state.getArgument();
+		DFA* dfa = buildCompleteDFA(size);
+
+		map<string, string> translation_map;
+		for (unsigned int l = 0; l < BENCH_ALPHABET_SIZE; l++) {
+			translation_map["a" + std::to_string(l)] = "a" + std::to_string(l / 2);
+		}
+		Translation* translation = new Translation(translation_map);
+
+		state.setItemsPerIteration(size);
+		while (state.keepRunning()) {
+			NFA* translated = translation->translate(dfa);
+			state.pauseTiming();
+			delete translated;
+			state.resumeTiming();
+		}
+
+		delete translation;
+		delete dfa;
+	}
+	BENCHMARK(BM_TranslationTranslate)->range(8, 4096);
+
+	/**
+	 * Coppia di traduzioni utilizzate alternativamente dai benchmark di ri-traduzione: l'identità e la
+	 * traduzione che scambia le label a0 e a1. Entrambe mantengono il DFA deterministico, così che la
+	 * dimensione del risultato non cambi e venga misurato solamente l'aggiornamento.
+	 */
+	static vector<Translation*> buildAlternateTranslations() {
+		map<string, string> translation_map;
+		for (unsigned int l = 0; l < BENCH_ALPHABET_SIZE; l++) {
+			translation_map["a" + std::to_string(l)] = "a" + std::to_string(l);
+		}
+		Translation* first = new Translation(translation_map);
+		translation_map["a0"] = "a1";
+		translation_map["a1"] = "a0";
+		return { first, new Translation(translation_map) };
+	}
+
+	/**
+	 * Ri-traduzione incrementale di ESC (runIncrementalTranslation + runBudProcessing) di un DFA completo,
+	 * alternando due traduzioni che differiscono per due label (tempo per ri-traduzione).
+	 * Nota: nel DFA completo le label modificate escono da tutti gli stati, che vengono quindi tutti coinvolti:
+	 * si tratta del caso peggiore della ri-traduzione incrementale.
+	 */
+	static void BM_ESCIncrementalTranslation(BenchmarkState& state) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+		DFA* dfa = buildCompleteDFA(state.getArgument());
+		vector<Translation*> translations = buildAlternateTranslations();
+		esc.runAutomatonTranslation(dfa, translations[0]);
+		esc.runBudProcessing();
+
+		unsigned int index = 0;
+		while (state.keepRunning()) {
+			index = 1 - index;
+			esc.runIncrementalTranslation(translations[index]);
+			esc.runBudProcessing();
+		}
+
+		DFA* result = esc.getResult();
+		esc.releaseResult();
+		delete result;
+		for (Translation* translation : translations) {
+			delete translation;
+		}
+		delete dfa;
+	}
+	BENCHMARK(BM_ESCIncrementalTranslation)->range(8, 1024);
+
+	/**
+	 * Come il benchmark precedente, ma con la traduzione completa (runAutomatonTranslation + runBudProcessing)
+	 * ad ogni cambio di traduzione, come riferimento per la ri-traduzione incrementale (tempo per ri-traduzione).
+	 */
+	static void BM_ESCFullTranslation(BenchmarkState& state) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+		DFA* dfa = buildCompleteDFA(state.getArgument());
+		vector<Translation*> translations = buildAlternateTranslations();
+
+		unsigned int index = 0;
+		while (state.keepRunning()) {
+			index = 1 - index;
+			esc.runAutomatonTranslation(dfa, translations[index]);
+			esc.runBudProcessing();
+			state.pauseTiming();
+			DFA* result = esc.getResult();
+			esc.releaseResult();
+			delete result;
+			state.resumeTiming();
+		}
+
+		for (Translation* translation : translations) {
+			delete translation;
+		}
+		delete dfa;
+	}
+	BENCHMARK(BM_ESCFullTranslation)->range(8, 1024);
+
+} /* namespace translated_automata */
@@ -0,0 +1,275 @@
+/*
+ * Benchmark.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione del framework dei microbenchmark e del main che li esegue.
+ *
+ * 	Usage: "bin/bench [filtro] [-r <ripetizioni>] [-t <ms>] [-o <file.csv>]"
+ * 		filtro		Esegue solamente i benchmark il cui nome contiene la stringa indicata
+ * 		-r			Numero di ripetizioni indipendenti per ciascun argomento (default 10)
+ * 		-t			Durata minima [ms] di ciascuna ripetizione, usata per calibrare le iterazioni (default 20)
+ * 		-o			Scrive i risultati anche in un file CSV, per il confronto fra versioni differenti
+ *
+ * I tempi riportati sono per elemento elaborato (si veda "setItemsPerIteration"), in nanosecondi.
+ *
+ */
+
+#include "Benchmark.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+
+#include "Statistics.hpp"
+
+#define DEFAULT_REPETITIONS 		10			// Ripetizioni di default per ciascun argomento
+#define DEFAULT_MIN_TIME_MS 		20			// Durata minima di default di una ripetizione [ms]
+#define MAX_ITERATIONS 				1000000000	// Numero massimo di iterazioni di una ripetizione
+
+namespace translated_automata {
+
+// CLASSE "BenchmarkState"
+
+	/**
+	 * Costruttore.
+	 */
+	BenchmarkState::BenchmarkState(long int argument, unsigned long int iterations) {
+		this->m_argument = argument;
+		this->m_iterations = iterations;
+		this->m_remaining = iterations;
+		this->m_elapsed = std::chrono::nanoseconds::zero();
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	BenchmarkState::~BenchmarkState() {}
+
+	/**
+	 * Restituisce l'argomento (la dimensione del problema) con cui viene eseguito il benchmark.
+	 */
+	long int BenchmarkState::getArgument() const {
+		return this->m_argument;
+	}
+
+	unsigned long int BenchmarkState::getIterations() const {
+		return this->m_iterations;
+	}
+
+	unsigned long int BenchmarkState::getRemainingIterations() const {
+		return this->m_remaining;
+	}
+
+	/**
+	 * Imposta il numero di elementi elaborati in una iterazione, per riportare il tempo per elemento.
+	 */
+	void BenchmarkState::setItemsPerIteration(unsigned long int items) {
+		this->m_items_per_iteration = (items > 0) ? items : 1;
+	}
+
+	unsigned long int BenchmarkState::getItemsPerIteration() const {
+		return this->m_items_per_iteration;
+	}
+
+	/**
+	 * Restituisce il tempo misurato complessivamente, in nanosecondi.
+	 */
+	double BenchmarkState::getElapsedNanoseconds() const {
+		return (double) this->m_elapsed.count();
+	}
+
+	/**
+	 * Sospende la misura del tempo, ad esempio per preparare i dati di una iterazione.
+	 */
+	void BenchmarkState::pauseTiming() {
+		if (this->m_running) {
+			this->m_elapsed += std::chrono::steady_clock::now() - this->m_start;
+			this->m_running = false;
+		}
+	}
+
+	/**
+	 * Riprende la misura del tempo.
+	 */
+	void BenchmarkState::resumeTiming() {
+		if (!this->m_running) {
+			this->m_running = true;
+			this->m_start = std::chrono::steady_clock::now();
+		}
+	}
+
+// CLASSE "Benchmark"
+
+	/**
+	 * Costruttore.
+	 */
+	Benchmark::Benchmark(const string& name, std::function<void(BenchmarkState&)> function) {
+		this->m_name = name;
+		this->m_function = function;
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	Benchmark::~Benchmark() {}
+
+	/**
+	 * Aggiunge un argomento per cui eseguire il benchmark.
+	 */
+	Benchmark* Benchmark::argument(long int argument) {
+		this->m_arguments.push_back(argument);
+		return this;
+	}
+
+	/**
+	 * Aggiunge gli argomenti da "start" a "end" (inclusi), in progressione geometrica di ragione "multiplier".
+	 */
+	Benchmark* Benchmark::range(long int start, long int end, long int multiplier) {
+		if (start <= 0 || multiplier <= 1) {
+			throw "Intervallo di argomenti non valido";
+		}
+		for (long int argument = start; argument < end; argument *= multiplier) {
+			this->m_arguments.push_back(argument);
+		}
+		this->m_arguments.push_back(end);
+		return this;
+	}
+
+	const string& Benchmark::getName() const {
+		return this->m_name;
+	}
+
+	const vector<long int>& Benchmark::getArguments() const {
+		return this->m_arguments;
+	}
+
+	/**
+	 * Esegue il benchmark con l'argomento e il numero di iterazioni specificati.
+	 */
+	BenchmarkState Benchmark::run(long int argument, unsigned long int iterations) {
+		BenchmarkState state = BenchmarkState(argument, iterations);
+		this->m_function(state);
+		if (state.getRemainingIterations() > 0) {
+			throw "Il benchmark è terminato senza completare le iterazioni richieste";
+		}
+		return state;
+	}
+
+	/**
+	 * Metodo statico.
+	 * Registra un nuovo benchmark e lo restituisce, per permettere di specificarne gli argomenti.
+	 */
+	Benchmark* Benchmark::registerBenchmark(const string& name, std::function<void(BenchmarkState&)> function) {
+		Benchmark* benchmark = new Benchmark(name, function);
+		Benchmark::getRegisteredBenchmarks().push_back(benchmark);
+		return benchmark;
+	}
+
+	/**
+	 * Metodo statico.
+	 * Restituisce la lista dei benchmark registrati, nell'ordine di registrazione.
+	 * Nota: la lista è creata al primo utilizzo, poiché la registrazione avviene durante l'inizializzazione
+	 * degli oggetti statici, in un ordine non definito fra i diversi file.
+	 */
+	vector<Benchmark*>& Benchmark::getRegisteredBenchmarks() {
+		static vector<Benchmark*> benchmarks;
+		return benchmarks;
+	}
+
+	/**
+	 * Calibra il numero di iterazioni in modo che una ripetizione duri almeno il tempo minimo.
+	 * Le esecuzioni di calibrazione fungono anche da riscaldamento delle cache e dell'allocatore.
+	 */
+	static unsigned long int calibrateIterations(Benchmark* benchmark, long int argument, double min_time_ns) {
+		unsigned long int iterations = 1;
+		while (iterations < MAX_ITERATIONS) {
+			double elapsed = benchmark->run(argument, iterations).getElapsedNanoseconds();
+			if (elapsed >= min_time_ns) {
+				break;
+			}
+			// Stima delle iterazioni necessarie, con un margine, limitando la crescita ad ogni passo
+			double factor = (elapsed > 0) ? 1.4 * min_time_ns / elapsed : 10;
+			factor = std::min(std::max(factor, 2.), 10.);
+			iterations = std::min((unsigned long int) (iterations * factor), (unsigned long int) MAX_ITERATIONS);
+		}
+		return iterations;
+	}
+
+} /* namespace translated_automata */
+
+using namespace translated_automata;
+
+int main(int argc, char** argv) {
+	string filter = "";
+	unsigned int repetitions = DEFAULT_REPETITIONS;
+	double min_time_ms = DEFAULT_MIN_TIME_MS;
+	string output_path = "";
+
+	for (int i = 1; i < argc; i++) {
+		string argument = argv[i];
+		if ((argument == "-r" || argument == "-t" || argument == "-o") && i + 1 < argc) {
+			string value = argv[++i];
+			if (argument == "-r") {
+				repetitions = std::max(atoi(value.c_str()), 1);
+			} else if (argument == "-t") {
+				min_time_ms = std::max(atof(value.c_str()), 0.);
+			} else {
+				output_path = value;
+			}
+		} else if (argument[0] == '-') {
+			std::cerr << "Usage: " << argv[0] << " [filtro] [-r <ripetizioni>] [-t <ms>] [-o <file.csv>]" << std::endl;
+			return 1;
+		} else {
+			filter = argument;
+		}
+	}
+
+	std::ofstream output;
+	if (!output_path.empty()) {
+		output.open(output_path);
+		output << "Benchmark, Argument, Iterations, Repetitions, Mean [ns], StdDev [ns], Median [ns], Min [ns]" << std::endl;
+	}
+
+	printf("%-44s|%12s |%12s |%12s |%8s |%12s |%12s |\n",
+			"Benchmark [ns per item]", "Iterations", "Mean", "StdDev", "CV [%]", "Median", "Min");
+	try {
+		for (Benchmark* benchmark : Benchmark::getRegisteredBenchmarks()) {
+			if (benchmark->getName().find(filter) == string::npos) {
+				continue;
+			}
+			vector<long int> arguments = benchmark->getArguments();
+			if (arguments.empty()) {
+				arguments.push_back(0);
+			}
+
+			for (long int argument : arguments) {
+				unsigned long int iterations = calibrateIterations(benchmark, argument, min_time_ms * 1000000);
+				StatAccumulator stats = StatAccumulator();
+				for (unsigned int r = 0; r < repetitions; r++) {
+					BenchmarkState state = benchmark->run(argument, iterations);
+					stats.add(state.getElapsedNanoseconds() / (iterations * state.getItemsPerIteration()));
+				}
+
+				string name = benchmark->getName() + "/" + std::to_string(argument);
+				double cv = (stats.getMean() > 0) ? (100 * stats.getStandardDeviation() / stats.getMean()) : 0;
+				printf("%-44s|%12lu |%12.2f |%12.2f |%8.2f |%12.2f |%12.2f |\n",
+						name.c_str(), iterations, stats.getMean(), stats.getStandardDeviation(), cv, stats.getQuantile(0.5), stats.getMin());
+				fflush(stdout);
+
+				if (output.is_open()) {
+					output << benchmark->getName() << ", " << argument << ", " << iterations << ", " << repetitions << ", "
+							<< stats.getMean() << ", " << stats.getStandardDeviation() << ", "
+							<< stats.getQuantile(0.5) << ", " << stats.getMin() << std::endl;
+				}
+			}
+		}
+	} catch (const char* error) {
+		std::cerr << "Errore durante l'esecuzione dei benchmark: " << error << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
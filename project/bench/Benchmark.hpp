@@ -0,0 +1,127 @@
+/*
+ * Benchmark.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Framework minimale per i microbenchmark delle primitive del progetto, sul modello di Google Benchmark.
+ * Un benchmark è una funzione che riceve un oggetto BenchmarkState: i dati vengono preparati prima del
+ * ciclo "while (state.keepRunning())", il cui corpo è l'unica parte misurata.
+ * Ogni benchmark viene eseguito per ciascuno degli argomenti (dimensioni) registrati: il numero di
+ * iterazioni viene calibrato in modo che una ripetizione duri almeno un tempo minimo, quindi vengono
+ * eseguite più ripetizioni indipendenti, di cui si riportano media, deviazione standard, mediana e minimo.
+ *
+ * 	Usage:
+ * 		static void BM_Operazione(BenchmarkState& state) {
+ * 			... preparazione con dimensione state.getArgument() ...
+ * 			while (state.keepRunning()) {
+ * 				doNotOptimize(operazione());
+ * 			}
+ * 		}
+ * 		BENCHMARK(BM_Operazione)->range(8, 4096);
+ *
+ */
+
+#ifndef BENCH_BENCHMARK_HPP_
+#define BENCH_BENCHMARK_HPP_
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/** Registrazione di un benchmark, da utilizzare a livello di file */
+#define _BENCHMARK_CONCAT( x, y )	x ## y
+#define BENCHMARK_CONCAT( x, y )	_BENCHMARK_CONCAT( x, y )
+#define BENCHMARK( function ) \
+	static translated_automata::Benchmark* BENCHMARK_CONCAT(benchmark_, __LINE__) = \
+			translated_automata::Benchmark::registerBenchmark(#function, function)
+
+namespace translated_automata {
+
+	/**
+	 * Impedisce al compilatore di eliminare il calcolo di un valore che non viene utilizzato.
+	 */
+	template <class T>
+	inline void doNotOptimize(const T& value) {
+		asm volatile("" : : "r,m"(value) : "memory");
+	}
+
+	/**
+	 * Stato di una singola esecuzione di un benchmark: argomento, iterazioni da eseguire e tempo misurato.
+	 */
+	class BenchmarkState {
+
+	private:
+		long int m_argument;								// Dimensione del problema
+		unsigned long int m_iterations;						// Numero di iterazioni richieste
+		unsigned long int m_remaining;						// Numero di iterazioni ancora da eseguire
+		unsigned long int m_items_per_iteration = 1;		// Numero di elementi elaborati in una iterazione
+		bool m_started = false;
+		bool m_running = false;
+		std::chrono::steady_clock::time_point m_start;
+		std::chrono::nanoseconds m_elapsed;
+
+	public:
+		BenchmarkState(long int argument, unsigned long int iterations);
+		~BenchmarkState();
+
+		long int getArgument() const;
+		unsigned long int getIterations() const;
+		unsigned long int getRemainingIterations() const;
+		void setItemsPerIteration(unsigned long int items);
+		unsigned long int getItemsPerIteration() const;
+		double getElapsedNanoseconds() const;
+		void pauseTiming();
+		void resumeTiming();
+
+		/**
+		 * Restituisce TRUE finché ci sono iterazioni da eseguire.
+		 * La misura del tempo inizia alla prima chiamata e termina all'ultima.
+		 */
+		inline bool keepRunning() {
+			if (!this->m_started) {
+				this->m_started = true;
+				this->resumeTiming();
+			}
+			if (this->m_remaining == 0) {
+				this->pauseTiming();
+				return false;
+			}
+			this->m_remaining--;
+			return true;
+		}
+
+	};
+
+	/**
+	 * Benchmark registrato, con la lista degli argomenti per cui deve essere eseguito.
+	 */
+	class Benchmark {
+
+	private:
+		string m_name;
+		std::function<void(BenchmarkState&)> m_function;
+		vector<long int> m_arguments;
+
+	public:
+		Benchmark(const string& name, std::function<void(BenchmarkState&)> function);
+		~Benchmark();
+
+		Benchmark* argument(long int argument);
+		Benchmark* range(long int start, long int end, long int multiplier = 8);
+
+		const string& getName() const;
+		const vector<long int>& getArguments() const;
+		BenchmarkState run(long int argument, unsigned long int iterations);
+
+		static Benchmark* registerBenchmark(const string& name, std::function<void(BenchmarkState&)> function);
+		static vector<Benchmark*>& getRegisteredBenchmarks();
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* BENCH_BENCHMARK_HPP_ */
@@ -0,0 +1,104 @@
+/*
+ * BudBenchmarks.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Microbenchmark della lista ordinata di Bud utilizzata da ESC: inserimento, estrazione e riordinamento.
+ * L'argomento è il numero di bud presenti nella lista.
+ *
+ */
+
+#include "Benchmark.hpp"
+
+#include "Bud.hpp"
+
+#define BENCH_BUD_LABELS 		4		// Numero di bud (label differenti) per ciascuno stato
+#define BENCH_BUD_DISTANCES 	16		// Numero di distanze differenti assegnate agli stati
+
+namespace translated_automata {
+
+	/**
+	 * Insieme di stati DFA costruiti, con estensioni di un solo stato NFA e distanze distribuite
+	 * su un numero limitato di valori, come avviene nei livelli di un automa.
+	 */
+	class BudFixture {
+
+	public:
+		vector<StateNFA*> nfa_states;
+		vector<ConstructedStateDFA*> dfa_states;
+		vector<string> labels;
+
+		BudFixture(unsigned int buds) {
+			unsigned int size = (buds + BENCH_BUD_LABELS - 1) / BENCH_BUD_LABELS;
+			for (unsigned int i = 0; i < size; i++) {
+				StateNFA* nfa_state = new StateNFA("s" + std::to_string(i));
+				ExtensionDFA extension;
+				extension.insert(nfa_state);
+				ConstructedStateDFA* dfa_state = new ConstructedStateDFA(extension);
+				dfa_state->setDistance((i * 7) % BENCH_BUD_DISTANCES);
+				// Il nome viene calcolato subito, poiché è utilizzato nel confronto fra i bud
+				dfa_state->resolveName();
+				this->nfa_states.push_back(nfa_state);
+				this->dfa_states.push_back(dfa_state);
+			}
+			for (unsigned int l = 0; l < BENCH_BUD_LABELS; l++) {
+				this->labels.push_back("a" + std::to_string(l));
+			}
+		}
+
+		~BudFixture() {
+			for (ConstructedStateDFA* dfa_state : this->dfa_states) {
+				delete dfa_state;
+			}
+			for (StateNFA* nfa_state : this->nfa_states) {
+				delete nfa_state;
+			}
+		}
+
+		/**
+		 * Inserisce nella lista i primi "buds" bud, alternando gli stati.
+		 */
+		void fill(BudsList& list, unsigned int buds) {
+			unsigned int size = this->dfa_states.size();
+			for (unsigned int i = 0; i < buds; i++) {
+				list.insert(this->dfa_states[i % size], this->labels[i / size]);
+			}
+		}
+
+	};
+
+	/**
+	 * Inserimento di N bud e successiva estrazione di tutti i bud in ordine (tempo per bud).
+	 */
+	static void BM_BudsListInsertPop(BenchmarkState& state) {
+		unsigned int buds = state.getArgument();
+		BudFixture fixture = BudFixture(buds);
+		BudsList list;
+
+		state.setItemsPerIteration(buds);
+		while (state.keepRunning()) {
+			fixture.fill(list, buds);
+			while (!list.empty()) {
+				doNotOptimize(list.pop());
+			}
+		}
+	}
+	BENCHMARK(BM_BudsListInsertPop)->range(8, 4096);
+
+	/**
+	 * Riordinamento di una lista di N bud (tempo per bud).
+	 */
+	static void BM_BudsListSort(BenchmarkState& state) {
+		unsigned int buds = state.getArgument();
+		BudFixture fixture = BudFixture(buds);
+		BudsList list;
+		fixture.fill(list, buds);
+
+		state.setItemsPerIteration(buds);
+		while (state.keepRunning()) {
+			list.sort();
+		}
+	}
+	BENCHMARK(BM_BudsListSort)->range(8, 4096);
+
+} /* namespace translated_automata */
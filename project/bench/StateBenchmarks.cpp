@@ -0,0 +1,147 @@
+/*
+ * StateBenchmarks.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Microbenchmark delle primitive degli stati: inserimento e rimozione delle transizioni,
+ * epsilon-chiusura, l-chiusura e nome di un'estensione.
+ * L'argomento è il numero di stati coinvolti; gli automi sono costruiti in modo deterministico,
+ * così che le misure di versioni differenti del codice siano confrontabili.
+ *
+ */
+
+#include "Benchmark.hpp"
+
+#include "Alphabet.hpp"
+#include "Automaton.hpp"
+#include "State.hpp"
+
+#define BENCH_LABELS 	4		// Numero di label (non epsilon) utilizzate negli automi dei benchmark
+
+namespace translated_automata {
+
+	static string labelOf(unsigned int index) {
+		return "a" + std::to_string(index % BENCH_LABELS);
+	}
+
+	/**
+	 * Costruisce un NFA con "size" stati s0, s1, ..., in cui:
+	 * - le epsilon-transizioni formano un albero binario radicato in s0 (si = > s(2i+1), s(2i+2));
+	 * - ogni stato ha una transizione per ciascuna label verso uno stato pseudo-casuale.
+	 * L'epsilon-chiusura di s0 contiene quindi tutti gli stati dell'automa.
+	 */
+	static NFA* buildNFA(unsigned int size) {
+		NFA* nfa = new NFA();
+		vector<StateNFA*> states;
+		for (unsigned int i = 0; i < size; i++) {
+			StateNFA* state = new StateNFA("s" + std::to_string(i), i % 5 == 0);
+			nfa->addState(state);
+			states.push_back(state);
+		}
+		nfa->setInitialState(states[0]);
+		for (unsigned int i = 0; i < size; i++) {
+			for (unsigned int child = 2 * i + 1; child <= 2 * i + 2 && child < size; child++) {
+				nfa->connectStates(states[i], states[child], EPSILON);
+			}
+			for (unsigned int l = 0; l < BENCH_LABELS; l++) {
+				nfa->connectStates(states[i], states[(i * 31 + l * 17 + 1) % size], labelOf(l));
+			}
+		}
+		return nfa;
+	}
+
+	/**
+	 * Inserimento e successiva rimozione delle transizioni verso N figli (tempo per operazione).
+	 */
+	static void BM_StateConnectDisconnectChild(BenchmarkState& state) {
+		unsigned int size = state.getArgument();
+		StateNFA* parent = new StateNFA("parent");
+		vector<StateNFA*> children;
+		vector<string> labels;
+		for (unsigned int i = 0; i < size; i++) {
+			children.push_back(new StateNFA("c" + std::to_string(i)));
+			labels.push_back(labelOf(i));
+		}
+
+		state.setItemsPerIteration(2 * size);
+		while (state.keepRunning()) {
+			for (unsigned int i = 0; i < size; i++) {
+				parent->connectChild(labels[i], children[i]);
+			}
+			for (unsigned int i = 0; i < size; i++) {
+				parent->disconnectChild(labels[i], children[i]);
+			}
+		}
+
+		for (StateNFA* child : children) {
+			delete child;
+		}
+		delete parent;
+	}
+	BENCHMARK(BM_StateConnectDisconnectChild)->range(8, 4096);
+
+	/**
+	 * Epsilon-chiusura di un singolo stato che raggiunge tutti gli N stati dell'automa (tempo per stato).
+	 */
+	static void BM_ComputeEpsilonClosure(BenchmarkState& state) {
+		unsigned int size = state.getArgument();
+		NFA* nfa = buildNFA(size);
+		ExtensionDFA extension;
+		extension.insert(nfa->getInitialState());
+
+		state.setItemsPerIteration(size);
+		while (state.keepRunning()) {
+			doNotOptimize(ConstructedStateDFA::computeEpsilonClosure(extension));
+		}
+
+		delete nfa;
+	}
+	BENCHMARK(BM_ComputeEpsilonClosure)->range(8, 4096);
+
+	/**
+	 * L-chiusura di un'estensione di N stati, alternando le label (tempo per stato dell'estensione).
+	 */
+	static void BM_ComputeLClosureOfExtension(BenchmarkState& state) {
+		unsigned int size = state.getArgument();
+		NFA* nfa = buildNFA(size);
+		ExtensionDFA start;
+		start.insert(nfa->getInitialState());
+		ExtensionDFA extension = ConstructedStateDFA::computeEpsilonClosure(start);
+		ConstructedStateDFA* dfa_state = new ConstructedStateDFA(extension);
+		vector<string> labels;
+		for (unsigned int l = 0; l < BENCH_LABELS; l++) {
+			labels.push_back(labelOf(l));
+		}
+
+		unsigned int iteration = 0;
+		state.setItemsPerIteration(size);
+		while (state.keepRunning()) {
+			doNotOptimize(dfa_state->computeLClosureOfExtension(labels[iteration++ % BENCH_LABELS]));
+		}
+
+		delete dfa_state;
+		delete nfa;
+	}
+	BENCHMARK(BM_ComputeLClosureOfExtension)->range(8, 4096);
+
+	/**
+	 * Costruzione del nome di un'estensione di N stati (tempo per stato dell'estensione).
+	 */
+	static void BM_CreateNameFromExtension(BenchmarkState& state) {
+		unsigned int size = state.getArgument();
+		NFA* nfa = buildNFA(size);
+		ExtensionDFA extension;
+		for (StateNFA* member : nfa->getStatesVector()) {
+			extension.insert(member);
+		}
+
+		state.setItemsPerIteration(size);
+		while (state.keepRunning()) {
+			doNotOptimize(ConstructedStateDFA::createNameFromExtension(extension));
+		}
+
+		delete nfa;
+	}
+	BENCHMARK(BM_CreateNameFromExtension)->range(8, 4096);
+
+} /* namespace translated_automata */
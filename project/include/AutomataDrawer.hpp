@@ -12,6 +12,7 @@
 #include <string>
 
 #include "Automaton.hpp"
+#include "TableDFA.hpp"
 
 namespace translated_automata {
 
@@ -35,6 +36,24 @@ namespace translated_automata {
 
 	};
 
+	/**
+	 * Classe per la rappresentazione di un DFA in formato tabellare.
+	 * Le transizioni di ciascuno stato vengono lette direttamente dalla riga della tabella.
+	 */
+	class TableDFADrawer {
+
+	private:
+		const TableDFA* m_automaton;
+
+	public:
+		TableDFADrawer(const TableDFA* automaton);
+		virtual ~TableDFADrawer();
+
+		string asString();
+		void asDotFile(string filename);
+
+	};
+
 } /* namespace translated_automata */
 
 #endif /* INCLUDE_AUTOMATADRAWER_HPP_ */
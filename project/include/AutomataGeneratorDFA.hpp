@@ -25,8 +25,8 @@ namespace translated_automata {
 	private:
 		void generateStates(DFA& dfa);
 		StateDFA* getRandomState(DFA& dfa);
-		StateDFA* getRandomStateWithUnusedLabels(vector<StateDFA*>& states, map<StateDFA*, Alphabet>& unused_labels);
-		string extractRandomUnusedLabel(map<StateDFA*, Alphabet>& unused_labels, StateDFA* state);
+		StateDFA* getRandomStateWithUnusedLabels(vector<StateDFA*>& states, vector<Alphabet>& unused_labels);
+		string extractRandomUnusedLabel(vector<Alphabet>& unused_labels, StateDFA* state);
 
 	public:
 		DFAGenerator(Alphabet alphabet, Configurations* configurations);
@@ -22,9 +22,9 @@ namespace translated_automata {
 		void generateStates(NFA* nfa);
 		StateNFA* getRandomState(NFA* nfa);
 		StateNFA* getRandomState(vector<StateNFA*>& states);
-		StateNFA* getRandomStateWithUnusedLabels(vector<StateNFA*>& states, map<StateNFA*, Alphabet>& unused_labels);
-		StateNFA* getRandomStateWithUnusedLabels(map<StateNFA*, Alphabet>& unused_labels);
-		string extractRandomUnusedLabel(map<StateNFA*, Alphabet>& unused_labels, StateNFA* state);
+		StateNFA* getRandomStateWithUnusedLabels(vector<StateNFA*>& states, vector<Alphabet>& unused_labels);
+		StateNFA* getRandomSafeZoneState(vector<StateNFA*>& safe_zone_states, vector<Alphabet>& unused_labels);
+		string extractRandomUnusedLabel(vector<Alphabet>& unused_labels, StateNFA* state);
 
 	public:
 		NFAGenerator(Alphabet alphabet, Configurations* configurations);
@@ -7,6 +7,17 @@
  * che rappresenta in astratto un Automa a stati finiti.
  * Fornisce inoltre i due alias NFA e DFA.
  *
+ * Ciascuno stato dell'automa riceve un identificatore intero compreso fra 0 e n-1, assegnato in ordine
+ * di inserimento. Gli identificatori permettono di mantenere dati ausiliari sugli stati in semplici
+ * vettori (al posto di mappe indicizzate per puntatore) e determinano l'ordine in cui gli stati
+ * vengono restituiti. La rimozione di uno stato mantiene gli identificatori compatti: lo stato con
+ * l'identificatore più alto assume l'identificatore dello stato rimosso.
+ *
+ * Le transizioni entranti sono un indice inverso di quelle uscenti, necessario solamente agli algoritmi
+ * che risalgono ai genitori di uno stato. Un automa può essere costruito "in avanti" (senza indice),
+ * dimezzando la memoria e il lavoro per ogni transizione; l'indice viene ricostruito in blocco
+ * (trasponendo le transizioni uscenti) quando un algoritmo lo richiede.
+ *
  */
 
 #ifndef INCLUDE_AUTOMATON_H_
@@ -22,16 +33,14 @@ namespace translated_automata {
 
 	using std::vector;
 	using std::list;
-	using std::multiset;
 
 	template <class State>
 	class Automaton {
 
 	private:
-		multiset<State*> m_states;
+		vector<State*> m_states;		// Stati dell'automa, indicizzati per identificatore
 		State* m_initial_state;
-
-        void removeReachableStates(State* s, set<State*> &states); // INUTILE
+		bool m_incoming_index = true;	// Flag che indica se le transizioni entranti degli stati sono aggiornate
 
 	public:
 		Automaton();
@@ -49,12 +58,16 @@ namespace translated_automata {
         void setInitialState(string name);
         State* getInitialState();
         State* getState(string name);
+        State* getStateById(unsigned int id);
         const vector<State*> getStatesByName(string name);
         const list<State*> getStatesList();
         const vector<State*> getStatesVector();
         const Alphabet getAlphabet();
         bool connectStates(State *from, State *to, string label);
         bool connectStates(string from, string to, string label);
+        bool hasIncomingIndex();
+        void setForwardOnly();
+        void buildIncomingIndex();
 
         bool operator==(Automaton<State>& other);
 
@@ -18,10 +18,13 @@
 #define INCLUDE_BUD_HPP_
 
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "State.hpp"
 
 using std::set;
+using std::vector;
 
 namespace translated_automata {
 
@@ -36,6 +39,8 @@ namespace translated_automata {
 		Bud(ConstructedStateDFA* state, string label);
 		~Bud();
 
+		void reset(ConstructedStateDFA* state, const string& label);
+
 		ConstructedStateDFA* getState();
 		string getLabel();
 		string toString();
@@ -57,7 +62,16 @@ namespace translated_automata {
 	class BudsList {
 
 	private:
-		set<Bud*, BudComparator> m_set;
+		using BudsSet = set<Bud*, BudComparator>;
+
+		BudsSet m_set;
+		std::unordered_map<ConstructedStateDFA*, vector<BudsSet::iterator>> m_state_index;	// Bud presenti nella lista per ciascuno stato
+		vector<Bud*> m_free_buds;		// Bud non più utilizzati, riciclati dagli inserimenti successivi
+		Bud* m_popped_bud;				// Ultimo bud estratto, riciclato all'estrazione successiva
+
+		void unindex(BudsSet::iterator bud_iterator);
+		Bud* acquire(ConstructedStateDFA* state, const string& label);
+		void recycle(Bud* bud);
 
 	public:
 		BudsList();
@@ -65,9 +79,14 @@ namespace translated_automata {
 
 		bool empty();
 		bool insert(Bud* new_bud);
+		bool insert(ConstructedStateDFA* state, const string& label);
+		Bud* front();
 		Bud* pop();
+		vector<Bud*> getFrontLayer();
 		set<string> removeBudsOfState(ConstructedStateDFA* state);
+		void repositionBudsOfStates(vector<ConstructedStateDFA*>& states);
 		void sort();
+		void clear();
 		void printBuds();
 
 	};
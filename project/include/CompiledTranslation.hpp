@@ -0,0 +1,57 @@
+/*
+ * CompiledTranslation.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file CompiledTranslation.cpp.
+ * Versione "compilata" di una traduzione, da utilizzare sugli automi in formato FlatAutomaton.
+ * La traduzione viene trasformata in un vettore che associa a ciascun identificatore di label
+ * (secondo il LabelIndex dell'alfabeto originale) l'identificatore della label tradotta (secondo
+ * il LabelIndex dell'alfabeto tradotto). La label EPSILON ha un proprio identificatore riservato.
+ *
+ * Le traduzioni compilate possono essere composte e invertite direttamente sulle tabelle, in modo che
+ * una catena di traduzioni venga ridotta ad un'unica traduzione prima di essere applicata all'automa.
+ *
+ */
+
+#ifndef INCLUDE_COMPILEDTRANSLATION_HPP_
+#define INCLUDE_COMPILEDTRANSLATION_HPP_
+
+#include <vector>
+
+#include "FlatAutomaton.hpp"
+#include "LabelIndex.hpp"
+#include "Translation.hpp"
+
+namespace translated_automata {
+
+	class CompiledTranslation {
+
+	private:
+		LabelIndex m_source_index;			// Alfabeto originale
+		LabelIndex m_target_index;			// Alfabeto tradotto
+		vector<LabelId> m_table;			// Identificatore originale => identificatore tradotto
+		vector<uint32_t> m_preimage_offsets;	// Controimmagini in formato CSR, indicizzate per identificatore tradotto
+		vector<LabelId> m_preimage_labels;
+
+		CompiledTranslation(const LabelIndex& source_index, const LabelIndex& target_index, vector<LabelId>&& table);
+		void buildPreimages();
+
+	public:
+		CompiledTranslation(Translation* translation, const LabelIndex& source_index);
+		virtual ~CompiledTranslation();
+
+		const LabelIndex& getSourceLabelIndex() const;
+		const LabelIndex& getTargetLabelIndex() const;
+		LabelId translate(LabelId label) const;
+		FlatAutomaton translate(const FlatAutomaton& automaton) const;
+
+		CompiledTranslation compose(const CompiledTranslation& first) const;
+		vector<LabelId> preimage(LabelId label) const;
+		CompiledTranslation inverse() const;
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_COMPILEDTRANSLATION_HPP_ */
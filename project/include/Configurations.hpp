@@ -10,6 +10,7 @@
 
 #include <iostream>
 #include <map>
+#include <type_traits>
 #include <vector>
 
 #include "Debug.hpp"
@@ -40,6 +41,11 @@ namespace translated_automata {
 		ActiveAutomatonPruning,
 		ActiveRemovingLabel,
 		ActiveDistanceCheckInTranslation,
+		ActiveWavefrontProcessing,
+		ActiveHardwareCounters,
+		ActiveResultCache,
+		ResultCacheCapacity,
+		ActiveResultCacheSpill,
 
 		PrintStatistics,
 		LogStatistics,
@@ -130,6 +136,55 @@ namespace translated_automata {
 
 	};
 
+	/**
+	 * Istantanea dei valori CORRENTI delle configurazioni, con un campo tipizzato per ciascun parametro.
+	 * Viene ricostruita una sola volta per ogni caso di test (al caricamento e ad ogni "nextTestCase"),
+	 * così che generatori, algoritmi e raccolta dei risultati possano leggere i valori direttamente,
+	 * senza ricerche nella mappa, chiamate virtuali o conversioni.
+	 * La struttura è banalmente copiabile: può essere passata per valore (ad esempio ad altri thread)
+	 * senza mantenere alcun riferimento all'oggetto Configurations da cui è stata prodotta.
+	 */
+	struct ConfigurationsSnapshot {
+		int testcases;
+
+		int problem_type;
+
+		unsigned int alphabet_cardinality;
+		double translation_mixing_factor;
+		double translation_offset;
+		double epsilon_percentage;
+
+		int automaton_structure;
+		unsigned int automaton_size;
+		double automaton_final_probability;
+		double automaton_transitions_percentage;
+		int automaton_max_distance;
+		int automaton_safe_zone_distance;
+
+		bool active_automaton_pruning;
+		bool active_removing_label;
+		bool active_distance_check_in_translation;
+		bool active_wavefront_processing;
+		bool active_hardware_counters;
+		bool active_result_cache;
+		int result_cache_capacity;
+		bool active_result_cache_spill;
+
+		bool print_statistics;
+		bool log_statistics;
+		bool print_translation;
+		bool print_original_automaton;
+		bool print_sc_solution;
+		bool print_esc_solution;
+
+		bool draw_original_automaton;
+		bool draw_sc_solution;
+		bool draw_esc_solution;
+	};
+
+	static_assert(std::is_trivially_copyable<ConfigurationsSnapshot>::value,
+			"ConfigurationsSnapshot deve poter essere copiata come un semplice blocco di memoria");
+
 	/**
 	 * Lista di configurazioni, attualmente inizializzate runtime sulla base di quello che viene definito nel metodo "load".
 	 */
@@ -143,6 +198,8 @@ namespace translated_automata {
 		 */
 		struct Setting {
 			SettingID m_id;		// L'identificatore (enum) che rappresenta
+			string m_key;		// La chiave con cui viene assegnato nei file di configurazione e da riga di comando
+			SettingType m_type;	// Il tipo dei valori assegnati nei file di configurazione e da riga di comando
 			string m_name;		// Il nome completo che ne spiega brevemente lo scopo
 			string m_abbr;		// Il nome abbreviato o la sigla che lo identifica
 			bool m_test_param;	// Indica se il setting è utilizzato per il testing, e quindi deve essere stampato nei risultati
@@ -150,14 +207,21 @@ namespace translated_automata {
 
 		static const Setting settings_list[];					// Lista statica di tutte le configurazioni, inizializzata compile-time o all'avvio
 		map<SettingID, SettingValue*> m_settings_instances;		// Valori delle configurazioni in una specifica esecuzione del programma
+		ConfigurationsSnapshot m_snapshot;						// Valori correnti delle configurazioni, in forma tipizzata
+		string m_value_string;									// Valori correnti dei parametri di test, in forma testuale
+		bool m_snapshot_stale = true;							// Indica se l'istantanea deve essere ricostruita
 
 		static const Setting& getSetting(const SettingID& id);
+		static const Setting& findSetting(const string& key);
+		void store(const SettingID& id, SettingValue* value);
+		void refreshSnapshot();
 
 		/**
 		 * Carica un singolo parametro di configurazione all'interno della mappa.
 		 */
 		template <typename T> void load(const SettingID& id, T value) {
 			this->m_settings_instances.insert(std::make_pair(id, new AtomicSettingValue(value)));
+			this->m_snapshot_stale = true;
 		};
 
 		/**
@@ -165,6 +229,16 @@ namespace translated_automata {
 		 */
 		template <typename T> void load(const SettingID& id, vector<T> values) {
 			this->m_settings_instances.insert(std::make_pair(id, new CompositeSettingValue(values)));
+			this->m_snapshot_stale = true;
+		}
+
+		/**
+		 * Copia il valore corrente di un parametro nel campo dell'istantanea, se il parametro è stato caricato.
+		 */
+		template <typename T> void snapshotValue(const SettingID& id, T& field) {
+			if (this->m_settings_instances.count(id)) {
+				field = this->valueOf<T>(id);
+			}
 		}
 
 	public:
@@ -172,13 +246,16 @@ namespace translated_automata {
 		~Configurations();
 
 		void load();
+		void loadFile(const string& file_path);
+		void loadAssignment(const string& assignment);
 		static string nameOf(const SettingID& id);
 		static string abbreviationOf(const SettingID& id);
 		static bool isTestParam(const SettingID& id);
-		string getValueString();
+		const string& getValueString();
 		string toString();
 		string toString(const SettingID& id);
 		bool nextTestCase();
+		const ConfigurationsSnapshot& getSnapshot();
 
 		template <class T> T valueOf(const SettingID& id) {
 			DEBUG_ASSERT_TRUE(this->m_settings_instances.count(id));
@@ -0,0 +1,149 @@
+/*
+ * DenseAutomaton.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file DenseAutomaton.cpp.
+ * Rappresentazioni "dense" (compilate) di DFA e NFA, ottimizzate per il riconoscimento di parole.
+ * A differenza delle classi Automaton, costruite per essere modificate dagli algoritmi, queste
+ * rappresentazioni sono immutabili: gli stati sono numerati, le label sono identificate tramite
+ * un LabelIndex e le transizioni sono memorizzate in tabelle contigue.
+ *
+ * - DenseDFA: tabella di transizione (stato x label => stato successivo).
+ * - DenseNFA: simulazione "bitset-parallel", in cui l'insieme degli stati correnti è un bitset e
+ *   ogni passo unisce le righe pre-calcolate (già epsilon-chiuse) degli stati attivi.
+ *
+ * Entrambe le classi offrono una modalità "batch", che valuta molte parole in parallelo.
+ *
+ */
+
+#ifndef INCLUDE_DENSEAUTOMATON_HPP_
+#define INCLUDE_DENSEAUTOMATON_HPP_
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#include "Automaton.hpp"
+#include "LabelIndex.hpp"
+
+#define DENSE_BATCH_MIN_WORDS_PER_THREAD 64		// Numero minimo di parole per ciascun thread in modalità batch
+#define DENSE_STREAM_CHUNK_SIZE 16384			// Numero di label lette ad ogni lettura da uno stream
+#define DENSE_DFA_MAX_LANES 32					// Numero massimo di parole elaborate contemporaneamente dai kernel del DFA
+
+namespace translated_automata {
+
+	using std::vector;
+
+	/**
+	 * Classe astratta "DenseAutomaton".
+	 * Definisce l'interfaccia di riconoscimento comune e implementa la modalità batch.
+	 * Le parole sono sequenze di identificatori prodotti dal LabelIndex dell'automa; sono ammessi
+	 * tutti gli identificatori compresi nell'intervallo [0, getLabelIndex().getEpsilonId()], dove gli
+	 * ultimi due rappresentano le label sconosciute e la label EPSILON (che non modifica lo stato corrente).
+	 */
+	class DenseAutomaton {
+
+	protected:
+		LabelIndex m_label_index;
+		unsigned int m_columns;				// Numero di label, comprese la label sconosciuta e la label EPSILON
+
+		virtual void acceptsRange(const vector<vector<LabelId>>& words, vector<uint8_t>& results, unsigned long int begin, unsigned long int end);
+
+	public:
+		DenseAutomaton(const Alphabet& alphabet);
+		virtual ~DenseAutomaton();
+
+		const LabelIndex& getLabelIndex();
+		virtual bool accepts(const LabelId* word, unsigned long int length) = 0;
+		virtual bool accepts(std::istream& stream) = 0;
+		bool accepts(const vector<LabelId>& word);
+		vector<uint8_t> acceptsBatch(const vector<vector<LabelId>>& words, unsigned int threads_count = 0);
+
+	};
+
+	/**
+	 * Kernel utilizzabili dal DFA per la valutazione di più parole contemporaneamente.
+	 */
+	enum DenseDFAKernel {
+		DFA_KERNEL_SCALAR,		// 8 parole, letture scalari
+		DFA_KERNEL_AVX2,		// 16 parole, gather AVX2
+		DFA_KERNEL_AVX512,		// 32 parole, gather AVX-512
+	};
+
+	/**
+	 * Classe concreta "DenseDFA".
+	 * Gli stati sono rappresentati dall'offset della loro riga all'interno della tabella, in modo che
+	 * ogni passo di riconoscimento richieda una sola lettura di memoria. Alla tabella viene aggiunto
+	 * uno stato "pozzo" (non finale), destinazione di tutte le transizioni non definite.
+	 * La colonna della label EPSILON riporta ogni stato (compreso lo stato pozzo) in sé stesso: è utilizzata
+	 * anche dalla modalità batch come colonna di "riempimento", per allineare parole di lunghezza diversa.
+	 */
+	class DenseDFA : public DenseAutomaton {
+
+	private:
+		vector<uint32_t> m_table;			// Offset della riga dello stato successivo
+		vector<uint8_t> m_final;			// Flag di stato finale, indicizzato per numero di stato
+		uint32_t m_initial_offset;
+		LabelId m_padding_id;				// Colonna di riempimento (label EPSILON)
+		DenseDFAKernel m_kernel;
+
+		static void runLanesScalar(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states);
+		static void runLanesAVX2(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states);
+		static void runLanesAVX512(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states);
+
+	protected:
+		void acceptsRange(const vector<vector<LabelId>>& words, vector<uint8_t>& results, unsigned long int begin, unsigned long int end) override;
+
+	public:
+		DenseDFA(DFA* dfa);
+		virtual ~DenseDFA();
+
+		static DenseDFAKernel detectKernel();
+		static string nameOf(DenseDFAKernel kernel);
+
+		using DenseAutomaton::accepts;
+		unsigned int size();
+		DenseDFAKernel getKernel();
+		void setKernel(DenseDFAKernel kernel);
+		unsigned int getLanesCount();
+		uint32_t getInitialState();
+		uint32_t run(uint32_t state, const LabelId* word, unsigned long int length);
+		bool isFinal(uint32_t state);
+		bool accepts(const LabelId* word, unsigned long int length) override;
+		bool accepts(std::istream& stream) override;
+
+	};
+
+	/**
+	 * Classe concreta "DenseNFA".
+	 * Per ogni coppia (stato, label) viene pre-calcolato il bitset dell'epsilon-chiusura degli stati
+	 * raggiunti; la label sconosciuta corrisponde ad un bitset vuoto, mentre la label EPSILON corrisponde
+	 * all'epsilon-chiusura dello stato stesso (e quindi non modifica l'insieme degli stati correnti).
+	 */
+	class DenseNFA : public DenseAutomaton {
+
+	private:
+		unsigned int m_states_count;
+		unsigned int m_words_per_set;		// Numero di parole a 64 bit di ciascun bitset
+		vector<uint64_t> m_successors;		// Bitset per ogni coppia (stato, label)
+		vector<uint64_t> m_initial_set;
+		vector<uint64_t> m_final_set;
+
+		bool step(const uint64_t* current, uint64_t* next, LabelId label);
+		bool intersectsFinalSet(const uint64_t* set);
+
+	public:
+		DenseNFA(NFA* nfa);
+		virtual ~DenseNFA();
+
+		using DenseAutomaton::accepts;
+		unsigned int size();
+		bool accepts(const LabelId* word, unsigned long int length) override;
+		bool accepts(std::istream& stream) override;
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_DENSEAUTOMATON_HPP_ */
@@ -11,44 +11,103 @@
 #ifndef INCLUDE_EMBEDDEDSUBSETCONSTRUCTION_HPP_
 #define INCLUDE_EMBEDDEDSUBSETCONSTRUCTION_HPP_
 
+#include <unordered_map>
+
 #include "Automaton.hpp"
 #include "Bud.hpp"
 #include "Configurations.hpp"
+#include "Profiling.hpp"
+#include "RingQueue.hpp"
 #include "Translation.hpp"
+#include "WorkerPool.hpp"
+
+#define WAVEFRONT_MIN_BUDS_PER_THREAD 8		// Numero minimo di bud assegnati a ciascun thread durante il wavefront processing
 
 namespace translated_automata {
 
+	using std::unordered_map;
+
 	class EmbeddedSubsetConstruction {
 
 	private:
 		DFA* m_original_dfa;
 		Translation* m_translation;
 
-		BudsList* m_buds;
+		BudsList* m_buds;			// Lista dei bud, riutilizzata fra un problema e il successivo
 		NFA* m_reference_nfa;
 		DFA* m_translated_dfa;
 
 		bool m_active_removing_label;
 		bool m_active_automaton_pruning;
 		bool m_active_distance_check_in_translation;
+		bool m_active_wavefront_processing;
+
+		/** L-closure calcolata durante la fase parallela del wavefront processing */
+		struct PrecomputedLClosure {
+			unsigned long int extension_version;		// Versione dell'estensione da cui è stata calcolata
+			ExtensionDFA l_closure;
+		};
+
+		WorkerPool* m_worker_pool;													// Thread utilizzati per il pre-calcolo di ciascuno strato
+		unsigned int m_wavefront_distance;											// Distanza dell'ultimo strato pre-calcolato
+		map<pair<ConstructedStateDFA*, string>, PrecomputedLClosure> m_precomputed_l_closures;
+
+		// Strutture mantenute fra un problema di traduzione e il successivo, per la ri-traduzione incrementale
+		map<string, string> m_applied_translation;						// Traduzione applicata (label originale -> label tradotta)
+		vector<StateNFA*> m_reference_nfa_states;						// Stato dell'NFA di riferimento associato a ciascuno stato originale (per identificatore)
+		map<string, vector<StateDFA*>> m_original_states_by_label;		// Stati originali con transizioni uscenti marcate da ciascuna label
+		vector<vector<ConstructedStateDFA*>> m_containing_states;		// Stati del DFA risultante che contengono ciascuno stato dell'NFA di riferimento (per identificatore)
+		bool m_containing_index_active;									// Indica se l'indice inverso delle estensioni è mantenuto
+		unordered_map<const ExtensionDFA*, vector<ConstructedStateDFA*>> m_extension_states;	// Stati del DFA risultante per ciascuna estensione internata
+
+		// Strutture di lavoro svuotate (ma non deallocate) fra un problema e il successivo
+		vector<pair<StateNFA*, ConstructedStateDFA*>> m_translation_states_map;	// Stati creati da "Automaton Translation", per identificatore dello stato originale
+		vector<ConstructedStateDFA*> m_checkup_states_map;						// Stati creati da "Automaton Checkup", per identificatore dello stato dell'NFA
+
+		RingQueue<pair<StateDFA*, unsigned int>> m_relocation_queue;	// Coda riutilizzata da "Distance Relocation"
+		vector<ConstructedStateDFA*> m_relocated_states;				// Stati la cui distanza è stata modificata dall'ultima rilocazione
+
+		ESCProfile m_profile;		// Profilo dell'ultima esecuzione (popolato solo con PROFILING_MODE attiva)
 
 		void cleanInternalStatus();
 
-		void runDistanceRelocation(list<pair<StateDFA*, int>> relocation_sequence);
-		void runDistanceRelocation(StateDFA* state, int new_distance);
+		void runDistanceRelocation();
+		void runDistanceRelocation(StateDFA* state, unsigned int new_distance);
 		void runExtensionUpdate(ConstructedStateDFA* state, ExtensionDFA& new_extension);
 		void runAutomatonPruning(Bud* bud);
 
 		void addBudToList(ConstructedStateDFA* bud_state, string bud_label);
 
+		bool isEditingSessionActive();
+		void resetEditingStatus();
+		vector<ConstructedStateDFA*> getStatesContaining(StateNFA* nfa_state);
+		void buildContainingIndex();
+		void indexExtension(ConstructedStateDFA* state);
+		void unindexExtension(ConstructedStateDFA* state);
+		ConstructedStateDFA* getStateWithExtension(const ExtensionHandle& extension);
+		vector<ConstructedStateDFA*> getStatesWithExtension(const ExtensionHandle& extension);
+		void seedEpsilonEditBuds(StateNFA* nfa_state);
+		void runAutomatonCheckup(NFA* automaton, DFA* result);
+		void rebuildEditedResult();
+
+		void runWavefrontPrecomputation();
+		bool takePrecomputedLClosure(ConstructedStateDFA* state, string label, ExtensionDFA& l_closure);
+
 	public:
 		EmbeddedSubsetConstruction(Configurations* configurations);
 		~EmbeddedSubsetConstruction();
 
 		void runAutomatonTranslation(DFA* automaton, Translation* translation);
+		void runIncrementalTranslation(Translation* translation);
 		void runAutomatonCheckup(NFA* automaton);
 		void runBudProcessing();
+
+		bool addTransition(StateNFA* from, string label, StateNFA* to);
+		bool removeTransition(StateNFA* from, string label, StateNFA* to);
+		bool setFinal(StateNFA* state, bool final);
+		void releaseResult();
 		DFA* getResult();
+		const ESCProfile& getProfile();
 
 	};
 
@@ -0,0 +1,93 @@
+/*
+ * ExtensionPool.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file ExtensionPool.cpp.
+ * Insieme condiviso delle estensioni degli stati DFA costruiti.
+ * Le estensioni sono immutabili e vengono "internate": due stati con la stessa estensione (ad esempio
+ * gli stati omonimi che si generano durante l'ESC) condividono la stessa copia dell'insieme, tramite
+ * un riferimento con conteggio (ExtensionHandle). Quando l'ultimo riferimento viene rilasciato,
+ * l'estensione viene eliminata e rimossa dal pool.
+ *
+ * Nota: le estensioni sono insiemi di puntatori agli stati di un NFA, pertanto sono condivise solamente
+ * fra stati costruiti a partire dallo stesso NFA.
+ * Le estensioni vengono identificate tramite i numeri progressivi degli stati NFA (si veda StateNFA::getSerial)
+ * e non tramite i loro indirizzi: un DFA risultante può sopravvivere al proprio NFA, e gli indirizzi degli stati
+ * eliminati possono essere riutilizzati dagli stati di un NFA successivo. In questo modo un'estensione ancora
+ * in uso, ma riferita a stati eliminati, non viene mai restituita per gli stati di un altro NFA.
+ *
+ */
+
+#ifndef INCLUDE_EXTENSIONPOOL_HPP_
+#define INCLUDE_EXTENSIONPOOL_HPP_
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "State.hpp"
+
+namespace translated_automata {
+
+	using std::unordered_map;
+
+	/**
+	 * Chiave di un'estensione all'interno del pool: numeri progressivi degli stati che la compongono,
+	 * nell'ordine dell'estensione.
+	 */
+	using ExtensionKey = std::vector<unsigned long int>;
+
+	class ExtensionPool {
+
+	private:
+
+		/**
+		 * Estensione internata, insieme alla propria chiave.
+		 * La chiave rimane valida anche dopo l'eliminazione degli stati NFA dell'estensione.
+		 */
+		struct PooledExtension {
+			ExtensionDFA extension;
+			ExtensionKey key;
+		};
+
+		/**
+		 * Funzione di hash di una chiave, calcolata sui numeri progressivi degli stati.
+		 */
+		struct Hasher {
+			size_t operator()(const ExtensionKey* key) const;
+		};
+
+		/**
+		 * Confronto fra chiavi per contenuto.
+		 */
+		struct Equal {
+			bool operator()(const ExtensionKey* lhs, const ExtensionKey* rhs) const {
+				return *lhs == *rhs;
+			}
+		};
+
+		unordered_map<const ExtensionKey*, std::weak_ptr<const ExtensionDFA>, Hasher, Equal> m_extensions;
+		ExtensionKey m_lookup_key;				// Chiave dell'ultima estensione cercata, riutilizzata fra le ricerche
+		std::mutex m_mutex;
+
+		ExtensionPool();
+		ExtensionHandle lookup(const ExtensionDFA& extension);
+		ExtensionHandle share(PooledExtension* pooled);
+		void release(PooledExtension* pooled);
+
+	public:
+		virtual ~ExtensionPool();
+
+		static ExtensionPool& shared();
+
+		ExtensionHandle intern(const ExtensionDFA& extension);
+		ExtensionHandle intern(ExtensionDFA&& extension);
+		unsigned long int size();
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_EXTENSIONPOOL_HPP_ */
@@ -0,0 +1,70 @@
+/*
+ * FlatAutomaton.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file FlatAutomaton.cpp.
+ * Rappresentazione "piatta" e immutabile di un automa (DFA o NFA) in formato CSR (Compressed Sparse Row):
+ * gli stati sono numerati, le transizioni uscenti di ciascuno stato sono memorizzate in modo contiguo
+ * e le label sono rappresentate dagli identificatori di un LabelIndex.
+ *
+ * Le strutture che non dipendono dalle label (offset, destinazioni, stati finali e nomi) sono condivise
+ * fra le copie dell'automa: una traduzione produce un nuovo automa che riutilizza la stessa struttura,
+ * ricalcolando solamente il vettore delle label.
+ *
+ */
+
+#ifndef INCLUDE_FLATAUTOMATON_HPP_
+#define INCLUDE_FLATAUTOMATON_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Automaton.hpp"
+#include "LabelIndex.hpp"
+
+#define FLAT_NO_STATE UINT32_MAX	// Stato iniziale di un automa privo di stato iniziale
+
+namespace translated_automata {
+
+	using std::string;
+	using std::vector;
+	using std::shared_ptr;
+
+	class FlatAutomaton {
+
+	private:
+		LabelIndex m_label_index;
+		shared_ptr<const vector<uint32_t>> m_offsets;		// Indice della prima transizione di ciascuno stato (n+1 valori)
+		shared_ptr<const vector<uint32_t>> m_targets;		// Stato di destinazione di ciascuna transizione
+		shared_ptr<const vector<uint8_t>> m_final;			// Flag di stato finale
+		shared_ptr<const vector<string>> m_names;			// Nomi degli stati
+		vector<LabelId> m_labels;							// Label di ciascuna transizione
+		uint32_t m_initial_state;
+
+		template <class State> void build(Automaton<State>* automaton);
+
+	public:
+		FlatAutomaton(DFA* dfa);
+		FlatAutomaton(NFA* nfa);
+		FlatAutomaton(const FlatAutomaton& structure, const LabelIndex& label_index, vector<LabelId>&& labels);
+		virtual ~FlatAutomaton();
+
+		unsigned int size() const;
+		unsigned long int getTransitionsCount() const;
+		const LabelIndex& getLabelIndex() const;
+		uint32_t getInitialState() const;
+		bool isFinal(uint32_t state) const;
+		const string& getName(uint32_t state) const;
+		const uint32_t* getOffsets() const;
+		const uint32_t* getTargets() const;
+		const LabelId* getLabels() const;
+		NFA* toNFA() const;
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_FLATAUTOMATON_HPP_ */
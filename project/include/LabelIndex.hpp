@@ -0,0 +1,55 @@
+/*
+ * LabelIndex.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file LabelIndex.cpp.
+ * Associa a ciascuna label di un alfabeto un identificatore numerico denso (0, 1, 2, ...),
+ * in modo che le parole da riconoscere possano essere rappresentate come sequenze di interi
+ * e le transizioni possano essere memorizzate in tabelle indicizzate direttamente dalla label.
+ *
+ */
+
+#ifndef INCLUDE_LABELINDEX_HPP_
+#define INCLUDE_LABELINDEX_HPP_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Alphabet.hpp"
+
+namespace translated_automata {
+
+	using std::string;
+	using std::vector;
+	using std::unordered_map;
+
+	/**
+	 * Identificatore numerico di una label.
+	 */
+	using LabelId = uint32_t;
+
+	class LabelIndex {
+
+	private:
+		vector<string> m_labels;					// Identificatore => label
+		unordered_map<string, LabelId> m_ids;		// Label => identificatore
+
+	public:
+		LabelIndex(const Alphabet& alphabet);
+		virtual ~LabelIndex();
+
+		unsigned int size() const;
+		LabelId getUnknownId() const;
+		LabelId getEpsilonId() const;
+		LabelId getId(const string& label) const;
+		const string& getLabel(LabelId id) const;
+		vector<LabelId> encode(const vector<string>& word) const;
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_LABELINDEX_HPP_ */
@@ -0,0 +1,92 @@
+/*
+ * LazyDFA.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file LazyDFA.cpp.
+ * Implementa un DFA "lazy", ossia costruito al volo durante il riconoscimento di parole
+ * su un NFA: uno stato DFA (e la transizione che lo raggiunge) viene generato solamente
+ * quando una parola in input lo raggiunge, evitando di materializzare l'intero DFA prodotto
+ * dalla Subset Construction.
+ * Gli stati generati sono mantenuti in una cache con un limite di memoria (in byte, stimato in base
+ * alle estensioni e alle transizioni degli stati), gestita con una politica di rimpiazzamento "clock"
+ * (approssimazione di LRU). Se uno stato non può essere mantenuto in cache entro il limite, oppure
+ * se la memoria si esaurisce, il riconoscimento prosegue tramite simulazione diretta dell'NFA.
+ *
+ */
+
+#ifndef INCLUDE_LAZYDFA_HPP_
+#define INCLUDE_LAZYDFA_HPP_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Automaton.hpp"
+#include "State.hpp"
+
+#define DEFAULT_LAZY_DFA_BUDGET (16UL << 20)		// Memoria massima (in byte) occupata dagli stati DFA in cache
+
+namespace translated_automata {
+
+	using std::string;
+	using std::vector;
+	using std::unordered_map;
+
+	class LazyDFA {
+
+	private:
+		NFA* m_nfa;											// NFA di riferimento (non posseduto)
+		ExtensionDFA m_initial_extension;					// Epsilon-chiusura dello stato iniziale dell'NFA
+		unsigned long int m_budget;							// Memoria massima (in byte) occupata dalla cache
+		unsigned long int m_used_bytes;						// Memoria (stimata) occupata dagli stati in cache
+
+		// Cache degli stati con rimpiazzamento "clock"
+		vector<ConstructedStateDFA*> m_slots;				// Stati in cache (il bit di riferimento è il "mark" dello stato)
+		vector<unsigned long int> m_free_slots;				// Slot liberati dalle eviction, riutilizzati dai nuovi stati
+		unordered_map<const ExtensionDFA*, unsigned long int> m_index;	// Estensione (internata) dello stato => slot
+		unsigned long int m_clock_hand;						// Prossimo slot candidato all'eviction
+
+		// Stato corrente del riconoscimento
+		ConstructedStateDFA* m_current_state;				// Non viene mai rimosso dalla cache
+		bool m_simulation_active;							// TRUE se si sta simulando direttamente l'NFA
+		ExtensionDFA m_simulated_extension;					// Stati NFA correnti durante la simulazione
+
+		// Statistiche
+		unsigned long int m_hits;
+		unsigned long int m_misses;
+		unsigned long int m_evictions;
+		unsigned long int m_fallbacks;
+
+		static unsigned long int estimateStateBytes(const ExtensionDFA& extension);
+		static unsigned long int estimateTransitionsBytes(StateDFA* state);
+
+		ConstructedStateDFA* getOrCreateState(ExtensionDFA& extension);
+		bool makeRoom(unsigned long int bytes, ConstructedStateDFA* kept_state);
+		void evictSlot(unsigned long int slot);
+		void clearCache();
+		void startSimulation(const ExtensionDFA& extension);
+
+	public:
+		LazyDFA(NFA* nfa, unsigned long int budget = DEFAULT_LAZY_DFA_BUDGET);
+		virtual ~LazyDFA();
+
+		void reset();
+		void step(const string& label);
+		bool isAccepting();
+		bool accepts(const vector<string>& word);
+
+		unsigned long int getBudget();
+		unsigned long int getUsedBytes();
+		unsigned long int getCachedStatesCount();
+		bool isSimulationActive();
+		unsigned long int getHitsCount();
+		unsigned long int getMissesCount();
+		unsigned long int getEvictionsCount();
+		unsigned long int getFallbacksCount();
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_LAZYDFA_HPP_ */
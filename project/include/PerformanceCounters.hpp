@@ -0,0 +1,83 @@
+/*
+ * PerformanceCounters.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * File header per il sorgente "PerformanceCounters.cpp".
+ * Contiene la definizione della classe "PerformanceCounters", che permette di misurare
+ * alcuni contatori hardware (cicli, istruzioni, cache-miss, ...) durante l'esecuzione
+ * di un blocco di codice.
+ * La misurazione si basa sulla system call "perf_event_open", disponibile solo su Linux;
+ * sugli altri sistemi (o in caso di permessi insufficienti) i contatori risultano non disponibili
+ * e le misurazioni sono vuote.
+ *
+ */
+
+#ifndef INCLUDE_PERFORMANCECOUNTERS_HPP_
+#define INCLUDE_PERFORMANCECOUNTERS_HPP_
+
+#include <string>
+
+using std::string;
+
+namespace translated_automata {
+
+	/**
+	 * Contatori misurati all'interno di un gruppo.
+	 */
+	typedef enum {
+		HW_CYCLES,			// Cicli di CPU
+		HW_INSTRUCTIONS,	// Istruzioni eseguite
+		HW_CACHE_MISSES,	// Cache-miss (tipicamente sull'ultimo livello di cache)
+		HW_BRANCH_MISSES,	// Predizioni di salto errate
+		HW_PAGE_FAULTS		// Page-fault (contatore software del kernel)
+	} HardwareCounter;
+
+	#define HW_COUNTERS_COUNT (HW_PAGE_FAULTS + 1)
+
+	/**
+	 * Valori dei contatori misurati durante l'esecuzione di un blocco di codice.
+	 * Il flag "valid_mask" indica quali contatori sono stati effettivamente misurati:
+	 * il bit i-esimo è impostato se il contatore i-esimo è disponibile.
+	 */
+	struct CounterSample {
+		unsigned long long int values[HW_COUNTERS_COUNT] = {};
+		unsigned int valid_mask = 0;
+
+		bool isValid(HardwareCounter counter) const {
+			return (this->valid_mask >> counter) & 1;
+		}
+	};
+
+	/**
+	 * Classe che gestisce un gruppo di contatori hardware relativi al thread corrente.
+	 * I contatori vengono aperti alla costruzione (se abilitati) e misurati congiuntamente
+	 * fra una chiamata a "start" e la successiva chiamata a "stop".
+	 */
+	class PerformanceCounters {
+
+	private:
+		bool m_enabled;								// Flag che indica se le misurazioni sono abilitate
+		int m_group_fd = -1;						// Descrittore del contatore "leader" del gruppo
+		int m_fds[HW_COUNTERS_COUNT];				// Descrittori dei singoli contatori (-1 se non disponibili)
+		int m_group_index[HW_COUNTERS_COUNT];		// Posizione di ciascun contatore all'interno della lettura di gruppo
+		int m_opened_counters = 0;					// Numero di contatori aperti con successo
+
+		void openCounters();
+		void closeCounters();
+
+	public:
+		static string nameOf(HardwareCounter counter);
+
+		PerformanceCounters(bool enabled);
+		~PerformanceCounters();
+
+		bool isAvailable();
+		void start();
+		CounterSample stop();
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_PERFORMANCECOUNTERS_HPP_ */
@@ -38,7 +38,7 @@ namespace translated_automata {
 
 	public:
 		Problem(ProblemType type) : m_type(type) {};
-		~Problem() {};
+		virtual ~Problem() {};
 
 		ProblemType getType() { return this->m_type; };
 
@@ -9,7 +9,9 @@
 #define INCLUDE_PROBLEMSOLVER_HPP_
 
 #include "EmbeddedSubsetConstruction.hpp"
+#include "PerformanceCounters.hpp"
 #include "ProblemGenerator.hpp"
+#include "ResultCache.hpp"
 #include "ResultCollector.hpp"
 #include "SubsetConstruction.hpp"
 
@@ -21,6 +23,8 @@ namespace translated_automata {
 		ResultCollector* collector;			// Archivio dei risultati delle risoluzioni dei problemi
 		EmbeddedSubsetConstruction* esc; 	// Algoritmo Embedded Subset Construction
 		SubsetConstruction* sc;				// Algoritmo Subset Construction
+		PerformanceCounters* counters;		// Contatori hardware misurati durante le fasi degli algoritmi
+		ResultCache* cache;					// Cache delle soluzioni SC dei problemi di traduzione (NULL se disattivata)
 
 	public:
 		ProblemSolver(Configurations* configurations);
@@ -0,0 +1,118 @@
+/*
+ * Profiling.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Semplice libreria per la profilazione delle procedure interne dell'algoritmo
+ * "Embedded Subset Construction" (regole del Bud Processing, Extension Update,
+ * Distance Relocation, Automaton Pruning).
+ * Per ciascuna procedura vengono contati il numero di esecuzioni e il tempo
+ * complessivo impiegato.
+ *
+ * Per attivare la profilazione -> agire sulla macro PROFILING_MODE facendo in modo
+ * che sia definita (si veda sotto), oppure compilare con "make PROFILING=1".
+ * Con la profilazione disattivata, le macro si espandono a codice vuoto e non
+ * introducono alcun overhead; la struttura ESCProfile resta comunque definita
+ * (con valori nulli), in modo che le strutture che la contengono non cambino.
+ *
+ */
+
+#ifndef INCLUDE_PROFILING_HPP_
+#define INCLUDE_PROFILING_HPP_
+
+#include <chrono>
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Attiva o disattiva la profilazione, a seconda che sia
+	 * rispettivamente decommentato o commentato.
+	 */
+//	#define PROFILING_MODE
+
+	/**
+	 * Procedure profilate all'interno dell'algoritmo ESC.
+	 */
+	enum ProfiledProcedure {
+		PROF_RULE_0,
+		PROF_RULE_1,
+		PROF_RULE_2,
+		PROF_RULE_3,
+		PROF_RULE_4,
+		PROF_RULE_5,
+		PROF_RULE_6,
+		PROF_RULE_7,
+		PROF_AUTOMATON_PRUNING,
+		PROF_EXTENSION_UPDATE,
+		PROF_DISTANCE_RELOCATION
+	};
+
+	#define PROFILED_PROCEDURES_COUNT (PROF_DISTANCE_RELOCATION + 1)
+
+	/**
+	 * Profilo di un'esecuzione dell'algoritmo ESC.
+	 * I tempi sono "inclusivi": il tempo di una regola comprende anche quello delle
+	 * procedure richiamate al suo interno (ad esempio, Extension Update nella regola 4).
+	 */
+	struct ESCProfile {
+		unsigned long int calls[PROFILED_PROCEDURES_COUNT] = {};			// Numero di esecuzioni di ciascuna procedura
+		unsigned long int nanoseconds[PROFILED_PROCEDURES_COUNT] = {};		// Tempo complessivo di ciascuna procedura
+		unsigned long int relocation_visited_nodes = 0;						// Nodi visitati durante le Distance Relocation
+	};
+
+	/**
+	 * Timer che, alla distruzione, accumula nel profilo il tempo trascorso dalla sua
+	 * costruzione e incrementa il contatore della procedura associata.
+	 */
+	class ProfilingTimer {
+
+	private:
+		ESCProfile& m_profile;
+		ProfiledProcedure m_procedure;
+		std::chrono::steady_clock::time_point m_start;
+
+	public:
+		ProfilingTimer(ESCProfile& profile, ProfiledProcedure procedure)
+		: m_profile(profile), m_procedure(procedure), m_start(std::chrono::steady_clock::now()) {};
+
+		~ProfilingTimer() {
+			this->m_profile.calls[this->m_procedure]++;
+			this->m_profile.nanoseconds[this->m_procedure] +=
+					std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->m_start).count();
+		};
+
+	};
+
+	#ifdef PROFILING_MODE
+
+	#define IS_PROFILING_ACTIVE true
+
+	/**
+	 * Macro function.
+	 * Profila il blocco (scope) corrente, attribuendone tempo e numero di esecuzioni
+	 * alla procedura passata come parametro.
+	 */
+	#define PROFILE_SCOPE( profile, procedure )										\
+		ProfilingTimer CONCAT( profiling_timer_, __LINE__ )( profile, procedure )
+
+	/**
+	 * Macro function.
+	 * Incrementa di una certa quantità un contatore del profilo.
+	 */
+	#define PROFILE_COUNT( profile, counter, amount )								\
+		(profile).counter += (amount)
+
+	#else
+
+	#define IS_PROFILING_ACTIVE false
+
+	#define PROFILE_SCOPE( profile, procedure )
+	#define PROFILE_COUNT( profile, counter, amount )
+
+	#endif
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_PROFILING_HPP_ */
@@ -10,9 +10,19 @@
 
 // Risultati, cartelle e nomi dei files
 #define DIR_RESULTS 						"results/"
+#define DIR_RESULT_CACHE 					"results/cache/"
 #define FILE_NAME_ORIGINAL_AUTOMATON 		"original"
 #define FILE_NAME_SC_SOLUTION 				"sc_solution"
 #define FILE_NAME_ESC_SOLUTION 				"esc_solution"
+#define FILE_NAME_STATS 					"stats"
+#define FILE_NAME_STATS_DISTRIBUTION 		"stats_distribution"
+#define FILE_NAME_STATS_HISTOGRAMS 			"stats_histograms"
+#define FILE_NAME_STATS_COUNTERS 			"stats_counters"
+#define FILE_NAME_STATS_PROFILES 			"stats_profiles"
+#define FILE_NAME_TRACE 					"trace"
+#define FILE_EXTENSION_CSV 					".csv"
+#define FILE_EXTENSION_TRACE 				".bin"
+#define FILE_EXTENSION_CACHE 				".cache"
 #define FILE_EXTENSION_GRAPHVIZ 			".gv"
 #define FILE_EXTENSION_PDF 					".pdf"
 
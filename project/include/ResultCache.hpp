@@ -0,0 +1,105 @@
+/*
+ * ResultCache.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file ResultCache.cpp.
+ * Cache delle soluzioni (DFA determinizzati) dei problemi di traduzione, indirizzata per contenuto.
+ * Un problema viene identificato da un'impronta canonica della coppia (automa, traduzione): gli stati
+ * del DFA raggiungibili dallo stato iniziale vengono numerati con una visita BFS che segue le transizioni
+ * in ordine di label, e ad ogni transizione viene associata la label tradotta tramite la traduzione
+ * compilata. Due problemi con la stessa impronta producono NFA tradotti isomorfi, e quindi soluzioni
+ * che differiscono solamente per i nomi degli stati; i nomi vengono perciò ricostruiti ad ogni hit a
+ * partire dai nomi degli stati del problema corrente.
+ *
+ * La cache è limitata in memoria e gestita con politica LRU; le soluzioni rimosse possono essere
+ * opzionalmente salvate su disco e ricaricate alla richiesta successiva.
+ * Vengono memorizzate solamente le soluzioni e non le misure (tempo e contatori) della risoluzione originale,
+ * che non descrivono il lavoro svolto per un problema risolto tramite la cache.
+ *
+ */
+
+#ifndef INCLUDE_RESULTCACHE_HPP_
+#define INCLUDE_RESULTCACHE_HPP_
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Automaton.hpp"
+#include "Translation.hpp"
+
+namespace translated_automata {
+
+	using std::list;
+	using std::string;
+	using std::unordered_map;
+	using std::vector;
+
+	/**
+	 * Impronta canonica di un problema di traduzione.
+	 * Le label tradotte e la struttura costituiscono la chiave; i nomi degli stati, in ordine canonico,
+	 * servono solamente a convertire le soluzioni dal e al problema corrente.
+	 */
+	struct ResultFingerprint {
+		uint64_t hash = 0;
+		vector<string> labels;			// Label tradotte, nell'ordine in cui vengono incontrate dalla visita
+		vector<uint32_t> encoding;		// Per ogni stato: flag finale, numero di transizioni e coppie (label, destinazione)
+		vector<string> names;			// Nomi degli stati del problema, indicizzati per numero canonico
+	};
+
+	class ResultCache {
+
+	private:
+
+		/**
+		 * Singolo elemento della cache.
+		 * La soluzione è codificata rispetto alla numerazione canonica: per ogni stato (a partire dallo stato
+		 * iniziale) flag finale, dimensione ed elementi dell'estensione, numero di transizioni e coppie
+		 * (label, destinazione).
+		 */
+		struct Entry {
+			uint64_t hash;
+			vector<string> labels;
+			vector<uint32_t> encoding;
+			vector<uint32_t> solution;
+			unsigned long int bytes;
+		};
+
+		unsigned long int m_capacity;							// Memoria massima occupata dagli elementi (in byte)
+		unsigned long int m_used = 0;							// Memoria attualmente occupata dagli elementi (in byte)
+		bool m_spill;											// Salvataggio su disco degli elementi rimossi
+		string m_directory;										// Cartella dei file su disco
+		list<Entry> m_entries;									// Elementi, dal più recente al meno recente
+		unordered_map<uint64_t, list<Entry>::iterator> m_index;	// Hash => elemento
+		unsigned long int m_hits = 0;
+		unsigned long int m_misses = 0;
+
+		static bool matches(const Entry& entry, const ResultFingerprint& fingerprint);
+		static unsigned long int computeBytes(const Entry& entry);
+		string getFilePath(uint64_t hash);
+		void insert(Entry&& entry);
+		void evict();
+		void spill(const Entry& entry);
+		bool restore(const ResultFingerprint& fingerprint, Entry& entry);
+
+	public:
+		ResultCache(unsigned long int capacity, bool spill, string directory);
+		virtual ~ResultCache();
+
+		static ResultFingerprint computeFingerprint(DFA* dfa, Translation* translation);
+		DFA* lookup(const ResultFingerprint& fingerprint);
+		void store(const ResultFingerprint& fingerprint, DFA* solution);
+
+		unsigned long int size();
+		unsigned long int getUsedMemory();
+		unsigned long int getHitsCount();
+		unsigned long int getMissesCount();
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_RESULTCACHE_HPP_ */
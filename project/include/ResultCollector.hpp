@@ -4,19 +4,37 @@
  * Modulo che si occupa di archiviare i risultati di un problema.
  * Permette di effettuare semplici analisi statistiche su di essi, ottenendo
  * dati aggregati sulle performance del processo di risoluzione di un problema.
+ * Le statistiche vengono aggiornate "in streaming" all'aggiunta di ciascun risultato,
+ * pertanto non è necessario mantenere in memoria tutti i risultati.
  */
 
 #ifndef INCLUDE_RESULTCOLLECTOR_HPP_
 #define INCLUDE_RESULTCOLLECTOR_HPP_
 
+#include <fstream>
 #include <functional>
 #include <list>
 #include <tuple>
 
+#include "PerformanceCounters.hpp"
 #include "ProblemGenerator.hpp"
+#include "Profiling.hpp"
+#include "Statistics.hpp"
 
 namespace translated_automata {
 
+	/**
+	 * Fasi degli algoritmi per cui vengono misurati i contatori hardware.
+	 */
+	enum MeasuredPhase {
+		PHASE_SC_RUN,				// Subset Construction
+		PHASE_ESC_TRANSLATION,		// ESC - Automaton Translation (solo problemi di traduzione)
+		PHASE_ESC_CHECKUP,			// ESC - Automaton Checkup (solo problemi di determinizzazione)
+		PHASE_ESC_BUD_PROCESSING	// ESC - Bud Processing
+	};
+
+	#define MEASURED_PHASES_COUNT (PHASE_ESC_BUD_PROCESSING + 1)
+
 	/**
 	 * Struttura che rappresenta un singolo risultato ottenuto con la
 	 * risoluzione di un singolo problema.
@@ -27,6 +45,9 @@ namespace translated_automata {
 		DFA* esc_solution;
 		unsigned long int sc_elapsed_time;
 		unsigned long int esc_elapsed_time;
+		bool sc_cached;										// Soluzione SC recuperata dalla cache: tempo e contatori della fase SC non misurati
+		CounterSample hw_counters[MEASURED_PHASES_COUNT];	// Contatori hardware misurati in ciascuna fase (se abilitati)
+		ESCProfile esc_profile;								// Profilo delle procedure interne di ESC (se abilitato)
 	};
 
 	/**
@@ -43,16 +64,50 @@ namespace translated_automata {
 		EMPIRICAL_GAIN	// Guadagno empirico di ESC su SC, dato dalla frazione della differenza di tempo sul tempo massimo fra i due algoritmi
 	};
 
+	#define RESULT_STATS_COUNT (EMPIRICAL_GAIN + 1)
+
+	#define DEFAULT_HISTOGRAM_BINS 10
+
+	/**
+	 * Singolo intervallo di un istogramma, con il numero (stimato) di valori
+	 * compresi fra i due estremi.
+	 */
+	struct HistogramBin {
+		double lower_bound;
+		double upper_bound;
+		double count;
+	};
+
 	/**
 	 * Classe che raccoglie i risultati e permette l'analisi
 	 * di semplici statistiche.
+	 * Le statistiche di ciascun risultato vengono aggregate al momento dell'aggiunta;
+	 * il risultato (con il problema e gli automi delle soluzioni) viene mantenuto in memoria
+	 * solamente se le configurazioni richiedono di stamparlo o disegnarlo, altrimenti
+	 * viene distrutto immediatamente.
 	 */
 	class ResultCollector {
 
 	private:
-		list<Result*> m_results;
-		std::function<double(Result*)> getStatGetter(ResultStat stat);
+		list<Result*> m_results;							// Risultati mantenuti per la presentazione
+		vector<StatAccumulator> m_stats;					// Statistiche aggregate, indicizzate per ResultStat
+		vector<std::function<double(Result*)>> m_getters;	// Estrattori delle statistiche, indicizzati per ResultStat
+		vector<StatAccumulator> m_counter_stats;			// Statistiche dei contatori hardware, indicizzate per fase e contatore
+		vector<StatAccumulator> m_profile_calls_stats;		// Statistiche sul numero di esecuzioni delle procedure di ESC
+		vector<StatAccumulator> m_profile_time_stats;		// Statistiche sul tempo [us] delle procedure di ESC
+		StatAccumulator m_relocation_nodes_stats;			// Statistiche sui nodi visitati durante le Distance Relocation
+		std::ofstream m_profile_log;						// File di log dei profili dei singoli risultati
+		unsigned int m_test_case_number = 0;				// Numero di risultati aggregati
+		unsigned int m_sc_cached_number = 0;				// Numero di risultati con soluzione SC recuperata dalla cache
+		bool m_hardware_counters;							// Flag che indica se i contatori hardware sono misurati
+		bool m_retain_results;								// Flag che indica se i risultati devono essere mantenuti
 		Configurations* m_config_reference;
+		ConfigurationsSnapshot m_config;					// Valori delle configurazioni del caso di test corrente
+
+		std::function<double(Result*)> getStatGetter(ResultStat stat);
+		void releaseResult(Result* result);
+		std::ofstream openLogFile(string file_name, string headline);
+		void logProfile(Result* result);
 
 	public:
 		ResultCollector(Configurations* configurations);
@@ -60,11 +115,20 @@ namespace translated_automata {
 
 		// Gestione della lista di risultati
 		void addResult(Result* result);
+		void mergeWith(ResultCollector& other);
 		void reset();
 
 		// Statistiche
 		unsigned int getTestCaseNumber();
+		unsigned int getSCCachedNumber();
 		std::tuple<double, double, double> getStat(ResultStat stat);
+		double getStandardDeviation(ResultStat stat);
+		double getPercentile(ResultStat stat, double percentile);
+		vector<HistogramBin> getHistogram(ResultStat stat, unsigned int bins = DEFAULT_HISTOGRAM_BINS);
+		std::tuple<double, double, double> getHardwareCounterStat(MeasuredPhase phase, HardwareCounter counter);
+		std::tuple<double, double, double> getProfileCallsStat(ProfiledProcedure procedure);
+		std::tuple<double, double, double> getProfileTimeStat(ProfiledProcedure procedure);
+		std::tuple<double, double, double> getRelocationNodesStat();
 		double getSuccessPercentage();
 		void presentResult(Result* result);
 		void presentResults();
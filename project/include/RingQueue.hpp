@@ -0,0 +1,104 @@
+/*
+ * RingQueue.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Coda FIFO implementata tramite buffer circolare.
+ * A differenza di std::list (o std::queue), gli elementi non richiedono un'allocazione
+ * dinamica per ciascun inserimento: il buffer viene allocato una sola volta e raddoppiato
+ * solamente quando si riempie. Svuotando la coda lo spazio allocato viene mantenuto,
+ * in modo che la stessa coda possa essere riutilizzata da più esecuzioni successive
+ * di una procedura senza ulteriori allocazioni.
+ *
+ */
+
+#ifndef INCLUDE_RINGQUEUE_HPP_
+#define INCLUDE_RINGQUEUE_HPP_
+
+#include <vector>
+
+#define DEFAULT_RING_QUEUE_CAPACITY 64		// Capacità iniziale (potenza di 2)
+
+namespace translated_automata {
+
+	template <class T>
+	class RingQueue {
+
+	private:
+		std::vector<T> m_buffer;		// Dimensione sempre pari ad una potenza di 2
+		unsigned long int m_head;		// Indice (assoluto) del primo elemento
+		unsigned long int m_tail;		// Indice (assoluto) successivo all'ultimo elemento
+
+		/**
+		 * Raddoppia la capacità del buffer, riportando gli elementi in ordine all'inizio del nuovo buffer.
+		 */
+		void grow() {
+			std::vector<T> new_buffer(this->m_buffer.size() * 2);
+			unsigned long int count = this->size();
+			for (unsigned long int i = 0; i < count; i++) {
+				new_buffer[i] = this->m_buffer[(this->m_head + i) & (this->m_buffer.size() - 1)];
+			}
+			this->m_buffer.swap(new_buffer);
+			this->m_head = 0;
+			this->m_tail = count;
+		}
+
+	public:
+		/**
+		 * Costruttore.
+		 * La capacità iniziale viene arrotondata alla potenza di 2 successiva.
+		 */
+		RingQueue(unsigned long int capacity = DEFAULT_RING_QUEUE_CAPACITY) : m_head(0), m_tail(0) {
+			unsigned long int actual_capacity = 1;
+			while (actual_capacity < capacity) {
+				actual_capacity <<= 1;
+			}
+			this->m_buffer.resize(actual_capacity);
+		}
+
+		/**
+		 * Inserisce un elemento in fondo alla coda.
+		 */
+		void push(const T& element) {
+			if (this->size() == this->m_buffer.size()) {
+				this->grow();
+			}
+			this->m_buffer[this->m_tail & (this->m_buffer.size() - 1)] = element;
+			this->m_tail++;
+		}
+
+		/**
+		 * Estrae il primo elemento della coda.
+		 * Nota: la coda non deve essere vuota.
+		 */
+		T pop() {
+			T element = this->m_buffer[this->m_head & (this->m_buffer.size() - 1)];
+			this->m_head++;
+			return element;
+		}
+
+		/**
+		 * Svuota la coda, mantenendo lo spazio allocato.
+		 */
+		void clear() {
+			this->m_head = 0;
+			this->m_tail = 0;
+		}
+
+		bool empty() const {
+			return this->m_head == this->m_tail;
+		}
+
+		unsigned long int size() const {
+			return this->m_tail - this->m_head;
+		}
+
+		unsigned long int capacity() const {
+			return this->m_buffer.size();
+		}
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_RINGQUEUE_HPP_ */
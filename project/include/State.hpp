@@ -15,19 +15,25 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <memory>
 #include <set>
 #include <cstdbool>
 
+#include "TransitionMap.hpp"
+
 using std::string;
 using std::map;
 using std::set;
 
 #define DEFAULT_VOID_DISTANCE 1U<<30
+#define STATE_NO_ID (~0U)			// Identificatore di uno stato che non appartiene ad alcun automa
 
 #define EMPTY_EXTENSION_NAME "∅"
 
 namespace translated_automata {
 
+	template <class State> class Automaton;
+
 	/**
 	 * Abstract class "State".
 	 * Classe padre di StateNFA, StateDFA, ConstructedDFA.
@@ -37,26 +43,40 @@ namespace translated_automata {
 	 * è marcata da una label.
 	 * La classe "State" prevede, quando estesa, l'implementazione dei metodi virtuali
 	 * "isFinal" e "duplicate".
+	 * Le transizioni sono memorizzate in contenitori piatti (TransitionMap), con spazio interno per
+	 * le prime label e i primi stati: gli iteratori ottenuti dai metodi "...Ref" non restano validi
+	 * se le transizioni dello stato vengono modificate durante l'iterazione.
+	 * Le transizioni entranti sono un indice (inverso) di quelle uscenti: uno stato appartenente ad un automa
+	 * costruito "in avanti" non le mantiene, finché l'automa non ricostruisce l'indice (si veda Automaton).
 	 */
 	template <class S>
 	class State {
 
     private:
-        map<string, set<S*>> m_exiting_transitions;		// Transizioni uscenti dallo stato
-        map<string, set<S*>> m_incoming_transitions;	// Transizioni entranti nello stato
+        TransitionMap<S> m_exiting_transitions;			// Transizioni uscenti dallo stato
+        TransitionMap<S> m_incoming_transitions;		// Transizioni entranti nello stato
+        unsigned int m_id = STATE_NO_ID;				// Identificatore assegnato dall'automa che contiene lo stato
+        bool m_incoming_indexed = true;					// Flag che indica se le transizioni entranti sono mantenute
 
         S* getThis() const;
 
+        template <class State> friend class Automaton;
+
 	protected:
-		string m_name = "";									// Nome dello stato
+		mutable string m_name = "";							// Nome dello stato
+		mutable bool m_name_pending = false;				// Flag che indica se il nome deve essere ancora calcolato
 		bool m_final = false;								// Flag che indica se lo stato è finale o meno
 		unsigned int m_distance = DEFAULT_VOID_DISTANCE;	// Distanza del nodo dal nodo iniziale
 
+		virtual string computeName() const;
+
     public:
 		State();											// Costruttore
         virtual ~State();									// Distruttore (virtuale)
 
         string getName() const;
+        unsigned int getId() const;
+        bool hasIncomingIndex() const;
         bool isFinal();
         void setFinal(bool final);
 		void connectChild(string label, S* child);
@@ -71,8 +91,8 @@ namespace translated_automata {
 		bool hasIncomingTransition(string label, S* child);
 		map<string, set<S*>> getExitingTransitions();
 		map<string, set<S*>> getIncomingTransitions();
-		const map<string, set<S*>>& getExitingTransitionsRef();
-		const map<string, set<S*>>& getIncomingTransitionsRef();
+		const TransitionMap<S>& getExitingTransitionsRef();
+		const TransitionMap<S>& getIncomingTransitionsRef();
 		int getExitingTransitionsCount();
 		int getIncomingTransitionsCount();
 		void copyExitingTransitionsOf(S* other_state);
@@ -112,10 +132,15 @@ namespace translated_automata {
 	 */
     class StateNFA : public State<StateNFA> {
 
+    private:
+        unsigned long int m_serial;		// Numero progressivo univoco dello stato, mai riutilizzato (a differenza dell'indirizzo)
+
     public:
         StateNFA(string name, bool final = false);
 		~StateNFA();
 
+		unsigned long int getSerial() const;
+
     };
 
 	/**
@@ -136,7 +161,7 @@ namespace translated_automata {
 		StateDFA(string name, bool final = false);
 		~StateDFA();
 
-		StateDFA* getChild(string label);
+		StateDFA* getChild(const string& label);
 
     };
 
@@ -147,6 +172,11 @@ namespace translated_automata {
 	 */
 	using ExtensionDFA = set<StateNFA*, StateNFA::Comparator>;
 
+	/**
+	 * Riferimento (con conteggio) ad un'estensione immutabile, condivisa tramite ExtensionPool.
+	 */
+	using ExtensionHandle = std::shared_ptr<const ExtensionDFA>;
+
 	/**
 	 * Classe concreta "ConstructedStateDFA".
 	 * Rappresenta uno stato di un automa DFA che è stato costruito sulla base di un automa NFA,
@@ -157,13 +187,23 @@ namespace translated_automata {
 	 * Inoltre, contiene la definizione dell'estensione di uno stato DFA (denominata "ExtensionDFA"),
 	 * ossia dell'insieme di stati NFA originali. Tale estensione è implementata come std::set di StateNFA
 	 * ordinati mediante un Comparator operante sui nomi degli stati.
+	 * Lo stato non possiede una propria copia dell'estensione, ma un riferimento all'estensione internata
+	 * nell'ExtensionPool: stati con la stessa estensione condividono lo stesso insieme.
+	 * Il nome dello stato ("{s0,s1,...}") è calcolato solamente quando viene richiesto, ad esempio per la
+	 * stampa: il confronto fra estensioni avviene tramite i riferimenti dell'ExtensionPool, mentre l'ordinamento
+	 * dei bud utilizza il numero progressivo dello stato.
 	 */
 	class ConstructedStateDFA : public StateDFA {
 
 	private:
-		ExtensionDFA m_extension;			// Stati dell'NFA corrispondente
+		ExtensionHandle m_extension;		// Stati dell'NFA corrispondente (estensione condivisa)
+		unsigned long int m_extension_version = 0;	// Numero di modifiche subite dall'estensione
+		unsigned long int m_serial;			// Numero progressivo univoco dello stato, che non varia con l'estensione
 		bool m_mark = false;
 
+	protected:
+		string computeName() const override;
+
 	public:
 		static string createNameFromExtension(const ExtensionDFA &ext);
 		static ExtensionDFA subtractExtensions(const ExtensionDFA &ext1, const ExtensionDFA &ext2);
@@ -171,16 +211,22 @@ namespace translated_automata {
 		static bool hasFinalStates(const ExtensionDFA &ext);
 
 		ConstructedStateDFA(ExtensionDFA &extension);
+		ConstructedStateDFA(const ExtensionHandle &extension);
 		virtual ~ConstructedStateDFA();
 
+		unsigned long int getSerial() const;
 		void setMarked(bool mark);
 		bool isMarked();
 		bool hasExtension(const ExtensionDFA &ext);
+		bool hasExtension(const ExtensionHandle &ext);
 		const ExtensionDFA& getExtension();
+		ExtensionHandle getExtensionHandle();
+		unsigned long int getExtensionVersion();
 		set<string>& getLabelsExitingFromExtension();
 		ExtensionDFA computeLClosureOfExtension(string l);
 		void replaceExtensionWith(ExtensionDFA &new_ext);
 		bool isExtensionEmpty();
+		void resolveName();
 
 	};
 
@@ -0,0 +1,101 @@
+/*
+ * Statistics.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Strumenti per l'analisi statistica "in streaming" di una sequenza di valori.
+ * Ogni valore viene processato una sola volta nel momento in cui viene aggiunto,
+ * senza che sia necessario mantenere in memoria l'intera sequenza.
+ * Le strutture offerte sono "mergeable": due accumulatori costruiti su insiemi
+ * di valori differenti possono essere combinati, ottenendo lo stesso risultato
+ * che si sarebbe ottenuto accumulando tutti i valori in un unico oggetto.
+ *
+ */
+
+#ifndef INCLUDE_STATISTICS_HPP_
+#define INCLUDE_STATISTICS_HPP_
+
+#include <vector>
+
+#define DEFAULT_TDIGEST_COMPRESSION 200
+
+namespace translated_automata {
+
+	using std::vector;
+
+	/**
+	 * Sketch "t-digest" per la stima dei quantili di una distribuzione.
+	 * I valori vengono raggruppati in centroidi (media, peso) la cui dimensione massima
+	 * dipende dalla posizione all'interno della distribuzione: i centroidi sulle code
+	 * sono piccoli (o singoletti), garantendo un'elevata precisione sui percentili estremi.
+	 * La memoria occupata è limitata e proporzionale al parametro di compressione.
+	 */
+	class TDigest {
+
+	private:
+		struct Centroid {
+			double mean;
+			double weight;
+		};
+
+		double m_compression;
+		vector<Centroid> m_centroids;		// Centroidi già compressi, ordinati per media
+		vector<Centroid> m_buffer;			// Valori aggiunti e non ancora compressi
+		double m_total_weight = 0;
+		double m_min = 0;
+		double m_max = 0;
+
+		void compress();
+		double computeScaleLimit(double q);
+
+	public:
+		TDigest(double compression = DEFAULT_TDIGEST_COMPRESSION);
+		~TDigest();
+
+		void add(double value, double weight = 1);
+		void merge(const TDigest& other);
+		void reset();
+
+		double getCount() const;
+		double getQuantile(double q);
+		double getCumulativeDistribution(double x);
+
+	};
+
+	/**
+	 * Accumulatore di statistiche su una sequenza di valori reali.
+	 * Mantiene minimo, massimo, media e varianza (secondo l'algoritmo di Welford)
+	 * e uno sketch t-digest per la stima dei quantili.
+	 */
+	class StatAccumulator {
+
+	private:
+		unsigned long int m_count = 0;
+		double m_mean = 0;
+		double m_m2 = 0;				// Somma dei quadrati degli scarti dalla media
+		double m_min = 0;
+		double m_max = 0;
+		TDigest m_digest;
+
+	public:
+		StatAccumulator();
+		~StatAccumulator();
+
+		void add(double value);
+		void merge(const StatAccumulator& other);
+		void reset();
+
+		unsigned long int getCount() const;
+		double getMin() const;
+		double getMax() const;
+		double getMean() const;
+		double getVariance() const;
+		double getStandardDeviation() const;
+		double getQuantile(double q);
+		double getCumulativeDistribution(double x);
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_STATISTICS_HPP_ */
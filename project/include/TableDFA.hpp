@@ -0,0 +1,95 @@
+/*
+ * TableDFA.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Header del file TableDFA.cpp.
+ * Rappresentazione immutabile di un DFA specializzata per stati deterministici: poiché ogni stato
+ * ha al più un figlio per label, le transizioni sono memorizzate direttamente come "stato successivo",
+ * senza gli insiemi di figli utilizzati dalla classe State.
+ *
+ * Sono disponibili due disposizioni della memoria:
+ * - DENSE: tabella per righe, next[stato * |Σ| + label], con TABLE_DFA_NO_STATE per le transizioni
+ *   non definite. La ricerca del figlio richiede una sola lettura.
+ * - SPARSE: righe compresse, in cui le transizioni di ciascuno stato sono memorizzate in modo contiguo
+ *   come coppie (label, stato) ordinate per label. La ricerca del figlio è una ricerca binaria sulla riga.
+ * La disposizione DENSE è preferibile quando la tabella è sufficientemente piena; per alfabeti ampi
+ * e automi sparsi la disposizione SPARSE occupa memoria proporzionale al numero di transizioni.
+ *
+ * Su questa rappresentazione sono implementate la minimizzazione (raffinamento delle partizioni di
+ * Moore) e la verifica di equivalenza fra due DFA (algoritmo di Hopcroft-Karp con union-find).
+ *
+ */
+
+#ifndef INCLUDE_TABLEDFA_HPP_
+#define INCLUDE_TABLEDFA_HPP_
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Automaton.hpp"
+#include "LabelIndex.hpp"
+
+#define TABLE_DFA_NO_STATE UINT32_MAX		// Destinazione delle transizioni non definite
+#define TABLE_DFA_DENSE_MIN_FILL 0.25		// Riempimento minimo della tabella per la scelta automatica della disposizione DENSE
+
+namespace translated_automata {
+
+	using std::string;
+	using std::vector;
+
+	/**
+	 * Disposizione in memoria delle transizioni.
+	 */
+	enum TableDFALayout {
+		TABLE_DFA_AUTO,			// Scelta in base al riempimento della tabella
+		TABLE_DFA_DENSE,		// Tabella per righe
+		TABLE_DFA_SPARSE,		// Righe compresse, coppie (label, stato) ordinate per label
+	};
+
+	class TableDFA {
+
+	private:
+		LabelIndex m_label_index;
+		TableDFALayout m_layout;
+		uint32_t m_states_count;
+		unsigned long int m_transitions_count;
+		unsigned int m_columns;					// Numero di label dell'alfabeto
+		vector<uint32_t> m_next;				// [DENSE] Stato successivo per ogni coppia (stato, label)
+		vector<uint32_t> m_row_offsets;			// [SPARSE] Indice della prima transizione di ciascuno stato (n+1 valori)
+		vector<LabelId> m_row_labels;			// [SPARSE] Label di ciascuna transizione, ordinate all'interno della riga
+		vector<uint32_t> m_row_targets;			// [SPARSE] Stato di destinazione di ciascuna transizione
+		vector<uint8_t> m_final;
+		vector<string> m_names;
+		uint32_t m_initial_state;
+
+		TableDFA(const LabelIndex& label_index);
+		void build(vector<uint32_t>&& offsets, vector<LabelId>&& labels, vector<uint32_t>&& targets, TableDFALayout layout);
+
+	public:
+		TableDFA(DFA* dfa, TableDFALayout layout = TABLE_DFA_AUTO);
+		virtual ~TableDFA();
+
+		static TableDFALayout chooseLayout(unsigned long int states_count, unsigned long int transitions_count, unsigned int labels_count);
+
+		unsigned int size() const;
+		unsigned long int getTransitionsCount() const;
+		TableDFALayout getLayout() const;
+		const LabelIndex& getLabelIndex() const;
+		uint32_t getInitialState() const;
+		bool isFinal(uint32_t state) const;
+		const string& getName(uint32_t state) const;
+		uint32_t getChild(uint32_t state, LabelId label) const;
+		vector<std::pair<LabelId, uint32_t>> getTransitions(uint32_t state) const;
+
+		TableDFA minimize() const;
+		static bool equivalent(const TableDFA& first, const TableDFA& second);
+		DFA* toDFA() const;
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_TABLEDFA_HPP_ */
@@ -0,0 +1,160 @@
+/*
+ * Trace.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Libreria di tracciamento strutturato degli eventi degli algoritmi.
+ * A differenza delle macro di Debug.hpp, gli eventi non vengono formattati come stringhe
+ * durante l'esecuzione: ciascun evento è un record binario di dimensione fissa, scritto in
+ * un buffer circolare privato del thread corrente (quindi senza lock). Il buffer mantiene
+ * gli ultimi TRACE_BUFFER_CAPACITY eventi e può essere salvato su file per essere decodificato
+ * offline (si veda il tool "tools/TraceDecoder.cpp", compilabile con "make trace_decoder").
+ *
+ * Il livello di tracciamento è stabilito a compile-time tramite la macro TRACE_LEVEL
+ * (si veda sotto, oppure compilare con "make TRACE=<livello>"); gli eventi con livello
+ * superiore vengono eliminati dal compilatore e non introducono alcun overhead.
+ *
+ */
+
+#ifndef INCLUDE_TRACE_HPP_
+#define INCLUDE_TRACE_HPP_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/** Livelli di tracciamento */
+#define TRACE_LEVEL_NONE		0
+#define TRACE_LEVEL_INFO		1		// Eventi principali (bud estratti, regole applicate, stati creati)
+#define TRACE_LEVEL_DEBUG		2		// Eventi secondari (aggiornamenti di estensione, rimozione di stati)
+#define TRACE_LEVEL_VERBOSE		3		// Eventi molto frequenti (aggiunta di bud, rilocazione delle distanze)
+
+/**
+ * Livello di tracciamento attivo.
+ * Gli eventi con livello superiore non vengono compilati.
+ */
+#ifndef TRACE_LEVEL
+#define TRACE_LEVEL TRACE_LEVEL_NONE
+#endif
+
+/** Numero di eventi mantenuti nel buffer circolare di ciascun thread (potenza di 2) */
+#define TRACE_BUFFER_CAPACITY	(1U << 20)
+
+/** Indice riservato alla label vuota (EPSILON), utilizzato anche per gli eventi che non coinvolgono una label */
+#define TRACE_NO_LABEL			0
+
+/** Intestazione dei file di traccia */
+#define TRACE_FILE_MAGIC		"ESCTRACE"
+#define TRACE_FILE_VERSION		2
+
+namespace translated_automata {
+
+	/**
+	 * Tipologie di eventi tracciati.
+	 */
+	enum TraceEventType : uint8_t {
+		TRACE_BUD_POPPED,			// Estrazione di un bud dalla lista (value = distanza dello stato)
+		TRACE_BUD_ADDED,			// Aggiunta di un bud alla lista
+		TRACE_RULE_FIRED,			// Applicazione di una regola del Bud Processing (value = numero della regola)
+		TRACE_STATE_CREATED,		// Creazione di un nuovo stato DFA (value = distanza dello stato)
+		TRACE_STATE_REMOVED,		// Rimozione di uno stato DFA
+		TRACE_EXTENSION_UPDATED,	// Aggiornamento dell'estensione di uno stato (value = dimensione della nuova estensione)
+		TRACE_DISTANCE_RELOCATED	// Modifica della distanza di uno stato (value = nuova distanza)
+	};
+
+	#define TRACE_EVENT_TYPES_COUNT (TRACE_DISTANCE_RELOCATED + 1)
+
+	/**
+	 * Indice di una label all'interno della tabella delle label del buffer.
+	 */
+	typedef uint32_t TraceLabel;
+
+	/**
+	 * Record binario di un singolo evento.
+	 * Lo stato è identificato dal suo identificatore all'interno dell'automa al momento dell'evento
+	 * (si veda State::getId), così che la traccia sia riproducibile fra esecuzioni diverse; la label
+	 * da un indice all'interno della tabella delle label del buffer.
+	 */
+	struct TraceEvent {
+		uint64_t timestamp;			// Nanosecondi trascorsi dalla creazione del buffer
+		int64_t value;				// Valore associato all'evento (dipende dalla tipologia)
+		uint32_t state;				// Identificatore dello stato coinvolto
+		uint32_t label;				// Indice della label coinvolta
+		uint8_t type;				// Tipologia dell'evento (TraceEventType)
+		uint8_t level;				// Livello dell'evento
+		uint16_t padding;
+	};
+
+	/**
+	 * Buffer circolare di eventi, privato per ciascun thread.
+	 * Le label vengono "internate" in una tabella, in modo che ciascun evento ne contenga
+	 * solamente l'indice: l'indice viene calcolato dal chiamante (si veda la macro TRACE_LABEL)
+	 * una sola volta per tutti gli eventi che coinvolgono la stessa label, così che la registrazione
+	 * di un evento non richieda alcuna operazione sulle stringhe.
+	 */
+	class TraceBuffer {
+
+	private:
+		vector<TraceEvent> m_events;					// Eventi (allocati alla prima registrazione)
+		uint64_t m_recorded = 0;						// Numero totale di eventi registrati
+		std::unordered_map<string, uint32_t> m_label_ids;
+		vector<string> m_labels;						// Tabella delle label, indicizzata per ID
+		std::chrono::steady_clock::time_point m_start;
+
+	public:
+		static string nameOf(TraceEventType type);
+		static TraceBuffer& local();
+
+		TraceBuffer();
+		~TraceBuffer();
+
+		TraceLabel internLabel(const string& label);
+		void record(TraceEventType type, uint8_t level, uint32_t state_id, TraceLabel label, int64_t value);
+		bool dump(string file_name);
+		void clear();
+
+		uint64_t getRecordedCount();
+
+	};
+
+	/**
+	 * Macro function.
+	 * Restituisce l'indice della label nella tabella del buffer del thread corrente, se il tracciamento
+	 * è attivo; altrimenti restituisce TRACE_NO_LABEL senza valutare l'argomento.
+	 */
+	#define TRACE_LABEL( label )																		\
+		((TRACE_LEVEL > TRACE_LEVEL_NONE) ? TraceBuffer::local().internLabel(label) : TRACE_NO_LABEL)
+
+	/**
+	 * Macro function.
+	 * Registra un evento nel buffer del thread corrente, se il suo livello è abilitato.
+	 * Lo stato è registrato tramite il suo identificatore, la label tramite il suo indice (si veda TRACE_LABEL).
+	 * Se il livello non è abilitato, l'intera istruzione viene eliminata a compile-time
+	 * (e gli argomenti non vengono valutati).
+	 */
+	#define TRACE_EVENT( level, type, state, label, value )												\
+		do {																							\
+			if constexpr ((level) <= TRACE_LEVEL) {														\
+				TraceBuffer::local().record((type), (level), (state)->getId(), (label), (value));		\
+			}																							\
+		} while (0)
+
+	/**
+	 * Macro function.
+	 * Salva su file il buffer di eventi del thread corrente, se il tracciamento è attivo.
+	 */
+	#define TRACE_DUMP( file_name )																		\
+		do {																							\
+			if constexpr (TRACE_LEVEL > TRACE_LEVEL_NONE) {												\
+				TraceBuffer::local().dump(file_name);													\
+			}																							\
+		} while (0)
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_TRACE_HPP_ */
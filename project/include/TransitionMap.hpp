@@ -0,0 +1,302 @@
+/*
+ * TransitionMap.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Contenitori "piatti" per le transizioni di uno stato.
+ * Nella maggior parte degli stati escono (ed entrano) poche label, ciascuna con pochi stati: una mappa
+ * di insiemi (albero di alberi) richiede un'allocazione per ogni label e per ogni stato, con nodi sparsi
+ * in memoria. Questi contenitori memorizzano invece gli elementi in vettori ordinati, con spazio interno
+ * per i primi elementi: finché lo stato ha poche transizioni non viene effettuata alcuna allocazione.
+ *
+ * - SmallVector: vettore con i primi N elementi memorizzati internamente all'oggetto.
+ * - TargetSet: insieme ordinato di stati (per puntatore, come std::set<S*>).
+ * - TransitionMap: mappa ordinata label => TargetSet, con la stessa interfaccia (e lo stesso ordine di
+ *   iterazione) della mappa std::map<string, std::set<S*>> che sostituisce.
+ *
+ * Nota: a differenza dei contenitori della STL basati su alberi, un inserimento o una rimozione invalidano
+ * gli iteratori (e i riferimenti) agli elementi del contenitore modificato.
+ *
+ */
+
+#ifndef INCLUDE_TRANSITIONMAP_HPP_
+#define INCLUDE_TRANSITIONMAP_HPP_
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#define TARGET_SET_INLINE_SIZE 2			// Stati memorizzati internamente a ciascun TargetSet
+#define TRANSITION_MAP_INLINE_SIZE 2		// Label memorizzate internamente a ciascuna TransitionMap
+
+namespace translated_automata {
+
+	/**
+	 * Vettore con spazio interno per i primi N elementi.
+	 * Quando gli elementi superano la capacità interna, vengono spostati tutti in un vettore allocato
+	 * dinamicamente, che viene mantenuto fino allo svuotamento completo del contenitore.
+	 */
+	template <class T, unsigned int N>
+	class SmallVector {
+
+	private:
+		T m_inline[N];				// Elementi interni
+		std::vector<T> m_heap;		// Elementi allocati dinamicamente (se non vuoto, contiene tutti gli elementi)
+		unsigned int m_size = 0;	// Numero di elementi interni
+
+		bool isInline() const {
+			return this->m_heap.empty();
+		}
+
+	public:
+		using iterator = T*;
+		using const_iterator = const T*;
+
+		T* data() {
+			return (this->isInline()) ? this->m_inline : this->m_heap.data();
+		}
+
+		const T* data() const {
+			return (this->isInline()) ? this->m_inline : this->m_heap.data();
+		}
+
+		unsigned long int size() const {
+			return (this->isInline()) ? this->m_size : this->m_heap.size();
+		}
+
+		bool empty() const {
+			return this->size() == 0;
+		}
+
+		T* begin() {
+			return this->data();
+		}
+
+		T* end() {
+			return this->data() + this->size();
+		}
+
+		const T* begin() const {
+			return this->data();
+		}
+
+		const T* end() const {
+			return this->data() + this->size();
+		}
+
+		/**
+		 * Inserisce un elemento nella posizione specificata, restituendone la nuova posizione.
+		 */
+		T* insert(const T* position, T&& element) {
+			unsigned long int index = position - this->data();
+			if (!this->isInline()) {
+				return &*(this->m_heap.insert(this->m_heap.begin() + index, std::move(element)));
+			}
+			if (this->m_size < N) {
+				for (unsigned long int i = this->m_size; i > index; i--) {
+					this->m_inline[i] = std::move(this->m_inline[i - 1]);
+				}
+				this->m_inline[index] = std::move(element);
+				this->m_size++;
+				return this->m_inline + index;
+			}
+			// Spazio interno esaurito: tutti gli elementi vengono spostati nel vettore dinamico
+			this->m_heap.reserve(2 * N);
+			for (unsigned int i = 0; i < N; i++) {
+				this->m_heap.push_back(std::move(this->m_inline[i]));
+				this->m_inline[i] = T();
+			}
+			this->m_size = 0;
+			return &*(this->m_heap.insert(this->m_heap.begin() + index, std::move(element)));
+		}
+
+		/**
+		 * Rimuove l'elemento nella posizione specificata.
+		 */
+		void erase(const T* position) {
+			unsigned long int index = position - this->data();
+			if (!this->isInline()) {
+				this->m_heap.erase(this->m_heap.begin() + index);
+				return;
+			}
+			for (unsigned long int i = index; i + 1 < this->m_size; i++) {
+				this->m_inline[i] = std::move(this->m_inline[i + 1]);
+			}
+			this->m_size--;
+			this->m_inline[this->m_size] = T();
+		}
+
+		void clear() {
+			for (unsigned int i = 0; i < this->m_size; i++) {
+				this->m_inline[i] = T();
+			}
+			this->m_size = 0;
+			std::vector<T>().swap(this->m_heap);
+		}
+
+	};
+
+	/**
+	 * Insieme di stati, ordinati per puntatore.
+	 */
+	template <class S>
+	class TargetSet {
+
+	private:
+		SmallVector<S*, TARGET_SET_INLINE_SIZE> m_states;
+
+	public:
+		using iterator = S* const*;
+		using const_iterator = S* const*;
+
+		S* const* begin() const {
+			return this->m_states.begin();
+		}
+
+		S* const* end() const {
+			return this->m_states.end();
+		}
+
+		unsigned long int size() const {
+			return this->m_states.size();
+		}
+
+		bool empty() const {
+			return this->m_states.empty();
+		}
+
+		/**
+		 * Restituisce la posizione dello stato, oppure "end()" se lo stato non è presente.
+		 */
+		S* const* find(S* state) const {
+			S* const* position = std::lower_bound(this->begin(), this->end(), state, std::less<S*>());
+			return (position != this->end() && *position == state) ? position : this->end();
+		}
+
+		unsigned long int count(S* state) const {
+			return (this->find(state) != this->end()) ? 1 : 0;
+		}
+
+		/**
+		 * Inserisce lo stato, se non già presente. Restituisce TRUE se l'inserimento è avvenuto.
+		 */
+		bool insert(S* state) {
+			S* const* position = std::lower_bound(this->begin(), this->end(), state, std::less<S*>());
+			if (position != this->end() && *position == state) {
+				return false;
+			}
+			this->m_states.insert(position, std::move(state));
+			return true;
+		}
+
+		void erase(S* const* position) {
+			this->m_states.erase(position);
+		}
+
+		/**
+		 * Rimuove lo stato, se presente. Restituisce il numero di stati rimossi.
+		 */
+		unsigned long int erase(S* state) {
+			S* const* position = this->find(state);
+			if (position == this->end()) {
+				return 0;
+			}
+			this->m_states.erase(position);
+			return 1;
+		}
+
+	};
+
+	/**
+	 * Mappa label => insieme di stati, ordinata per label.
+	 * Come per std::map, l'operatore [] inserisce un insieme vuoto se la label non è presente.
+	 */
+	template <class S>
+	class TransitionMap {
+
+	public:
+		using value_type = std::pair<std::string, TargetSet<S>>;
+		using iterator = value_type*;
+		using const_iterator = const value_type*;
+
+	private:
+		SmallVector<value_type, TRANSITION_MAP_INLINE_SIZE> m_entries;
+
+		/**
+		 * Restituisce la posizione della label, oppure la posizione in cui dovrebbe essere inserita.
+		 */
+		const value_type* lowerBound(const std::string& label) const {
+			return std::lower_bound(this->m_entries.begin(), this->m_entries.end(), label,
+					[](const value_type& entry, const std::string& key) { return entry.first < key; });
+		}
+
+	public:
+		iterator begin() {
+			return this->m_entries.begin();
+		}
+
+		iterator end() {
+			return this->m_entries.end();
+		}
+
+		const_iterator begin() const {
+			return this->m_entries.begin();
+		}
+
+		const_iterator end() const {
+			return this->m_entries.end();
+		}
+
+		unsigned long int size() const {
+			return this->m_entries.size();
+		}
+
+		bool empty() const {
+			return this->m_entries.empty();
+		}
+
+		iterator find(const std::string& label) {
+			const value_type* position = this->lowerBound(label);
+			return (position != this->end() && position->first == label) ? this->begin() + (position - this->begin()) : this->end();
+		}
+
+		const_iterator find(const std::string& label) const {
+			const value_type* position = this->lowerBound(label);
+			return (position != this->end() && position->first == label) ? position : this->end();
+		}
+
+		unsigned long int count(const std::string& label) const {
+			return (this->find(label) != this->end()) ? 1 : 0;
+		}
+
+		/**
+		 * Restituisce l'insieme associato alla label.
+		 * Nota: la label deve essere presente.
+		 */
+		const TargetSet<S>& at(const std::string& label) const {
+			const_iterator position = this->find(label);
+			if (position == this->end()) {
+				throw "Label non presente nella mappa delle transizioni";
+			}
+			return position->second;
+		}
+
+		TargetSet<S>& operator[](const std::string& label) {
+			const value_type* position = this->lowerBound(label);
+			if (position != this->end() && position->first == label) {
+				return this->begin()[position - this->begin()].second;
+			}
+			return this->m_entries.insert(position, value_type(label, TargetSet<S>()))->second;
+		}
+
+		void clear() {
+			this->m_entries.clear();
+		}
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_TRANSITIONMAP_HPP_ */
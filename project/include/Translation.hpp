@@ -42,10 +42,14 @@ namespace translated_automata {
 		Translation(map<string, string> translation_map);
 		virtual ~Translation();
 
-		string translate(string label);
+		string translate(const string& label);
 		Alphabet translate(Alphabet alpha);
 		NFA* translate(DFA* automaton);
 
+		Translation* compose(Translation* first);
+		Alphabet preimage(const string& label, const Alphabet& alpha);
+		Translation* inverse(const Alphabet& alpha);
+
 		string toString();
 		string toString(Alphabet &reference);
 
@@ -0,0 +1,58 @@
+/*
+ * WorkerPool.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * File header per il sorgente "WorkerPool.cpp".
+ * Contiene la definizione della classe "WorkerPool", un insieme di thread creati una
+ * sola volta e riutilizzati per eseguire in parallelo più gruppi di compiti successivi,
+ * evitando di creare e terminare dei thread per ciascun gruppo.
+ *
+ */
+
+#ifndef INCLUDE_WORKERPOOL_HPP_
+#define INCLUDE_WORKERPOOL_HPP_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::vector;
+
+namespace translated_automata {
+
+	/**
+	 * Classe che gestisce un insieme fisso di thread "worker".
+	 * Il metodo "run" distribuisce un gruppo di compiti, identificati dagli indici 0, 1, ..., N-1,
+	 * fra i worker e il thread chiamante, e termina solo quando tutti i compiti sono stati eseguiti.
+	 * I worker restano in attesa fra un gruppo e il successivo, e vengono terminati dal distruttore.
+	 */
+	class WorkerPool {
+
+	private:
+		vector<std::thread> m_workers;
+		std::mutex m_mutex;
+		std::condition_variable m_tasks_available;		// Segnalata all'arrivo di un nuovo gruppo o alla terminazione
+		std::condition_variable m_tasks_completed;		// Segnalata al completamento dell'ultimo compito del gruppo
+		std::function<void(unsigned long int)> m_task;	// Compito del gruppo corrente, invocato con l'indice
+		unsigned long int m_tasks_count = 0;			// Numero di compiti del gruppo corrente
+		unsigned long int m_next_task = 0;				// Indice del prossimo compito da assegnare
+		unsigned long int m_pending_tasks = 0;			// Numero di compiti non ancora terminati
+		bool m_stopping = false;
+
+		void runWorker();
+		bool takeTask(std::unique_lock<std::mutex>& lock);
+
+	public:
+		WorkerPool(unsigned int workers_count);
+		~WorkerPool();
+
+		unsigned int getWorkersCount();
+		void run(unsigned long int tasks_count, std::function<void(unsigned long int)> task);
+	};
+
+} /* namespace translated_automata */
+
+#endif /* INCLUDE_WORKERPOOL_HPP_ */
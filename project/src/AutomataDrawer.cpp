@@ -109,4 +109,87 @@ namespace translated_automata {
 	/* Istanziazione della classe NFADrawer */
 	template class AutomataDrawer<NFA>;
 
+	/**
+	 * Costruttore.
+	 * Richiede in input l'automa da visualizzare.
+	 * Precondizione: l'automa non deve essere nullo.
+	 */
+	TableDFADrawer::TableDFADrawer(const TableDFA* automaton) {
+		this->m_automaton = automaton;
+	}
+
+	/**
+	 * Distruttore.
+	 * Non distrugge l'automa membro.
+	 */
+	TableDFADrawer::~TableDFADrawer() {}
+
+	/**
+	 * Restituisce una descrizione testuale di tutti gli stati appartenenti all'automa,
+	 * evidenziando lo stato iniziale. Il formato è lo stesso di "AutomataDrawer::asString", ad eccezione
+	 * delle distanze, che non fanno parte della rappresentazione tabellare.
+	 */
+	string TableDFADrawer::asString() {
+		const TableDFA* automaton = this->m_automaton;
+		const LabelIndex& label_index = automaton->getLabelIndex();
+		string result = "";
+		result += "AUTOMATON (size = " + std::to_string(automaton->size()) + ")\n";
+		if (automaton->getInitialState() != TABLE_DFA_NO_STATE) {
+			result += "Initial state: " + automaton->getName(automaton->getInitialState()) + '\n';
+		}
+
+		for (uint32_t state = 0; state < automaton->size(); state++) {
+			auto transitions = automaton->getTransitions(state);
+			result += "\033[33;1m" + automaton->getName(state) + "\033[0m";
+			if (automaton->isFinal(state)) {
+				result += " [FINAL]";
+			}
+			result += "\n\t" + std::to_string(transitions.size()) + " exiting transitions:\n";
+			for (auto &transition : transitions) {
+				result += "\t━━┥" + SHOW(label_index.getLabel(transition.first)) + "┝━━▶ " + automaton->getName(transition.second) + "\n";
+			}
+		}
+
+		return result;
+	}
+
+	/**
+	 * Scrive la rappresentazione dell'automa in formato GraphViz sul file specificato.
+	 * Il formato è lo stesso di "AutomataDrawer::asDotFile".
+	 */
+	void TableDFADrawer::asDotFile(string filename) {
+		const TableDFA* automaton = this->m_automaton;
+		const LabelIndex& label_index = automaton->getLabelIndex();
+		std::ofstream out(filename, std::ios_base::out | std::ios_base::trunc);
+
+		if (!out.is_open()) {
+			DEBUG_LOG_ERROR("Impossibile scrivere il file \"%s\"", filename.c_str());
+			return;
+		}
+
+		out << "digraph finite_state_machine {\n"
+				"rankdir=LR;\n"
+				"size=\"8,5\"\n";
+
+		for (uint32_t state = 0; state < automaton->size(); state++) {
+			const string& name = automaton->getName(state);
+			string shape = (automaton->isFinal(state)) ? "doublecircle" : "circle";
+			out << "node [shape = " << shape << ", label = \"" << name << "\", fontsize = 10] \"" << name << "\";\n";
+		}
+
+		if (automaton->getInitialState() != TABLE_DFA_NO_STATE) {
+			out << "node [shape = point]; init\n";
+			out << "init -> \"" << automaton->getName(automaton->getInitialState()) << "\"\n";
+		}
+
+		for (uint32_t state = 0; state < automaton->size(); state++) {
+			for (auto &transition : automaton->getTransitions(state)) {
+				out << "\"" << automaton->getName(state) << "\" -> \"" << automaton->getName(transition.second) << "\" [ label = \"" << label_index.getLabel(transition.first) << "\" ];\n";
+			}
+		}
+
+		out << "}";
+		out.close();
+	}
+
 } /* namespace translated_automata */
@@ -41,15 +41,16 @@ namespace translated_automata {
 	template <class Automaton>
 	AutomataGenerator<Automaton>::AutomataGenerator(Alphabet alphabet, Configurations* configurations) {
 		DEBUG_MARK_PHASE("Costruzione di un generatore di automi") {
+		const ConfigurationsSnapshot& config = configurations->getSnapshot();
 		this->m_alphabet = alphabet;
-		this->m_automaton_structure = (AutomatonType) configurations->valueOf<int>(AutomatonStructure);
-		this->m_size = configurations->valueOf<int>(AutomatonSize);
+		this->m_automaton_structure = (AutomatonType) config.automaton_structure;
+		this->m_size = config.automaton_size;
 		this->m_name_prefix	= default_name_prefix;
-		this->m_transition_percentage = configurations->valueOf<double>(AutomatonTransitionsPercentage);
-		this->m_epsilon_probability = configurations->valueOf<double>(EpsilonPercentage);
-		this->m_final_probability = configurations->valueOf<double>(AutomatonFinalProbability);
-		this->m_max_distance = configurations->valueOf<int>(AutomatonMaxDistance);
-		this->m_safe_zone_distance = configurations->valueOf<int>(AutomatonSafeZoneDistance);
+		this->m_transition_percentage = config.automaton_transitions_percentage;
+		this->m_epsilon_probability = config.epsilon_percentage;
+		this->m_final_probability = config.automaton_final_probability;
+		this->m_max_distance = config.automaton_max_distance;
+		this->m_safe_zone_distance = config.automaton_safe_zone_distance;
 		}
 	}
 
@@ -67,12 +67,9 @@ namespace translated_automata {
 		vector<StateDFA*> reached_states;
 		reached_states.push_back(initial_state);
 
-		/* 1.2) Una mappa tiene traccia delle label usate per ciascuno stato, in modo che non si abbiano stati con
-		 * transizioni uscenti marcate dalla stessa label.  */
-		map<StateDFA*, Alphabet> unused_labels;
-		for (StateDFA* state : dfa->getStatesVector()) {
-			unused_labels[state] = Alphabet(this->getAlphabet());
-		}
+		/* 1.2) Un vettore (indicizzato per identificatore di stato) tiene traccia delle label usate per ciascuno stato,
+		 * in modo che non si abbiano stati con transizioni uscenti marcate dalla stessa label.  */
+		vector<Alphabet> unused_labels(dfa->size(), this->getAlphabet());
 
 		/* 1.3) Parallelamente, si tiene traccia dei nodi non ancora marcati come "raggiungibili".
 		 * All'inizio tutti gli stati appartengono a questa lista, tranne il nodo iniziale. */
@@ -215,13 +212,10 @@ namespace translated_automata {
 			std::cout << "}\n";
 		})
 
-		/* Una mappa tiene traccia delle label usate per ciascuno stato, in modo che non si abbiano stati con
-		 * transizioni uscenti marcate dalla stessa label.
+		/* Un vettore (indicizzato per identificatore di stato) tiene traccia delle label usate per ciascuno stato,
+		 * in modo che non si abbiano stati con transizioni uscenti marcate dalla stessa label.
 		 */
-		map<StateDFA*, Alphabet> unused_labels;
-		for (StateDFA* state : dfa->getStatesVector()) {
-			unused_labels[state] = Alphabet(this->getAlphabet());
-		}
+		vector<Alphabet> unused_labels(dfa->size(), this->getAlphabet());
 
 		// Soddisfacimento della RAGGIUNGIBILITA'
 		/* L'iterazione su uno strato [i] prevede che i nodi dello strato vengano
@@ -311,9 +305,9 @@ namespace translated_automata {
 	/**
 	 * Restituisce uno stato casuale scelto da una lista assicurandosi che abbia ancora delle labels inutilizzate e disponibili
 	 * per la creazione di transizioni.
-	 * Nota: NON rimuove la label dalla mappa degli utilizzi.
+	 * Nota: NON rimuove la label dal vettore degli utilizzi.
 	 */
-	StateDFA* DFAGenerator::getRandomStateWithUnusedLabels(vector<StateDFA*> &states, map<StateDFA*, Alphabet> &unused_labels) {
+	StateDFA* DFAGenerator::getRandomStateWithUnusedLabels(vector<StateDFA*> &states, vector<Alphabet> &unused_labels) {
 		if (states.empty()) {
 			DEBUG_LOG_ERROR("Impossibile estrarre uno stato da una lista vuota");
 			return NULL;
@@ -327,8 +321,8 @@ namespace translated_automata {
 			from = states[random_index];
 
 			// Verifica dell'esistenza di label inutilizzate ancora disponibili
-			if (unused_labels[from].size() > 0) {
-				DEBUG_LOG("Ho trovato lo stato %s con %lu labels non utilizzate", from->getName().c_str(), unused_labels[from].size());
+			if (unused_labels[from->getId()].size() > 0) {
+				DEBUG_LOG("Ho trovato lo stato %s con %lu labels non utilizzate", from->getName().c_str(), unused_labels[from->getId()].size());
 				from_state_has_unused_labels = true;
 			} else {
 				// Eliminazione dello stato dalla lista degli stati da cui attingere
@@ -346,17 +340,17 @@ namespace translated_automata {
 	/**
 	 * Estrae (ed elimina) una label casuale dalla lista di label non ancora utilizzate di uno specifico stato.
 	 */
-	string DFAGenerator::extractRandomUnusedLabel(map<StateDFA*, Alphabet> &unused_labels, StateDFA* state) {
-		if (unused_labels[state].empty()) {
+	string DFAGenerator::extractRandomUnusedLabel(vector<Alphabet> &unused_labels, StateDFA* state) {
+		if (unused_labels[state->getId()].empty()) {
 			DEBUG_LOG_ERROR( "Non è stata trovata alcuna label inutilizzata per lo stato %s", state->getName().c_str() );
 			return NULL;
 		}
-		int label_random_index = rand() % unused_labels[state].size();
-		string extracted_label = unused_labels[state][label_random_index];
+		int label_random_index = rand() % unused_labels[state->getId()].size();
+		string extracted_label = unused_labels[state->getId()][label_random_index];
 		DEBUG_LOG("Estratta l'etichetta %s dallo stato %s", extracted_label.c_str(), state->getName().c_str());
 
 		// Cancellazione della label utilizzata
-		unused_labels[state].erase(unused_labels[state].begin() + label_random_index);
+		unused_labels[state->getId()].erase(unused_labels[state->getId()].begin() + label_random_index);
 		return extracted_label;
 	}
 
@@ -149,15 +149,18 @@ namespace translated_automata {
 			std::cout << "}\n";
 		})
 
-		/* Una mappa tiene traccia delle label usate per ogni stato della safe-zone.
+		/* Un vettore (indicizzato per identificatore di stato) tiene traccia delle label usate per ogni stato della safe-zone.
 		 * In questo modo ci si assicura il determinismo evitando duplicati nelle label.
-		 * Si richiede il determinismo a TUTTI E SOLI gli stati con distanza MINORE della SafeZoneDistance.
+		 * Si richiede il determinismo a TUTTI E SOLI gli stati con distanza MINORE della SafeZoneDistance;
+		 * gli altri stati non hanno label a disposizione.
 		 */
-		map<StateNFA*, Alphabet> unused_labels = map<StateNFA*, Alphabet>();
+		vector<Alphabet> unused_labels(nfa->size());
+		vector<StateNFA*> safe_zone_states;
 		unsigned int limit = (this->getSafeZoneDistance() < strata.size()) ? this->getSafeZoneDistance() : strata.size();
 		for (stratum_index = 0; stratum_index < limit; stratum_index++) {
 			for (StateNFA* state : strata[stratum_index]) {
-				unused_labels[state] = Alphabet(this->getAlphabet());
+				unused_labels[state->getId()] = Alphabet(this->getAlphabet());
+				safe_zone_states.push_back(state);
 			}
 		}
 
@@ -223,7 +226,7 @@ namespace translated_automata {
 
 				// In tal caso, estraggo uno stato genitore assicurandomi di poter garantire il determinismo
 				// Sicuramente gli stati rimasti hanno ancora delle label utilizzabili
-				from = this->getRandomStateWithUnusedLabels(unused_labels);
+				from = this->getRandomSafeZoneState(safe_zone_states, unused_labels);
 				// Estraggo una label ancora inutilizzata
 				label = this->extractRandomUnusedLabel(unused_labels, from);
 				/*
@@ -398,9 +401,9 @@ namespace translated_automata {
 	/**
 	 * Restituisce uno stato casuale scelto da una lista assicurandosi che abbia ancora delle labels inutilizzate e disponibili
 	 * per la creazione di transizioni.
-	 * Nota: NON rimuove la label dalla mappa degli utilizzi.
+	 * Nota: NON rimuove la label dal vettore degli utilizzi.
 	 */
-	StateNFA* NFAGenerator::getRandomStateWithUnusedLabels(vector<StateNFA*> &states, map<StateNFA*, Alphabet> &unused_labels) {
+	StateNFA* NFAGenerator::getRandomStateWithUnusedLabels(vector<StateNFA*> &states, vector<Alphabet> &unused_labels) {
 		// Creo un vettore ausiliario con gli stati in ingresso fra cui selezionare
 		vector<StateNFA*> states_aux = vector<StateNFA*>(states);
 
@@ -418,8 +421,8 @@ namespace translated_automata {
 			from = states_aux[random_index];
 
 			// Verifica dell'esistenza di label inutilizzate ancora disponibili
-			if (unused_labels.count(from) > 0 && unused_labels.at(from).size() > 0) {
-				DEBUG_LOG("Ho trovato lo stato %s con %lu labels non utilizzate", from->getName().c_str(), unused_labels.at(from).size());
+			if (unused_labels[from->getId()].size() > 0) {
+				DEBUG_LOG("Ho trovato lo stato %s con %lu labels non utilizzate", from->getName().c_str(), unused_labels[from->getId()].size());
 				from_state_has_unused_labels = true;
 			}
 			// Altrimenti elimino lo stato dalla lista
@@ -433,64 +436,50 @@ namespace translated_automata {
 		return from;
 	}
 
-	StateNFA* NFAGenerator::getRandomStateWithUnusedLabels(map<StateNFA*, Alphabet> &unused_labels) {
-		StateNFA* from;
-		bool from_state_has_unused_labels = false; // Flag pessimista
-		do {
+	/**
+	 * Restituisce uno stato casuale della safe-zone che abbia ancora delle labels inutilizzate.
+	 * A differenza del metodo precedente, gli stati che non hanno più labels inutilizzate vengono
+	 * rimossi definitivamente dal vettore degli stati della safe-zone.
+	 * Nota: NON rimuove la label dal vettore degli utilizzi.
+	 */
+	StateNFA* NFAGenerator::getRandomSafeZoneState(vector<StateNFA*> &safe_zone_states, vector<Alphabet> &unused_labels) {
+		while (true) {
 			// Verifico che siano presenti stati nel vettore
-			if (unused_labels.empty()) {
+			if (safe_zone_states.empty()) {
 				DEBUG_LOG_ERROR("Impossibile estrarre uno stato da una lista vuota");
 				throw "Impossibile estrarre uno stato da una lista vuota";
 			}
 
-			// Estrazione di uno stato casuale dalla lista
-			int random_index = rand() % unused_labels.size();
-			// Ciclo finché l'indice non corrisponde
-			int i = 0;
-			for (auto &pair : unused_labels) {
-				if (i == random_index) {
-					from = pair.first;
-					// Verifico direttamente se ci sono label disponibili
-					if (pair.second.size() > 0) {
-						DEBUG_LOG("Ho trovato lo stato %s con %lu labels non utilizzate", from->getName().c_str(), unused_labels.at(from).size());
-						from_state_has_unused_labels = true;
-						return from;
-					}
-
-					// Esco dal ciclo
-					break;
+			// Estrazione di uno stato casuale dal vettore
+			int random_index = rand() % safe_zone_states.size();
+			StateNFA* from = safe_zone_states[random_index];
 
-				} else {
-					i++;
-				}
+			// Verifico direttamente se ci sono label disponibili
+			if (unused_labels[from->getId()].size() > 0) {
+				DEBUG_LOG("Ho trovato lo stato %s con %lu labels non utilizzate", from->getName().c_str(), unused_labels[from->getId()].size());
+				return from;
 			}
 
 			DEBUG_LOG("Lo stato %s non ha più label inutilizzate; eviterò di selezionarlo nelle iterazioni successive", from->getName().c_str());
-			unused_labels.erase(from);
-
-		} while (!from_state_has_unused_labels);
-		/*
-		 * NOTA: in teoria qui si parte dall'assunto che la condizione rimanga sempre falsa e che il ciclo venga ripetuto.
-		 * Se infatti diventa vera, lo stato viene restituito prima.
-		 */
-
-		return from;
+			safe_zone_states[random_index] = safe_zone_states.back();
+			safe_zone_states.pop_back();
+		}
 	}
 
 	/**
 	 * Estrae (ed elimina) una label casuale dalla lista di label non ancora utilizzate di uno specifico stato.
 	 */
-	string NFAGenerator::extractRandomUnusedLabel(map<StateNFA*, Alphabet> &unused_labels, StateNFA* state) {
-		if (unused_labels[state].empty()) {
+	string NFAGenerator::extractRandomUnusedLabel(vector<Alphabet> &unused_labels, StateNFA* state) {
+		if (unused_labels[state->getId()].empty()) {
 			DEBUG_LOG_ERROR( "Non è stata trovata alcuna label inutilizzata per lo stato %s", state->getName().c_str() );
 			return NULL;
 		}
-		int label_random_index = rand() % unused_labels[state].size();
-		string extracted_label = unused_labels[state][label_random_index];
+		int label_random_index = rand() % unused_labels[state->getId()].size();
+		string extracted_label = unused_labels[state->getId()][label_random_index];
 		DEBUG_LOG("Estratta l'etichetta %s dallo stato %s", extracted_label.c_str(), state->getName().c_str());
 
 		// Cancellazione della label utilizzata
-		unused_labels[state].erase(unused_labels[state].begin() + label_random_index);
+		unused_labels[state->getId()].erase(unused_labels[state->getId()].begin() + label_random_index);
 		return extracted_label;
 	}
 
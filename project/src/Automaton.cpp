@@ -44,8 +44,9 @@ namespace translated_automata {
     		s->detachAllTransitions();
     	}
     	for (State* s : m_states) {
-//    		this->m_states.erase(s);
+    		delete s;
     	}
+    	this->m_states.clear();
 
     	}
     }
@@ -66,7 +67,7 @@ namespace translated_automata {
      */
     template <class State>
     bool Automaton<State>::hasState(State* s) {
-        return m_states.find(s) != m_states.end();
+        return s != NULL && s->m_id < m_states.size() && m_states[s->m_id] == s;
     }
 
     /**
@@ -104,6 +105,15 @@ namespace translated_automata {
     	return NULL;
     }
 
+    /**
+     * Restituisce lo stato con l'identificatore passato come parametro.
+     */
+    template <class State>
+    State* Automaton<State>::getStateById(unsigned int id) {
+    	DEBUG_ASSERT_TRUE(id < m_states.size());
+    	return m_states[id];
+    }
+
     /**
      * Restituisce l'insieme di tutti gli stati aventi il nome passato come parametro.
      * Normalmente questo metodo restituisce un unico stato, poiché gli stati sono unici per nome.
@@ -122,12 +132,26 @@ namespace translated_automata {
     }
 
     /**
-     * Aggiunge uno stato alla mappa degli stati di questo automa.
-     * Nel caso esi già uno stato associato a tale nome, quello pre-esistente viene sovrascritto.
+     * Aggiunge uno stato all'automa, assegnandogli il primo identificatore libero.
+     * Se lo stato appartiene già all'automa, l'operazione non ha effetto.
+     * Nota: uno stato può appartenere ad un solo automa alla volta.
      */
     template <class State>
     void Automaton<State>::addState(State* s) {
-        m_states.insert(s);
+    	if (this->hasState(s)) {
+    		return;
+    	}
+    	DEBUG_ASSERT_TRUE(s->m_id == STATE_NO_ID);
+    	s->m_id = m_states.size();
+        m_states.push_back(s);
+        // Lo stato adotta la modalità dell'automa per le transizioni entranti
+        if (!this->m_incoming_index) {
+        	s->m_incoming_transitions.clear();
+        	s->m_incoming_indexed = false;
+        } else if (!s->m_incoming_indexed) {
+        	// L'indice dello stato non è aggiornato: sarà ricostruito alla prossima richiesta
+        	this->m_incoming_index = false;
+        }
     }
 
     /**
@@ -137,15 +161,29 @@ namespace translated_automata {
      * Se la rimozione avviene restituisce "TRUE", altrimenti se lo stato
      * non viene trovato restituisce "FALSE".
 	 * Questo metodo NON distrugge lo stato.
+	 * Nota: se l'automa è stato costruito senza indice delle transizioni entranti, l'indice viene costruito.
+	 * La costruzione ha costo lineare nel numero di transizioni dell'automa, ma avviene solamente alla prima
+	 * rimozione: in seguito l'indice resta aggiornato, e le rimozioni successive costano quanto le transizioni
+	 * dello stato rimosso.
      */
     template <class State>
     bool Automaton<State>::removeState(State* s) {
+    	// Uno stato che non appartiene all'automa non viene modificato
+    	if (!this->hasState(s)) {
+    		return false;
+    	}
+    	// La rimozione delle transizioni entranti richiede l'indice
+    	this->buildIncomingIndex();
     	DEBUG_MARK_PHASE("Function \"detachAllTransitions\" sullo stato %s", s->getName().c_str()) {
     		s->detachAllTransitions();
     	}
     	DEBUG_LOG("Verifica dello stato dopo la funzione \"detachAllTransitions\" e prima di essere rimosso:\n%s", s->toString().c_str());
-    	DEBUG_ASSERT_TRUE(this->hasState(s));
-    	m_states.erase(s);
+    	// L'ultimo stato prende il posto (e l'identificatore) dello stato rimosso
+    	State* last = m_states.back();
+    	m_states[s->m_id] = last;
+    	last->m_id = s->m_id;
+    	m_states.pop_back();
+    	s->m_id = STATE_NO_ID;
     	DEBUG_ASSERT_FALSE(this->hasState(s));
     	return true;
     	// FIXME
@@ -231,55 +269,52 @@ namespace translated_automata {
         return m_initial_state;
     }
 
-    /**
-     * Metodo privato.
-     *
-     * Rimuove da un insieme tutti i nodi che sono raggiungibili (leggi: CONNESSI) dal nodo s passato come parametro
-     * mediante una transizione s->s', più tutti quelli che sono raggiungibili anche da essi in cascata.
-     * Inoltre, rimuove anche lo stato s.
-     * Questo metodo è usato per rimuovere tutti i nodi connessi (in maniera DIREZIONALE) allo stato iniziale,
-     * ossia tutti quelli raggiungibili nell'automa.
-     */
-    template <class State>
-    void Automaton<State>::removeReachableStates(State* s, set<State*> &states) {
-    	// Verifico se contengo lo stato s
-        if (states.find(s) != states.end()) {
-            states.erase(s);
-            // Rimuovo lo stato dalla mappa. Se lo rimuovessi DOPO la chiamata ricorsiva, un ciclo
-            // di transizioni sugli stati genererebbe uno stack di chiamate ricorsive illimitato.
-
-            // Per tutte le transizioni uscenti da s
-            for (auto &pair: s->getExitingTransitions()) {
-            	// Per ciascuno stato raggiunto dalle transizioni
-                for (State* child: pair.second) {
-                	removeReachableStates(child, states); // Chiamata ricorsiva sui figli
-                }
-            }
-        }
-    }
-
     /**
      * Rimuove gli stati dell'automa che non sono più raggiungibili dallo stato iniziale,
      * ossia tutti gli stati dell'automa che non possono essere "visitati" tramite una sequenza di transizioni.
      *
-     * L'idea è quella di prendere l'insieme di tutti gli stati dell'automa e rimuovere quelli raggiungibili.
-     * Gli stati che rimarranno saranno necessariamente gli stati irraggiungibili.
+     * Gli stati raggiungibili vengono marcati con una visita a partire dallo stato iniziale; gli stati
+     * rimanenti vengono rimossi, mentre quelli raggiungibili vengono compattati mantenendo il loro ordine
+     * relativo (e ricevono quindi nuovi identificatori).
      *
      * Restituisce gli stati che sono stati rimossi e che risultavano irraggiungibili.
      */
     template <class State>
     set<State*> Automaton<State>::removeUnreachableStates() {
-    	// Creo l'insieme di tutti gli stati dell'automa
-        set<State*> unreachable = set<State*>(m_states.begin(), m_states.end());
-
-        // Lavoro per differenza: rimuovo dall'insieme tutti gli stati raggiungibili
-        removeReachableStates(m_initial_state, unreachable);
+    	// Marcatura degli stati raggiungibili
+    	vector<bool> reached(m_states.size(), false);
+    	vector<State*> stack;
+    	if (this->hasState(m_initial_state)) {
+    		reached[m_initial_state->m_id] = true;
+    		stack.push_back(m_initial_state);
+    	}
+    	while (!stack.empty()) {
+    		State* s = stack.back();
+    		stack.pop_back();
+    		for (auto &pair: s->getExitingTransitionsRef()) {
+    			for (State* child: pair.second) {
+    				if (this->hasState(child) && !reached[child->m_id]) {
+    					reached[child->m_id] = true;
+    					stack.push_back(child);
+    				}
+    			}
+    		}
+    	}
 
-        // Mi restano tutti gli stati irrangiungibili, sui quali itero
-        for (State* s: unreachable) {
-        	// Rimuovo dalla mappa dell'automa ogni stato irraggiungibile
-            m_states.erase(s);
-        }
+    	// Rimozione degli stati non marcati e compattazione degli identificatori
+    	set<State*> unreachable;
+    	unsigned int next_id = 0;
+    	for (unsigned int id = 0; id < m_states.size(); id++) {
+    		State* s = m_states[id];
+    		if (reached[id]) {
+    			s->m_id = next_id;
+    			m_states[next_id++] = s;
+    		} else {
+    			s->m_id = STATE_NO_ID;
+    			unreachable.insert(s);
+    		}
+    	}
+    	m_states.resize(next_id);
 
         return unreachable;
     }
@@ -297,7 +332,8 @@ namespace translated_automata {
 
     /**
      * Restituisce il vettore dinamico di tutti gli stati dell'automa sotto forma di vector.
-     * Gli stati sono restituiti come puntatori.
+     * Gli stati sono restituiti come puntatori, in ordine di identificatore: la posizione di
+     * ciascuno stato nel vettore corrisponde al suo identificatore.
      * La classe "vector" permette un accesso casuale con tempo costante.
      */
     template <class State>
@@ -355,6 +391,96 @@ namespace translated_automata {
     	return this->connectStates(getState(from), getState(to), label);
     }
 
+    /**
+     * Verifica se gli stati dell'automa mantengono aggiornate le transizioni entranti.
+     */
+    template <class State>
+    bool Automaton<State>::hasIncomingIndex() {
+    	return this->m_incoming_index;
+    }
+
+    /**
+     * Imposta l'automa in modalità "solo in avanti": gli stati non mantengono più le transizioni entranti,
+     * e le nuove transizioni aggiornano solamente lo stato di partenza.
+     * È la modalità adatta agli automi che vengono solamente costruiti e visitati in avanti (ad esempio
+     * le soluzioni della Subset Construction o gli NFA tradotti); gli algoritmi che necessitano dei genitori
+     * di uno stato devono prima richiamare "buildIncomingIndex".
+     * Nota: è opportuno chiamare questo metodo prima di inserire le transizioni, anche se non è necessario.
+     */
+    template <class State>
+    void Automaton<State>::setForwardOnly() {
+    	this->m_incoming_index = false;
+    	for (State* s : m_states) {
+    		s->m_incoming_transitions.clear();
+    		s->m_incoming_indexed = false;
+    	}
+    }
+
+    /**
+     * Costruisce (se non già presente) l'indice delle transizioni entranti di tutti gli stati, trasponendo
+     * in blocco le transizioni uscenti: le coppie (label, genitore) vengono raggruppate per stato di arrivo
+     * e ordinate, in modo che ogni inserimento avvenga in coda ai contenitori dello stato.
+     * Al termine, l'automa mantiene l'indice aggiornato ad ogni nuova transizione.
+     * Nota: vengono considerate solamente le transizioni fra stati appartenenti all'automa.
+     */
+    template <class State>
+    void Automaton<State>::buildIncomingIndex() {
+    	if (this->m_incoming_index) {
+    		return;
+    	}
+    	DEBUG_MARK_PHASE("Costruzione dell'indice delle transizioni entranti") {
+
+    	// Conteggio delle transizioni entranti in ciascuno stato
+    	vector<unsigned long int> offsets(m_states.size() + 1, 0);
+    	for (State* s : m_states) {
+    		for (auto &pair : s->getExitingTransitionsRef()) {
+    			for (State* child : pair.second) {
+    				if (this->hasState(child)) {
+    					offsets[child->m_id + 1]++;
+    				}
+    			}
+    		}
+    	}
+    	for (unsigned int id = 0; id < m_states.size(); id++) {
+    		offsets[id + 1] += offsets[id];
+    	}
+
+    	// Distribuzione delle coppie (label, genitore) per stato di arrivo
+    	// Nota: le label fanno riferimento alle chiavi delle transizioni uscenti, che non vengono modificate
+    	vector<std::pair<const string*, State*>> entries(offsets.back());
+    	vector<unsigned long int> positions(offsets.begin(), offsets.end() - 1);
+    	for (State* s : m_states) {
+    		for (auto &pair : s->getExitingTransitionsRef()) {
+    			for (State* child : pair.second) {
+    				if (this->hasState(child)) {
+    					entries[positions[child->m_id]++] = std::make_pair(&pair.first, s);
+    				}
+    			}
+    		}
+    	}
+
+    	// Inserimento ordinato nelle transizioni entranti di ciascuno stato
+    	for (State* s : m_states) {
+    		auto begin = entries.begin() + offsets[s->m_id];
+    		auto end = entries.begin() + offsets[s->m_id + 1];
+    		std::sort(begin, end, [](const std::pair<const string*, State*>& lhs, const std::pair<const string*, State*>& rhs) {
+    			return (*lhs.first != *rhs.first) ? (*lhs.first < *rhs.first) : std::less<State*>()(lhs.second, rhs.second);
+    		});
+    		s->m_incoming_transitions.clear();
+    		TargetSet<State>* parents = NULL;
+    		for (auto it = begin; it != end; it++) {
+    			if (it == begin || *it->first != *(it - 1)->first) {
+    				parents = &(s->m_incoming_transitions[*it->first]);
+    			}
+    			parents->insert(it->second);
+    		}
+    		s->m_incoming_indexed = true;
+    	}
+    	this->m_incoming_index = true;
+
+    	}
+    }
+
     /**
      * Operatore di uguaglianza per automi.
      */
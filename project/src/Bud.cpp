@@ -33,6 +33,14 @@ namespace translated_automata {
 	 */
 	Bud::~Bud() {}
 
+	/**
+	 * Reimposta stato e label del Bud, in modo che l'oggetto possa essere riutilizzato.
+	 */
+	void Bud::reset(ConstructedStateDFA* state, const string& label) {
+		this->m_state = state;
+		this->m_label = label;
+	}
+
 	/**
 	 * Restituisce lo stato del Bud.
 	 */
@@ -71,43 +79,70 @@ namespace translated_automata {
 	/**
 	 * Funzione di comparazione di due Bud sulla base di:
 	 * 1) La distanza dello stato dallo stato iniziale dell'automa.
-	 * 2) Il nome dello stato.
+	 * 2) Il numero progressivo dello stato.
 	 * 3) La label.
+	 * Il numero progressivo non dipende dall'estensione dello stato, quindi il confronto non richiede
+	 * di calcolarne il nome e la posizione di un bud non cambia quando l'estensione viene sostituita.
 	 */
 	int Bud::compare(const Bud& rhs) const {
 		// Verifico le distanze degli stati
-		if (this->m_state->getDistance() == rhs.m_state->getDistance()) {
-			// Caso: Distanze degli stati uguali
-
-			// Verifico i nomi degli stati
-			if (this->m_state->getName() == rhs.m_state->getName()) {
-				// Caso: Nomi degli stati uguali
-
-				// Il confronto si opera sulle labels
-				return this->m_label.compare(rhs.m_label);
-
-			} else {
-				// Caso: Nomi degli stati diversi
-				// Il confronto si opera sui nomi
-				return this->m_state->getName().compare(rhs.m_state->getName());
-			}
-		} else {
+		if (this->m_state->getDistance() != rhs.m_state->getDistance()) {
 			// Caso: Distanze degli stati diverse
 			// Il confronto si opera sulle distanze
 			return (this->m_state->getDistance() - rhs.m_state->getDistance());
 		}
+
+		// Caso: Distanze degli stati uguali
+		// Verifico i numeri progressivi degli stati
+		if (this->m_state->getSerial() != rhs.m_state->getSerial()) {
+			return (this->m_state->getSerial() < rhs.m_state->getSerial()) ? -1 : 1;
+		}
+
+		// Caso: Stesso stato
+		// Il confronto si opera sulle labels
+		return this->m_label.compare(rhs.m_label);
 	}
 
 	/**
 	 * Costruttore.
 	 * Si occupa di inizializzare le strutture dati.
 	 */
-	BudsList::BudsList() : m_set() {}
+	BudsList::BudsList() : m_set() {
+		this->m_popped_bud = NULL;
+	}
 
 	/**
-	 * Distruttore vuoto
+	 * Distruttore.
+	 * Elimina tutti i bud ancora presenti nella lista e quelli conservati per il riutilizzo.
 	 */
-	BudsList::~BudsList() {}
+	BudsList::~BudsList() {
+		this->clear();
+		for (Bud* bud : this->m_free_buds) {
+			delete bud;
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce un bud con lo stato e la label specificati, riutilizzando se possibile un bud riciclato.
+	 */
+	Bud* BudsList::acquire(ConstructedStateDFA* state, const string& label) {
+		if (this->m_free_buds.empty()) {
+			return new Bud(state, label);
+		}
+		Bud* bud = this->m_free_buds.back();
+		this->m_free_buds.pop_back();
+		bud->reset(state, label);
+		return bud;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Conserva un bud non più utilizzato, in modo che possa essere riutilizzato senza nuove allocazioni.
+	 */
+	void BudsList::recycle(Bud* bud) {
+		this->m_free_buds.push_back(bud);
+	}
 
 	/**
 	 * Restituisce l'informazione riguardo alla presenza di almeno
@@ -124,15 +159,85 @@ namespace translated_automata {
 	 */
 	bool BudsList::insert(Bud* new_bud) {
 		// Tento l'inserimento all'interno del Set;
-		return ((this->m_set.insert(new_bud)).second);
+		auto result = this->m_set.insert(new_bud);
+		if (result.second) {
+			// Aggiornamento dell'indice per stato
+			this->m_state_index[new_bud->getState()].push_back(result.first);
+		}
+		return result.second;
+	}
+
+	/**
+	 * Inserisce un nuovo bud (stato, label) all'interno della lista, solamente se non è già presente.
+	 * Il bud viene creato internamente, riutilizzando i bud riciclati: in questo modo un inserimento
+	 * non richiede allocazioni per il bud, nemmeno in caso di duplicato.
+	 * In caso l'inserimento vada a buon fine, restituisce TRUE.
+	 */
+	bool BudsList::insert(ConstructedStateDFA* state, const string& label) {
+		Bud* new_bud = this->acquire(state, label);
+		if (this->insert(new_bud)) {
+			return true;
+		}
+		this->recycle(new_bud);
+		return false;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Rimuove il riferimento ad un bud dall'indice per stato.
+	 * Nota: il bud NON viene rimosso dal set.
+	 */
+	void BudsList::unindex(BudsSet::iterator bud_iterator) {
+		auto index_iterator = this->m_state_index.find((*bud_iterator)->getState());
+		vector<BudsSet::iterator>& state_buds = index_iterator->second;
+		for (auto it = state_buds.begin(); it != state_buds.end(); it++) {
+			if (*it == bud_iterator) {
+				*it = state_buds.back();
+				state_buds.pop_back();
+				break;
+			}
+		}
+		if (state_buds.empty()) {
+			this->m_state_index.erase(index_iterator);
+		}
+	}
+
+	/**
+	 * Restituisce il primo elemento della lista, senza estrarlo.
+	 */
+	Bud* BudsList::front() {
+		return *(this->m_set.begin());
+	}
+
+	/**
+	 * Restituisce (senza estrarli) tutti i bud all'inizio della lista che hanno la stessa distanza del primo,
+	 * nell'ordine in cui verrebbero estratti.
+	 */
+	vector<Bud*> BudsList::getFrontLayer() {
+		vector<Bud*> layer;
+		if (this->m_set.empty()) {
+			return layer;
+		}
+		unsigned int layer_distance = this->front()->getState()->getDistance();
+		for (auto it = this->m_set.begin(); it != this->m_set.end() && (*it)->getState()->getDistance() == layer_distance; it++) {
+			layer.push_back(*it);
+		}
+		return layer;
 	}
 
 	/**
 	 * Estrae il primo elemento della lista.
+	 * Il bud estratto appartiene ancora alla lista: rimane valido fino all'estrazione successiva
+	 * (o alla pulizia della lista), dopodiché viene riciclato.
 	 */
 	Bud* BudsList::pop() {
+		if (this->m_popped_bud != NULL) {
+			this->recycle(this->m_popped_bud);
+		}
 		Bud* first = *(this->m_set.begin());
+		this->unindex(this->m_set.begin());
 		this->m_set.erase(this->m_set.begin());
+		this->m_popped_bud = first;
 		return first;
 //		return (this->m_set.extract(this->m_set.begin()).value()); // Vecchia implementazione, funzionante solo con C++17
 	}
@@ -148,52 +253,95 @@ namespace translated_automata {
 
 	/**
 	 * Rimuove tutti i buds della lista relativi ad un particolare stato.
-	 * I buds vengono eliminati.
+	 * I buds vengono eliminati (riciclati).
 	 * Inoltre, restituisce tutte le label che appartenenvano a quei bud.
+	 * Grazie all'indice per stato, non è necessario scorrere l'intera lista.
 	 */
 	set<string> BudsList::removeBudsOfState(ConstructedStateDFA* target_state) {
-		DEBUG_LOG("Stampa di tutti i bud attualmente presenti:");
-		IF_DEBUG_ACTIVE(printBuds());
-
 		set<string> removed_labels = set<string>();
-		for (auto bud_iterator = this->m_set.begin(); bud_iterator != this->m_set.end(); /* No increment */) {
-
-			DEBUG_LOG_SUCCESS("Iterazione sul Bud %s", (*bud_iterator)->toString().c_str());
-			if ((*bud_iterator)->getState() == target_state) {
-
-				DEBUG_LOG("Ho trovato un Bud associato allo stato %s da rimuovere dalla lista dei bud", target_state->getName().c_str());
+		auto index_iterator = this->m_state_index.find(target_state);
+		if (index_iterator == this->m_state_index.end()) {
+			return removed_labels;
+		}
 
-				DEBUG_LOG("Memorizzo la label %s", (*bud_iterator)->getLabel().c_str());
-				removed_labels.insert((*bud_iterator)->getLabel());
+		for (BudsSet::iterator bud_iterator : index_iterator->second) {
+			DEBUG_LOG("Memorizzo la label %s", (*bud_iterator)->getLabel().c_str());
+			removed_labels.insert((*bud_iterator)->getLabel());
 
-				DEBUG_LOG("Rimuovo il bud %s", (*bud_iterator)->toString().c_str());
-				this->m_set.erase(bud_iterator++);
+			this->recycle(*bud_iterator);
+			this->m_set.erase(bud_iterator);
+		}
+		this->m_state_index.erase(index_iterator);
 
-			} else {
+		return removed_labels;
+	}
 
-				DEBUG_LOG("Il Bud %s non è associato allo stato %s", (*bud_iterator)->toString().c_str(), target_state->getName().c_str());
-				++bud_iterator;
+	/**
+	 * Riposiziona all'interno della lista tutti i bud relativi agli stati passati come parametro.
+	 * Questo metodo deve essere chiamato ogni volta che la distanza di uno stato viene modificata
+	 * mentre alcuni suoi bud si trovano nella lista, poiché la distanza determina l'ordinamento dei bud.
+	 * A differenza di "sort", il costo è proporzionale al numero dei bud riposizionati e non
+	 * alla dimensione della lista.
+	 */
+	void BudsList::repositionBudsOfStates(vector<ConstructedStateDFA*>& states) {
+		// Estrazione di tutti i bud degli stati modificati
+		// Nota: la rimozione avviene tramite iteratore, quindi non richiede confronti con gli elementi
+		// il cui ordinamento non è più valido. Solo dopo aver rimosso tutti questi elementi, il set
+		// torna ad essere consistente e possono essere effettuati i nuovi inserimenti.
+		vector<Bud*> extracted_buds;
+		for (ConstructedStateDFA* state : states) {
+			auto index_iterator = this->m_state_index.find(state);
+			if (index_iterator == this->m_state_index.end()) {
+				continue;
 			}
+			for (BudsSet::iterator bud_iterator : index_iterator->second) {
+				extracted_buds.push_back(*bud_iterator);
+				this->m_set.erase(bud_iterator);
+			}
+			this->m_state_index.erase(index_iterator);
 		}
 
-
-		DEBUG_LOG("Stampa di tutti i bud rimasti nella lista:");
-		IF_DEBUG_ACTIVE(printBuds());
-
-		return removed_labels;
+		// Re-inserimento dei bud nella posizione corretta
+		for (Bud* bud : extracted_buds) {
+			if (!this->insert(bud)) {
+				// Caso in cui esiste già un bud equivalente: il bud non viene re-inserito
+				this->recycle(bud);
+			}
+		}
 	}
 
 	/**
 	 * Funzione che riordina gli elementi della lista di Bud.
 	 * E' opportuno chiamare raramente questa funzione, poiché il sorting non è particolarmente efficiente,
 	 * dato l'uso sottostante di un set (che dovrebbe richiedere il sorting automatico).
+	 * Se sono noti gli stati modificati, è preferibile usare "repositionBudsOfStates".
 	 */
 	void BudsList::sort() {
-		set<Bud*, BudComparator> new_set = set<Bud*, BudComparator>();
-		for (auto it = this->m_set.begin(); it != this->m_set.end(); it++) {
-			new_set.insert(*it);
+		BudsSet old_set;
+		old_set.swap(this->m_set);
+		this->m_state_index.clear();
+		for (Bud* bud : old_set) {
+			if (!this->insert(bud)) {
+				this->recycle(bud);
+			}
+		}
+	}
+
+	/**
+	 * Svuota la lista, riciclando tutti i bud presenti (compreso l'ultimo estratto).
+	 * Le strutture interne mantengono la capacità raggiunta, in modo che la lista possa essere
+	 * riutilizzata per un nuovo problema senza riallocarle.
+	 */
+	void BudsList::clear() {
+		for (Bud* bud : this->m_set) {
+			this->recycle(bud);
+		}
+		if (this->m_popped_bud != NULL) {
+			this->recycle(this->m_popped_bud);
+			this->m_popped_bud = NULL;
 		}
-		this->m_set = new_set;
+		this->m_set.clear();
+		this->m_state_index.clear();
 	}
 
 }
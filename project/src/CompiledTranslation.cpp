@@ -0,0 +1,179 @@
+/*
+ * CompiledTranslation.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione della traduzione compilata.
+ *
+ */
+
+#include "CompiledTranslation.hpp"
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Costruttore.
+	 * L'alfabeto tradotto è costituito dalle traduzioni delle label dell'alfabeto originale, nello stesso
+	 * ordine (le label tradotte in EPSILON non ne fanno parte).
+	 * Il vettore di traduzione contiene una posizione per ogni identificatore originale, compresi quelli
+	 * riservati: la label sconosciuta viene tradotta nella label sconosciuta e EPSILON in EPSILON.
+	 */
+	CompiledTranslation::CompiledTranslation(Translation* translation, const LabelIndex& source_index)
+			: m_source_index(source_index), m_target_index(Alphabet()) {
+		Alphabet target_alphabet;
+		for (LabelId id = 0; id < source_index.size(); id++) {
+			target_alphabet.push_back(translation->translate(source_index.getLabel(id)));
+		}
+		this->m_target_index = LabelIndex(target_alphabet);
+
+		this->m_table.resize(source_index.getEpsilonId() + 1);
+		for (LabelId id = 0; id < source_index.size(); id++) {
+			this->m_table[id] = this->m_target_index.getId(target_alphabet[id]);
+		}
+		this->m_table[source_index.getUnknownId()] = this->m_target_index.getUnknownId();
+		this->m_table[source_index.getEpsilonId()] = this->m_target_index.getEpsilonId();
+		this->buildPreimages();
+	}
+
+	/**
+	 * Costruttore privato.
+	 * Crea una traduzione compilata a partire da una tabella già calcolata.
+	 */
+	CompiledTranslation::CompiledTranslation(const LabelIndex& source_index, const LabelIndex& target_index, vector<LabelId>&& table)
+			: m_source_index(source_index), m_target_index(target_index) {
+		DEBUG_ASSERT_TRUE(table.size() == source_index.getEpsilonId() + 1);
+		this->m_table = std::move(table);
+		this->buildPreimages();
+	}
+
+	/**
+	 * Metodo privato.
+	 * Calcola le controimmagini di tutti gli identificatori tradotti, raggruppando gli identificatori originali
+	 * per identificatore tradotto (counting sort sulla tabella di traduzione).
+	 */
+	void CompiledTranslation::buildPreimages() {
+		LabelId targets_count = this->m_target_index.getEpsilonId() + 1;
+		this->m_preimage_offsets.assign(targets_count + 1, 0);
+		for (LabelId target : this->m_table) {
+			this->m_preimage_offsets[target + 1]++;
+		}
+		for (LabelId id = 0; id < targets_count; id++) {
+			this->m_preimage_offsets[id + 1] += this->m_preimage_offsets[id];
+		}
+		this->m_preimage_labels.resize(this->m_table.size());
+		vector<uint32_t> positions(this->m_preimage_offsets.begin(), this->m_preimage_offsets.end() - 1);
+		for (LabelId source = 0; source < this->m_table.size(); source++) {
+			this->m_preimage_labels[positions[this->m_table[source]]++] = source;
+		}
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	CompiledTranslation::~CompiledTranslation() {}
+
+	const LabelIndex& CompiledTranslation::getSourceLabelIndex() const {
+		return this->m_source_index;
+	}
+
+	const LabelIndex& CompiledTranslation::getTargetLabelIndex() const {
+		return this->m_target_index;
+	}
+
+	/**
+	 * Traduce un singolo identificatore di label.
+	 */
+	LabelId CompiledTranslation::translate(LabelId label) const {
+		DEBUG_ASSERT_TRUE(label < this->m_table.size());
+		return this->m_table[label];
+	}
+
+	/**
+	 * Traduce un automa in formato CSR, producendo un nuovo automa (in generale un NFA) con la stessa
+	 * struttura e le label tradotte.
+	 * La struttura viene condivisa con l'automa originale: l'unico lavoro è una singola passata sequenziale
+	 * sul vettore delle label, limitata dalla banda di memoria.
+	 *
+	 * Nota: l'automa deve utilizzare lo stesso alfabeto (LabelIndex) con cui è stata compilata la traduzione.
+	 */
+	FlatAutomaton CompiledTranslation::translate(const FlatAutomaton& automaton) const {
+		DEBUG_ASSERT_TRUE(automaton.getLabelIndex().size() == this->m_source_index.size());
+		unsigned long int count = automaton.getTransitionsCount();
+		const LabelId* labels = automaton.getLabels();
+		const LabelId* table = this->m_table.data();
+
+		vector<LabelId> translated_labels(count);
+		LabelId* output = translated_labels.data();
+		for (unsigned long int i = 0; i < count; i++) {
+			output[i] = table[labels[i]];
+		}
+
+		return FlatAutomaton(automaton, this->m_target_index, std::move(translated_labels));
+	}
+
+	/**
+	 * Restituisce la composizione (this ∘ first), ossia la traduzione che equivale ad applicare prima
+	 * "first" e poi questa traduzione.
+	 * L'alfabeto tradotto di "first" viene ricondotto all'alfabeto originale di questa traduzione tramite
+	 * le label; le label che non vi appartengono non vengono tradotte (identità), come per Translation.
+	 */
+	CompiledTranslation CompiledTranslation::compose(const CompiledTranslation& first) const {
+		const LabelIndex& source_index = first.m_source_index;
+		const LabelIndex& middle_index = first.m_target_index;
+
+		// Label risultanti per ciascuna label dell'alfabeto originale di "first"
+		Alphabet composed_alphabet;
+		for (LabelId id = 0; id < source_index.size(); id++) {
+			LabelId middle_id = first.m_table[id];
+			if (middle_id == middle_index.getEpsilonId()) {
+				composed_alphabet.push_back(EPSILON);
+				continue;
+			}
+			const string& middle_label = middle_index.getLabel(middle_id);
+			LabelId this_id = this->m_source_index.getId(middle_label);
+			if (this_id == this->m_source_index.getUnknownId()) {
+				composed_alphabet.push_back(middle_label);
+			} else {
+				composed_alphabet.push_back(this->m_target_index.getLabel(this->m_table[this_id]));
+			}
+		}
+
+		LabelIndex target_index(composed_alphabet);
+		vector<LabelId> composed_table(source_index.getEpsilonId() + 1);
+		for (LabelId id = 0; id < source_index.size(); id++) {
+			composed_table[id] = target_index.getId(composed_alphabet[id]);
+		}
+		composed_table[source_index.getUnknownId()] = target_index.getUnknownId();
+		composed_table[source_index.getEpsilonId()] = target_index.getEpsilonId();
+		return CompiledTranslation(source_index, target_index, std::move(composed_table));
+	}
+
+	/**
+	 * Restituisce la controimmagine dell'identificatore tradotto, ossia tutti gli identificatori originali
+	 * (compresi quelli riservati) che vengono tradotti in esso.
+	 */
+	vector<LabelId> CompiledTranslation::preimage(LabelId label) const {
+		DEBUG_ASSERT_TRUE(label + 1 < this->m_preimage_offsets.size());
+		return vector<LabelId>(this->m_preimage_labels.begin() + this->m_preimage_offsets[label],
+				this->m_preimage_labels.begin() + this->m_preimage_offsets[label + 1]);
+	}
+
+	/**
+	 * Restituisce la traduzione inversa, dall'alfabeto tradotto all'alfabeto originale.
+	 * L'inversa esiste solamente se ogni label tradotta ha esattamente una controimmagine (la traduzione
+	 * è iniettiva e nessuna label viene tradotta in EPSILON); in caso contrario viene lanciata un'eccezione.
+	 */
+	CompiledTranslation CompiledTranslation::inverse() const {
+		vector<LabelId> inverse_table(this->m_target_index.getEpsilonId() + 1);
+		for (LabelId target = 0; target < inverse_table.size(); target++) {
+			if (this->m_preimage_offsets[target + 1] - this->m_preimage_offsets[target] != 1) {
+				throw "Impossibile invertire una traduzione non iniettiva o che produce epsilon-transizioni";
+			}
+			inverse_table[target] = this->m_preimage_labels[this->m_preimage_offsets[target]];
+		}
+		return CompiledTranslation(this->m_target_index, this->m_source_index, std::move(inverse_table));
+	}
+
+} /* namespace translated_automata */
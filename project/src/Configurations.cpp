@@ -7,6 +7,11 @@
 
 #include "Configurations.hpp"
 
+#include <cctype>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+
 #include "AutomataGenerator.hpp"
 #include "Debug.hpp"
 #include "ProblemGenerator.hpp"
@@ -190,6 +195,166 @@ namespace translated_automata {
 		}
 	}
 
+// LETTURA DEI VALORI TESTUALI
+
+	/**
+	 * Rimuove gli spazi all'inizio e alla fine della stringa.
+	 */
+	static string trim(const string& text) {
+		size_t begin = text.find_first_not_of(" \t\r\n");
+		if (begin == string::npos) {
+			return "";
+		}
+		size_t end = text.find_last_not_of(" \t\r\n");
+		return text.substr(begin, end - begin + 1);
+	}
+
+	/**
+	 * Confronta due stringhe senza distinguere fra maiuscole e minuscole.
+	 */
+	static bool equalsIgnoreCase(const string& lhs, const string& rhs) {
+		if (lhs.size() != rhs.size()) {
+			return false;
+		}
+		for (unsigned int i = 0; i < lhs.size(); i++) {
+			if (std::tolower((unsigned char) lhs[i]) != std::tolower((unsigned char) rhs[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static int parseInt(const string& text) {
+		string token = trim(text);
+		char* end;
+		long int value = std::strtol(token.c_str(), &end, 10);
+		if (token.empty() || *end != '\0' || value < INT_MIN || value > INT_MAX) {
+			throw "Valore intero non valido";
+		}
+		return (int) value;
+	}
+
+	static double parseDouble(const string& text) {
+		string token = trim(text);
+		char* end;
+		double value = std::strtod(token.c_str(), &end);
+		if (token.empty() || *end != '\0') {
+			throw "Valore reale non valido";
+		}
+		return value;
+	}
+
+	static bool parseBool(const string& text) {
+		string token = trim(text);
+		if (token == "1" || equalsIgnoreCase(token, "true") || equalsIgnoreCase(token, "yes") || equalsIgnoreCase(token, "on")) {
+			return true;
+		} else if (token == "0" || equalsIgnoreCase(token, "false") || equalsIgnoreCase(token, "no") || equalsIgnoreCase(token, "off")) {
+			return false;
+		}
+		throw "Valore booleano non valido";
+	}
+
+	/**
+	 * Aggiunge al vettore i valori descritti da un elemento di una lista.
+	 * L'elemento può essere un singolo valore oppure un intervallo nella forma "inizio..fine[:passo]",
+	 * i cui estremi sono inclusi. Il passo è additivo ("k" o "+k", di default "+1") oppure moltiplicativo ("xk" o "*k").
+	 * Esempi: "4..6" => {4, 5, 6}, "0.1..0.3:0.1" => {0.1, 0.2, 0.3}, "1000..10000:x2" => {1000, 2000, 4000, 8000}.
+	 */
+	template <class T>
+	static void expandValues(const string& item, T (*parse)(const string&), vector<T>& values) {
+		size_t dots = item.find("..");
+		if (dots == string::npos) {
+			values.push_back(parse(item));
+			return;
+		}
+
+		string bounds = item;
+		string step_text = "+1";
+		size_t colon = item.find(':', dots);
+		if (colon != string::npos) {
+			bounds = item.substr(0, colon);
+			step_text = trim(item.substr(colon + 1));
+		}
+		bool multiplicative = !step_text.empty() && (step_text[0] == 'x' || step_text[0] == '*');
+		if (multiplicative || (!step_text.empty() && step_text[0] == '+')) {
+			step_text = step_text.substr(1);
+		}
+
+		T start = parse(bounds.substr(0, dots));
+		T end = parse(bounds.substr(dots + 2));
+		T step = parse(step_text);
+		if (start > end) {
+			throw "Intervallo con estremo iniziale maggiore dell'estremo finale";
+		}
+
+		if (multiplicative) {
+			if (start <= 0 || step <= 1) {
+				throw "Intervallo moltiplicativo con estremo iniziale non positivo o fattore non maggiore di 1";
+			}
+			// Il confronto con "end / step" evita di superare il massimo rappresentabile
+			for (T value = start; ; value *= step) {
+				values.push_back(value);
+				if (value > end / step) {
+					break;
+				}
+			}
+		} else {
+			if (step <= 0) {
+				throw "Intervallo additivo con passo non positivo";
+			}
+			// I valori sono calcolati a partire dall'estremo iniziale, per non accumulare errori di arrotondamento;
+			// la tolleranza è nulla per i valori interi
+			const T tolerance = step / 1000000;
+			for (unsigned long int i = 0; start + (T) i * step <= end + tolerance; i++) {
+				values.push_back(start + (T) i * step);
+			}
+		}
+	}
+
+	/**
+	 * Espande una lista di elementi separati da virgole (valori singoli o intervalli) in un vettore di valori.
+	 */
+	template <class T>
+	static vector<T> parseValues(const string& text, T (*parse)(const string&)) {
+		vector<T> values;
+		size_t begin = 0;
+		while (true) {
+			size_t comma = text.find(',', begin);
+			expandValues(text.substr(begin, comma - begin), parse, values);
+			if (comma == string::npos) {
+				return values;
+			}
+			begin = comma + 1;
+		}
+	}
+
+	/**
+	 * Costruisce il valore di un parametro a partire dalla sua rappresentazione testuale.
+	 * Un solo valore produce un AtomicSettingValue, mentre una lista o un intervallo producono un CompositeSettingValue.
+	 */
+	static SettingValue* parseSettingValue(SettingType type, const string& text) {
+		bool multiple = text.find(',') != string::npos || text.find("..") != string::npos;
+		switch (type) {
+		case INT :
+			if (multiple) {
+				return new CompositeSettingValue(parseValues<int>(text, parseInt));
+			}
+			return new AtomicSettingValue(parseInt(text));
+		case DOUBLE :
+			if (multiple) {
+				return new CompositeSettingValue(parseValues<double>(text, parseDouble));
+			}
+			return new AtomicSettingValue(parseDouble(text));
+		case BOOL :
+			if (multiple) {
+				throw "Un parametro booleano non può assumere valori multipli";
+			}
+			return new AtomicSettingValue(parseBool(text));
+		default :
+			throw "Tipo del parametro sconosciuto";
+		}
+	}
+
 // CLASSE "Configurations"
 
 	/**
@@ -251,6 +416,11 @@ namespace translated_automata {
 		load(ActiveAutomatonPruning, true); // In caso sia attivato, evita la formazione e la gestione dello stato con estensione vuota, tramite procedura Automaton Pruning
 		load(ActiveRemovingLabel, true); // In caso sia attivato, utilizza una label apposita per segnalare le epsilon-transizione, che deve essere rimossa durante la determinizzazione
 		load(ActiveDistanceCheckInTranslation, false); // In caso sia attivato, durante la traduzione genera dei Bud solamente se gli stati soddisfano una particolare condizione sulla distanza [FIXME è una condizione che genera bug]
+		load(ActiveWavefrontProcessing, false); // In caso sia attivato, ESC pre-calcola in parallelo le l-closure di tutti i bud alla stessa distanza, prima di applicarne le regole in ordine
+		load(ActiveHardwareCounters, false); // In caso sia attivato, misura i contatori hardware (cicli, istruzioni, cache-miss, ...) durante le fasi degli algoritmi
+		load(ActiveResultCache, false); // In caso sia attivato, riutilizza le soluzioni SC di problemi di traduzione già risolti, riconosciuti tramite un'impronta canonica di automa e traduzione
+		load(ResultCacheCapacity, 65536); // Memoria massima (in KB) occupata dalle soluzioni mantenute nella cache dei risultati
+		load(ActiveResultCacheSpill, false); // In caso sia attivato, le soluzioni rimosse dalla cache dei risultati vengono salvate su disco anziché scartate
 		load(PrintStatistics, true);
 		load(LogStatistics, true);
 		load(PrintTranslation, false);
@@ -262,32 +432,110 @@ namespace translated_automata {
 		load(DrawESCSOlution, false);
 	}
 
+	/**
+	 * Carica le configurazioni contenute in un file, sovrascrivendo i valori già presenti.
+	 * Il file contiene un assegnamento "Parametro = Valore" per riga (si veda "loadAssignment").
+	 * Le righe vuote, i commenti (righe che iniziano con '#' o ';') e le intestazioni di sezione ("[...]")
+	 * vengono ignorate.
+	 */
+	void Configurations::loadFile(const string& file_path) {
+		std::ifstream file(file_path);
+		if (!file.is_open()) {
+			throw "Impossibile aprire il file di configurazione";
+		}
+		string line;
+		unsigned int line_number = 0;
+		while (std::getline(file, line)) {
+			line_number++;
+			string content = trim(line);
+			if (content.empty() || content[0] == '#' || content[0] == ';' || content[0] == '[') {
+				continue;
+			}
+			try {
+				this->loadAssignment(content);
+			} catch (const char* error) {
+				std::cerr << file_path << ":" << line_number << ": " << error << std::endl;
+				throw;
+			}
+		}
+	}
+
+	/**
+	 * Carica una singola configurazione nella forma "Parametro=Valore", sovrascrivendo il valore già presente.
+	 * Il parametro è indicato con il nome dell'identificatore (ad esempio "AutomatonSize"), senza distinzione
+	 * fra maiuscole e minuscole.
+	 * Il valore può essere una lista di elementi separati da virgole, ciascuno dei quali può essere un intervallo:
+	 * in tal caso il parametro assume a turno tutti i valori, come i parametri multi-valore di "load".
+	 * Esempi: "AutomatonSize=1000..100000:x2", "EpsilonPercentage=0,0.1,0.2", "ActiveAutomatonPruning=false".
+	 */
+	void Configurations::loadAssignment(const string& assignment) {
+		size_t separator = assignment.find('=');
+		if (separator == string::npos) {
+			throw "Assegnamento non valido, il formato atteso è \"Parametro=Valore\"";
+		}
+		const Setting& setting = Configurations::findSetting(trim(assignment.substr(0, separator)));
+		this->store(setting.m_id, parseSettingValue(setting.m_type, trim(assignment.substr(separator + 1))));
+	}
+
+	/**
+	 * Metodo statico privato.
+	 * Restituisce il setting associato alla chiave, senza distinzione fra maiuscole e minuscole.
+	 */
+	const Configurations::Setting& Configurations::findSetting(const string& key) {
+		for (int param = Testcases; param <= DrawESCSOlution; param++) {
+			if (equalsIgnoreCase(Configurations::settings_list[param].m_key, key)) {
+				return Configurations::settings_list[param];
+			}
+		}
+		throw "Parametro di configurazione sconosciuto";
+	}
+
+	/**
+	 * Metodo privato.
+	 * Memorizza il valore di un parametro, sostituendo ed eliminando quello eventualmente presente.
+	 */
+	void Configurations::store(const SettingID& id, SettingValue* value) {
+		auto search = this->m_settings_instances.find(id);
+		if (search != this->m_settings_instances.end()) {
+			delete search->second;
+			search->second = value;
+		} else {
+			this->m_settings_instances.insert(std::make_pair(id, value));
+		}
+		this->m_snapshot_stale = true;
+	}
+
 	/** Inizializzazione della lista di configurazioni */
 	const Configurations::Setting Configurations::settings_list[] = {
-			{ Testcases,					"Testcases", 								"#test", false },
-			{ ProblemType,					"Problem type", 							"problem", false },
-			{ AlphabetCardinality,			"Alphabet cardinality", 					"#alpha", true },
-			{ TranslationMixingFactor , 	"Translation mixing factor", 				"mixing", false },
-			{ TranslationOffset , 			"Translation offset", 						"offset", false },
-			{ EpsilonPercentage , 			"Epsilon percentage", 						"%epsilon", true },
-			{ AutomatonStructure , 			"Automaton's structure type", 				"structure", false },
-			{ AutomatonSize , 				"Automaton's size (#states)",	 			"#size", true },
-			{ AutomatonFinalProbability , 	"Automaton's final states probability", 	"%finals", false },
-			{ AutomatonTransitionsPercentage , "Automaton's transitions percentage", 	"%transitions", true },
-			{ AutomatonMaxDistance , 		"Automaton's max distance", 				"maxdist", true },
-			{ AutomatonSafeZoneDistance , 	"Automaton's safe-zone distance", 			"safezonedist", true },
-			{ ActiveAutomatonPruning , 		"Active \"automaton pruning\"", 			"?autompruning", false },
-			{ ActiveRemovingLabel , 		"Active \"removing label\"", 				"?removlabel", false },
-			{ ActiveDistanceCheckInTranslation , "Active \"distance check in translation\"", "?distcheck",  false },
-			{ PrintStatistics , 			"Print statistics", 						"?pstats", false },
-			{ LogStatistics , 				"Log statistics in file", 					"?lstats", false },
-			{ PrintTranslation , 			"Print translation", 						"?ptrad", false },
-			{ PrintOriginalAutomaton , 		"Print original automaton", 				"?porig", false },
-			{ PrintSCSolution , 			"Print SC solution", 						"?psc", false },
-			{ PrintESCSOlution , 			"Print ESC solution", 						"?pesc", false },
-			{ DrawOriginalAutomaton , 		"Draw original automaton", 					"?dorig", false },
-			{ DrawSCSolution , 				"Draw SC solution", 						"?dsc", false },
-			{ DrawESCSOlution , 			"Draw ESC solution", 						"?desc", false }
+			{ Testcases,					"Testcases",							INT,	"Testcases", 								"#test", false },
+			{ ProblemType,					"ProblemType",							INT,	"Problem type", 							"problem", false },
+			{ AlphabetCardinality,			"AlphabetCardinality",					INT,	"Alphabet cardinality", 					"#alpha", true },
+			{ TranslationMixingFactor , 	"TranslationMixingFactor",				DOUBLE,	"Translation mixing factor", 				"mixing", false },
+			{ TranslationOffset , 			"TranslationOffset",					DOUBLE,	"Translation offset", 						"offset", false },
+			{ EpsilonPercentage , 			"EpsilonPercentage",					DOUBLE,	"Epsilon percentage", 						"%epsilon", true },
+			{ AutomatonStructure , 			"AutomatonStructure",					INT,	"Automaton's structure type", 				"structure", false },
+			{ AutomatonSize , 				"AutomatonSize",						INT,	"Automaton's size (#states)",	 			"#size", true },
+			{ AutomatonFinalProbability , 	"AutomatonFinalProbability",			DOUBLE,	"Automaton's final states probability", 	"%finals", false },
+			{ AutomatonTransitionsPercentage , "AutomatonTransitionsPercentage",		DOUBLE,	"Automaton's transitions percentage", 	"%transitions", true },
+			{ AutomatonMaxDistance , 		"AutomatonMaxDistance",					INT,	"Automaton's max distance", 				"maxdist", true },
+			{ AutomatonSafeZoneDistance , 	"AutomatonSafeZoneDistance",			INT,	"Automaton's safe-zone distance", 			"safezonedist", true },
+			{ ActiveAutomatonPruning , 		"ActiveAutomatonPruning",				BOOL,	"Active \"automaton pruning\"", 			"?autompruning", false },
+			{ ActiveRemovingLabel , 		"ActiveRemovingLabel",					BOOL,	"Active \"removing label\"", 				"?removlabel", false },
+			{ ActiveDistanceCheckInTranslation , "ActiveDistanceCheckInTranslation",		BOOL,	"Active \"distance check in translation\"", "?distcheck",  false },
+			{ ActiveWavefrontProcessing , 	"ActiveWavefrontProcessing",			BOOL,	"Active \"wavefront processing\"", 		"?wavefront", false },
+			{ ActiveHardwareCounters , 		"ActiveHardwareCounters",				BOOL,	"Active \"hardware counters\"", 			"?hwcounters", false },
+			{ ActiveResultCache , 			"ActiveResultCache",					BOOL,	"Active \"result cache\"", 				"?rcache", false },
+			{ ResultCacheCapacity , 		"ResultCacheCapacity",					INT,	"Result cache capacity (KB)", 				"rcachekb", false },
+			{ ActiveResultCacheSpill , 		"ActiveResultCacheSpill",				BOOL,	"Active \"result cache spill\"", 			"?rcachespill", false },
+			{ PrintStatistics , 			"PrintStatistics",						BOOL,	"Print statistics", 						"?pstats", false },
+			{ LogStatistics , 				"LogStatistics",						BOOL,	"Log statistics in file", 					"?lstats", false },
+			{ PrintTranslation , 			"PrintTranslation",						BOOL,	"Print translation", 						"?ptrad", false },
+			{ PrintOriginalAutomaton , 		"PrintOriginalAutomaton",				BOOL,	"Print original automaton", 				"?porig", false },
+			{ PrintSCSolution , 			"PrintSCSolution",						BOOL,	"Print SC solution", 						"?psc", false },
+			{ PrintESCSOlution , 			"PrintESCSOlution",						BOOL,	"Print ESC solution", 						"?pesc", false },
+			{ DrawOriginalAutomaton , 		"DrawOriginalAutomaton",				BOOL,	"Draw original automaton", 					"?dorig", false },
+			{ DrawSCSolution , 				"DrawSCSolution",						BOOL,	"Draw SC solution", 						"?dsc", false },
+			{ DrawESCSOlution , 			"DrawESCSOlution",						BOOL,	"Draw ESC solution", 						"?desc", false }
 	};
 
 	/**
@@ -317,15 +565,13 @@ namespace translated_automata {
 
 	/**
 	 * Stampa i valori CORRENTI delle configurazioni attuali.
+	 * La stringa viene calcolata insieme all'istantanea, una sola volta per caso di test.
 	 */
-	string Configurations::getValueString() {
-		string result = "";
-		for (int param = Testcases; param <= DrawESCSOlution; param++) {
-			if (isTestParam((SettingID) param)) {
-				result += this->m_settings_instances.at((SettingID)param)->getValueString() + ", ";
-			}
+	const string& Configurations::getValueString() {
+		if (this->m_snapshot_stale) {
+			this->refreshSnapshot();
 		}
-		return result;
+		return this->m_value_string;
 	}
 
 	/**
@@ -353,6 +599,8 @@ namespace translated_automata {
 	 * Imposta i parametri salvati all'interno delle configurazioni con la combinazione successiva
 	 */
 	bool Configurations::nextTestCase() {
+		// Qualunque sia l'esito, almeno un valore è cambiato (o è tornato al primo della sua lista)
+		this->m_snapshot_stale = true;
 		for (auto &pair : this->m_settings_instances) {
 			// Se viene trovato un caso successivo, si restituisce TRUE
 			if (pair.second->nextCase()) {
@@ -362,5 +610,72 @@ namespace translated_automata {
 		return false;
 	}
 
+	/**
+	 * Restituisce l'istantanea dei valori correnti delle configurazioni.
+	 * Il riferimento rimane valido fino al successivo caso di test: chi necessita dei valori
+	 * più a lungo (o in un altro thread) deve copiarla.
+	 */
+	const ConfigurationsSnapshot& Configurations::getSnapshot() {
+		if (this->m_snapshot_stale) {
+			this->refreshSnapshot();
+		}
+		return this->m_snapshot;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Ricostruisce l'istantanea tipizzata e la stringa dei parametri di test a partire dai valori correnti.
+	 * I parametri non caricati mantengono il valore nullo.
+	 */
+	void Configurations::refreshSnapshot() {
+		ConfigurationsSnapshot& snapshot = this->m_snapshot;
+		snapshot = ConfigurationsSnapshot();
+
+		this->snapshotValue(Testcases, snapshot.testcases);
+
+		this->snapshotValue(ProblemType, snapshot.problem_type);
+
+		this->snapshotValue(AlphabetCardinality, snapshot.alphabet_cardinality);
+		this->snapshotValue(TranslationMixingFactor, snapshot.translation_mixing_factor);
+		this->snapshotValue(TranslationOffset, snapshot.translation_offset);
+		this->snapshotValue(EpsilonPercentage, snapshot.epsilon_percentage);
+
+		this->snapshotValue(AutomatonStructure, snapshot.automaton_structure);
+		this->snapshotValue(AutomatonSize, snapshot.automaton_size);
+		this->snapshotValue(AutomatonFinalProbability, snapshot.automaton_final_probability);
+		this->snapshotValue(AutomatonTransitionsPercentage, snapshot.automaton_transitions_percentage);
+		this->snapshotValue(AutomatonMaxDistance, snapshot.automaton_max_distance);
+		this->snapshotValue(AutomatonSafeZoneDistance, snapshot.automaton_safe_zone_distance);
+
+		this->snapshotValue(ActiveAutomatonPruning, snapshot.active_automaton_pruning);
+		this->snapshotValue(ActiveRemovingLabel, snapshot.active_removing_label);
+		this->snapshotValue(ActiveDistanceCheckInTranslation, snapshot.active_distance_check_in_translation);
+		this->snapshotValue(ActiveWavefrontProcessing, snapshot.active_wavefront_processing);
+		this->snapshotValue(ActiveHardwareCounters, snapshot.active_hardware_counters);
+		this->snapshotValue(ActiveResultCache, snapshot.active_result_cache);
+		this->snapshotValue(ResultCacheCapacity, snapshot.result_cache_capacity);
+		this->snapshotValue(ActiveResultCacheSpill, snapshot.active_result_cache_spill);
+
+		this->snapshotValue(PrintStatistics, snapshot.print_statistics);
+		this->snapshotValue(LogStatistics, snapshot.log_statistics);
+		this->snapshotValue(PrintTranslation, snapshot.print_translation);
+		this->snapshotValue(PrintOriginalAutomaton, snapshot.print_original_automaton);
+		this->snapshotValue(PrintSCSolution, snapshot.print_sc_solution);
+		this->snapshotValue(PrintESCSOlution, snapshot.print_esc_solution);
+
+		this->snapshotValue(DrawOriginalAutomaton, snapshot.draw_original_automaton);
+		this->snapshotValue(DrawSCSolution, snapshot.draw_sc_solution);
+		this->snapshotValue(DrawESCSOlution, snapshot.draw_esc_solution);
+
+		this->m_value_string = "";
+		for (int param = Testcases; param <= DrawESCSOlution; param++) {
+			if (isTestParam((SettingID) param) && this->m_settings_instances.count((SettingID) param)) {
+				this->m_value_string += this->m_settings_instances.at((SettingID)param)->getValueString() + ", ";
+			}
+		}
+
+		this->m_snapshot_stale = false;
+	}
+
 
 } /* namespace translated_automata */
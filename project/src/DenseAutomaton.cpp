@@ -0,0 +1,550 @@
+/*
+ * DenseAutomaton.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione delle rappresentazioni dense di DFA e NFA per il riconoscimento di parole.
+ *
+ * Formato degli stream in input: sequenza di identificatori LabelId (4 byte ciascuno, nell'ordine
+ * dei byte della macchina), senza alcuna intestazione. La parola termina con la fine dello stream.
+ *
+ */
+
+#include "DenseAutomaton.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define DENSE_DFA_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+///////////////////////////////////////////////////////////////////
+///_______________________________________________________________//
+///____________________ DENSE AUTOMATON __________________________//
+///_______________________________________________________________//
+///////////////////////////////////////////////////////////////////
+
+	/**
+	 * Costruttore.
+	 */
+	DenseAutomaton::DenseAutomaton(const Alphabet& alphabet) : m_label_index(alphabet) {
+		this->m_columns = this->m_label_index.getEpsilonId() + 1;
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	DenseAutomaton::~DenseAutomaton() {}
+
+	/**
+	 * Restituisce la corrispondenza fra label e identificatori utilizzata dall'automa.
+	 */
+	const LabelIndex& DenseAutomaton::getLabelIndex() {
+		return this->m_label_index;
+	}
+
+	/**
+	 * Restituisce TRUE se la parola viene accettata dall'automa.
+	 */
+	bool DenseAutomaton::accepts(const vector<LabelId>& word) {
+		return this->accepts(word.data(), word.size());
+	}
+
+	/**
+	 * Metodo protetto.
+	 * Valuta le parole comprese nell'intervallo [begin, end), scrivendo i risultati nelle posizioni corrispondenti.
+	 */
+	void DenseAutomaton::acceptsRange(const vector<vector<LabelId>>& words, vector<uint8_t>& results, unsigned long int begin, unsigned long int end) {
+		for (unsigned long int i = begin; i < end; i++) {
+			results[i] = this->accepts(words[i].data(), words[i].size());
+		}
+	}
+
+	/**
+	 * Valuta un insieme di parole, suddividendole fra più thread.
+	 * Restituisce, per ciascuna parola, 1 se la parola viene accettata e 0 altrimenti.
+	 * Se il numero di thread non è specificato, viene utilizzato il numero di core disponibili.
+	 */
+	vector<uint8_t> DenseAutomaton::acceptsBatch(const vector<vector<LabelId>>& words, unsigned int threads_count) {
+		vector<uint8_t> results(words.size(), 0);
+		if (threads_count == 0) {
+			threads_count = std::max(1U, std::thread::hardware_concurrency());
+		}
+		threads_count = std::min<unsigned long int>(threads_count,
+				(words.size() + DENSE_BATCH_MIN_WORDS_PER_THREAD - 1) / DENSE_BATCH_MIN_WORDS_PER_THREAD);
+
+		if (threads_count <= 1) {
+			this->acceptsRange(words, results, 0, words.size());
+		} else {
+			vector<std::thread> threads;
+			unsigned long int chunk_size = (words.size() + threads_count - 1) / threads_count;
+			for (unsigned long int begin = chunk_size; begin < words.size(); begin += chunk_size) {
+				threads.emplace_back(&DenseAutomaton::acceptsRange, this, std::cref(words), std::ref(results),
+						begin, std::min<unsigned long int>(begin + chunk_size, words.size()));
+			}
+			// Il primo blocco viene elaborato dal thread corrente
+			this->acceptsRange(words, results, 0, std::min<unsigned long int>(chunk_size, words.size()));
+			for (std::thread& thread : threads) {
+				thread.join();
+			}
+		}
+		return results;
+	}
+
+///////////////////////////////////////////////////////////////////
+///_______________________________________________________________//
+///________________________ DENSE DFA ____________________________//
+///_______________________________________________________________//
+///////////////////////////////////////////////////////////////////
+
+	/**
+	 * Costruttore.
+	 * Compila il DFA in una tabella di transizione. Se il DFA non ha uno stato iniziale, il
+	 * riconoscimento parte dallo stato pozzo e nessuna parola viene accettata.
+	 */
+	DenseDFA::DenseDFA(DFA* dfa) : DenseAutomaton(dfa->getAlphabet()) {
+		// Colonna di riempimento, che coincide con la colonna della label EPSILON (che non modifica lo stato)
+		this->m_padding_id = this->m_label_index.getEpsilonId();
+
+		vector<StateDFA*> states = dfa->getStatesVector();
+		DEBUG_ASSERT_TRUE((states.size() + 1) * (unsigned long int) this->m_columns <= UINT32_MAX);
+
+		// Tutte le transizioni sono inizialmente dirette verso lo stato pozzo
+		uint32_t sink_offset = states.size() * this->m_columns;
+		this->m_table.assign((states.size() + 1) * this->m_columns, sink_offset);
+		this->m_final.assign(states.size() + 1, 0);
+
+		// La label EPSILON non modifica lo stato corrente
+		LabelId epsilon_id = this->m_label_index.getEpsilonId();
+		for (unsigned int i = 0; i <= states.size(); i++) {
+			this->m_table[i * this->m_columns + epsilon_id] = i * this->m_columns;
+		}
+
+		for (unsigned int i = 0; i < states.size(); i++) {
+			this->m_final[i] = states[i]->isFinal();
+			for (auto &pair : states[i]->getExitingTransitionsRef()) {
+				if (pair.first == EPSILON || pair.second.empty()) {
+					continue;
+				}
+				LabelId label = this->m_label_index.getId(pair.first);
+				this->m_table[i * this->m_columns + label] = (*(pair.second.begin()))->getId() * this->m_columns;
+			}
+		}
+
+		StateDFA* initial_state = dfa->getInitialState();
+		this->m_initial_offset = (initial_state == NULL) ? sink_offset : initial_state->getId() * this->m_columns;
+
+		this->m_kernel = DFA_KERNEL_SCALAR;
+		this->setKernel(DenseDFA::detectKernel());
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	DenseDFA::~DenseDFA() {}
+
+	/**
+	 * Restituisce il numero di stati, escluso lo stato pozzo.
+	 */
+	unsigned int DenseDFA::size() {
+		return this->m_final.size() - 1;
+	}
+
+	/**
+	 * Metodo statico.
+	 * Restituisce il kernel più efficiente supportato dal processore in uso.
+	 */
+	DenseDFAKernel DenseDFA::detectKernel() {
+#ifdef DENSE_DFA_X86_KERNELS
+		if (__builtin_cpu_supports("avx512f")) {
+			return DFA_KERNEL_AVX512;
+		} else if (__builtin_cpu_supports("avx2")) {
+			return DFA_KERNEL_AVX2;
+		}
+#endif
+		return DFA_KERNEL_SCALAR;
+	}
+
+	/**
+	 * Metodo statico.
+	 * Restituisce il nome del kernel.
+	 */
+	string DenseDFA::nameOf(DenseDFAKernel kernel) {
+		switch (kernel) {
+		case DFA_KERNEL_SCALAR :		return "scalar";
+		case DFA_KERNEL_AVX2 :			return "avx2";
+		case DFA_KERNEL_AVX512 :		return "avx512";
+		default :						return "unknown";
+		}
+	}
+
+	/**
+	 * Restituisce il kernel utilizzato dalla modalità batch.
+	 */
+	DenseDFAKernel DenseDFA::getKernel() {
+		return this->m_kernel;
+	}
+
+	/**
+	 * Imposta il kernel utilizzato dalla modalità batch.
+	 * Se il kernel richiesto non è supportato dal processore, viene utilizzato il migliore fra quelli supportati.
+	 * I kernel vettoriali utilizzano indici a 32 bit con segno: per tabelle più grandi viene utilizzato il kernel scalare.
+	 */
+	void DenseDFA::setKernel(DenseDFAKernel kernel) {
+		DenseDFAKernel supported_kernel = DenseDFA::detectKernel();
+		if (kernel > supported_kernel) {
+			DEBUG_LOG_ERROR("Il kernel %s non è supportato dal processore, viene utilizzato il kernel %s",
+					DenseDFA::nameOf(kernel).c_str(), DenseDFA::nameOf(supported_kernel).c_str());
+			kernel = supported_kernel;
+		}
+		if (this->m_table.size() > INT_MAX) {
+			kernel = DFA_KERNEL_SCALAR;
+		}
+		this->m_kernel = kernel;
+	}
+
+	/**
+	 * Restituisce il numero di parole elaborate contemporaneamente dal kernel corrente.
+	 */
+	unsigned int DenseDFA::getLanesCount() {
+		switch (this->m_kernel) {
+		case DFA_KERNEL_AVX512 :		return 32;
+		case DFA_KERNEL_AVX2 :			return 16;
+		default :						return 8;
+		}
+	}
+
+	/**
+	 * Restituisce lo stato iniziale, da utilizzare come punto di partenza del metodo "run".
+	 */
+	uint32_t DenseDFA::getInitialState() {
+		return this->m_initial_offset;
+	}
+
+	/**
+	 * Legge la sequenza di label a partire dallo stato passato come parametro e restituisce lo stato raggiunto.
+	 * Permette di riconoscere parole suddivise in più blocchi, ad esempio lette da uno stream.
+	 */
+	uint32_t DenseDFA::run(uint32_t state, const LabelId* word, unsigned long int length) {
+		const uint32_t* table = this->m_table.data();
+		for (unsigned long int i = 0; i < length; i++) {
+			DEBUG_ASSERT_TRUE( word[i] < this->m_columns );
+			state = table[state + word[i]];
+		}
+		return state;
+	}
+
+	/**
+	 * Restituisce TRUE se lo stato (restituito da "getInitialState" o da "run") è finale.
+	 */
+	bool DenseDFA::isFinal(uint32_t state) {
+		return this->m_final[state / this->m_columns];
+	}
+
+	/**
+	 * Restituisce TRUE se la parola viene accettata dal DFA.
+	 */
+	bool DenseDFA::accepts(const LabelId* word, unsigned long int length) {
+		return this->isFinal(this->run(this->m_initial_offset, word, length));
+	}
+
+	/**
+	 * Restituisce TRUE se la parola contenuta nello stream (nel formato descritto in testa al file)
+	 * viene accettata dal DFA.
+	 */
+	bool DenseDFA::accepts(std::istream& stream) {
+		vector<LabelId> buffer(DENSE_STREAM_CHUNK_SIZE);
+		uint32_t state = this->m_initial_offset;
+		while (stream) {
+			stream.read((char*) buffer.data(), buffer.size() * sizeof(LabelId));
+			state = this->run(state, buffer.data(), stream.gcount() / sizeof(LabelId));
+		}
+		return this->isFinal(state);
+	}
+
+	/**
+	 * Metodo protetto.
+	 * Valuta le parole a gruppi, avanzando contemporaneamente su tutte le parole del gruppo: le letture della
+	 * tabella sono indipendenti fra loro, e la latenza di ciascuna viene così sovrapposta alle altre.
+	 * Le label del gruppo vengono disposte "per passo" (le label di posizione k di tutte le parole sono contigue),
+	 * completando le parole più corte con la label di riempimento; il gruppo viene quindi elaborato dal kernel corrente.
+	 */
+	void DenseDFA::acceptsRange(const vector<vector<LabelId>>& words, vector<uint8_t>& results, unsigned long int begin, unsigned long int end) {
+		unsigned int lanes = this->getLanesCount();
+		vector<LabelId> lanes_labels;
+		uint32_t states[DENSE_DFA_MAX_LANES];
+
+		unsigned long int i = begin;
+		for (; i + lanes <= end; i += lanes) {
+			unsigned long int max_length = 0;
+			for (unsigned int lane = 0; lane < lanes; lane++) {
+				max_length = std::max<unsigned long int>(max_length, words[i + lane].size());
+			}
+			lanes_labels.assign(max_length * lanes, this->m_padding_id);
+			for (unsigned int lane = 0; lane < lanes; lane++) {
+				const vector<LabelId>& word = words[i + lane];
+				for (unsigned long int k = 0; k < word.size(); k++) {
+					lanes_labels[k * lanes + lane] = word[k];
+				}
+			}
+
+			std::fill_n(states, lanes, this->m_initial_offset);
+			switch (this->m_kernel) {
+			case DFA_KERNEL_AVX512 :
+				DenseDFA::runLanesAVX512(this->m_table.data(), lanes_labels.data(), max_length, states);
+				break;
+			case DFA_KERNEL_AVX2 :
+				DenseDFA::runLanesAVX2(this->m_table.data(), lanes_labels.data(), max_length, states);
+				break;
+			default :
+				DenseDFA::runLanesScalar(this->m_table.data(), lanes_labels.data(), max_length, states);
+				break;
+			}
+
+			for (unsigned int lane = 0; lane < lanes; lane++) {
+				results[i + lane] = this->isFinal(states[lane]);
+			}
+		}
+		for (; i < end; i++) {
+			results[i] = this->accepts(words[i].data(), words[i].size());
+		}
+	}
+
+	/**
+	 * Metodo statico privato.
+	 * Kernel scalare: avanza 8 parole per "steps" passi, leggendo le label disposte per passo.
+	 */
+	void DenseDFA::runLanesScalar(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states) {
+		uint32_t s0 = states[0], s1 = states[1], s2 = states[2], s3 = states[3];
+		uint32_t s4 = states[4], s5 = states[5], s6 = states[6], s7 = states[7];
+		for (unsigned long int k = 0; k < steps; k++) {
+			const LabelId* labels = lanes_labels + k * 8;
+			s0 = table[s0 + labels[0]];
+			s1 = table[s1 + labels[1]];
+			s2 = table[s2 + labels[2]];
+			s3 = table[s3 + labels[3]];
+			s4 = table[s4 + labels[4]];
+			s5 = table[s5 + labels[5]];
+			s6 = table[s6 + labels[6]];
+			s7 = table[s7 + labels[7]];
+		}
+		states[0] = s0; states[1] = s1; states[2] = s2; states[3] = s3;
+		states[4] = s4; states[5] = s5; states[6] = s6; states[7] = s7;
+	}
+
+#ifdef DENSE_DFA_X86_KERNELS
+
+	/**
+	 * Metodo statico privato.
+	 * Kernel AVX2: avanza 16 parole per passo tramite due istruzioni gather indipendenti, in modo che
+	 * le letture di un gruppo di 8 parole siano in corso mentre viene avviato l'altro.
+	 */
+	__attribute__((target("avx2")))
+	void DenseDFA::runLanesAVX2(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states) {
+		__m256i current_low = _mm256_loadu_si256((const __m256i*) states);
+		__m256i current_high = _mm256_loadu_si256((const __m256i*) (states + 8));
+		for (unsigned long int k = 0; k < steps; k++) {
+			const LabelId* labels = lanes_labels + k * 16;
+			__m256i labels_low = _mm256_loadu_si256((const __m256i*) labels);
+			__m256i labels_high = _mm256_loadu_si256((const __m256i*) (labels + 8));
+			current_low = _mm256_i32gather_epi32((const int*) table, _mm256_add_epi32(current_low, labels_low), 4);
+			current_high = _mm256_i32gather_epi32((const int*) table, _mm256_add_epi32(current_high, labels_high), 4);
+		}
+		_mm256_storeu_si256((__m256i*) states, current_low);
+		_mm256_storeu_si256((__m256i*) (states + 8), current_high);
+	}
+
+	/**
+	 * Metodo statico privato.
+	 * Kernel AVX-512: avanza 32 parole per passo tramite due istruzioni gather indipendenti.
+	 */
+	__attribute__((target("avx512f")))
+	void DenseDFA::runLanesAVX512(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states) {
+		__m512i current_low = _mm512_loadu_si512((const void*) states);
+		__m512i current_high = _mm512_loadu_si512((const void*) (states + 16));
+		for (unsigned long int k = 0; k < steps; k++) {
+			const LabelId* labels = lanes_labels + k * 32;
+			__m512i labels_low = _mm512_loadu_si512((const void*) labels);
+			__m512i labels_high = _mm512_loadu_si512((const void*) (labels + 16));
+			current_low = _mm512_i32gather_epi32(_mm512_add_epi32(current_low, labels_low), (const void*) table, 4);
+			current_high = _mm512_i32gather_epi32(_mm512_add_epi32(current_high, labels_high), (const void*) table, 4);
+		}
+		_mm512_storeu_si512((void*) states, current_low);
+		_mm512_storeu_si512((void*) (states + 16), current_high);
+	}
+
+#else
+
+	// Su architetture diverse da x86 i kernel vettoriali non vengono mai selezionati da "detectKernel"
+	void DenseDFA::runLanesAVX2(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states) {
+		DenseDFA::runLanesScalar(table, lanes_labels, steps, states);
+	}
+
+	void DenseDFA::runLanesAVX512(const uint32_t* table, const LabelId* lanes_labels, unsigned long int steps, uint32_t* states) {
+		DenseDFA::runLanesScalar(table, lanes_labels, steps, states);
+	}
+
+#endif
+
+///////////////////////////////////////////////////////////////////
+///_______________________________________________________________//
+///________________________ DENSE NFA ____________________________//
+///_______________________________________________________________//
+///////////////////////////////////////////////////////////////////
+
+	/**
+	 * Costruttore.
+	 * Pre-calcola l'epsilon-chiusura di ciascuno stato e, per ogni coppia (label, stato), l'unione delle
+	 * epsilon-chiusure degli stati raggiunti. I bitset di una stessa label sono contigui in memoria.
+	 */
+	DenseNFA::DenseNFA(NFA* nfa) : DenseAutomaton(nfa->getAlphabet()) {
+		vector<StateNFA*> states = nfa->getStatesVector();
+		this->m_states_count = states.size();
+		this->m_words_per_set = (states.size() + 63) / 64;
+		unsigned int words = this->m_words_per_set;
+
+		// Epsilon-chiusure dei singoli stati
+		vector<uint64_t> closures(states.size() * words, 0);
+		for (unsigned int i = 0; i < states.size(); i++) {
+			ExtensionDFA extension;
+			extension.insert(states[i]);
+			for (StateNFA* member : ConstructedStateDFA::computeEpsilonClosure(extension)) {
+				unsigned int number = member->getId();
+				closures[i * words + number / 64] |= (1ULL << (number % 64));
+			}
+		}
+
+		// Successori epsilon-chiusi; la riga della label EPSILON di ciascuno stato è la sua epsilon-chiusura
+		this->m_successors.assign((unsigned long int) this->m_columns * states.size() * words, 0);
+		LabelId epsilon_id = this->m_label_index.getEpsilonId();
+		for (unsigned int i = 0; i < states.size(); i++) {
+			std::copy_n(&closures[i * words], words, &this->m_successors[((unsigned long int) epsilon_id * states.size() + i) * words]);
+			for (auto &pair : states[i]->getExitingTransitionsRef()) {
+				if (pair.first == EPSILON) {
+					continue;
+				}
+				LabelId label = this->m_label_index.getId(pair.first);
+				uint64_t* row = &this->m_successors[((unsigned long int) label * states.size() + i) * words];
+				for (StateNFA* child : pair.second) {
+					const uint64_t* closure = &closures[child->getId() * words];
+					for (unsigned int k = 0; k < words; k++) {
+						row[k] |= closure[k];
+					}
+				}
+			}
+		}
+
+		// Stati iniziali e finali
+		this->m_initial_set.assign(words, 0);
+		this->m_final_set.assign(words, 0);
+		StateNFA* initial_state = nfa->getInitialState();
+		if (initial_state != NULL) {
+			std::copy_n(&closures[initial_state->getId() * words], words, this->m_initial_set.begin());
+		}
+		for (unsigned int i = 0; i < states.size(); i++) {
+			if (states[i]->isFinal()) {
+				this->m_final_set[i / 64] |= (1ULL << (i % 64));
+			}
+		}
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	DenseNFA::~DenseNFA() {}
+
+	/**
+	 * Restituisce il numero di stati dell'NFA.
+	 */
+	unsigned int DenseNFA::size() {
+		return this->m_states_count;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Calcola nel bitset "next" l'insieme degli stati raggiunti dagli stati del bitset "current" leggendo la label.
+	 * Restituisce FALSE se l'insieme raggiunto è vuoto.
+	 */
+	bool DenseNFA::step(const uint64_t* current, uint64_t* next, LabelId label) {
+		DEBUG_ASSERT_TRUE( label < this->m_columns );
+		unsigned int words = this->m_words_per_set;
+		const uint64_t* label_rows = &this->m_successors[(unsigned long int) label * this->m_states_count * words];
+		std::fill_n(next, words, 0);
+
+		for (unsigned int w = 0; w < words; w++) {
+			uint64_t bits = current[w];
+			while (bits != 0) {
+				unsigned int state = w * 64 + __builtin_ctzll(bits);
+				bits &= bits - 1;
+				const uint64_t* row = &label_rows[(unsigned long int) state * words];
+				for (unsigned int k = 0; k < words; k++) {
+					next[k] |= row[k];
+				}
+			}
+		}
+
+		uint64_t any = 0;
+		for (unsigned int k = 0; k < words; k++) {
+			any |= next[k];
+		}
+		return any != 0;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce TRUE se il bitset contiene almeno uno stato finale.
+	 */
+	bool DenseNFA::intersectsFinalSet(const uint64_t* set) {
+		for (unsigned int k = 0; k < this->m_words_per_set; k++) {
+			if ((set[k] & this->m_final_set[k]) != 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Restituisce TRUE se la parola viene accettata dall'NFA.
+	 * Se l'insieme degli stati correnti diventa vuoto, la parola viene rifiutata senza leggere le label rimanenti.
+	 */
+	bool DenseNFA::accepts(const LabelId* word, unsigned long int length) {
+		vector<uint64_t> current = this->m_initial_set;
+		vector<uint64_t> next(this->m_words_per_set);
+		for (unsigned long int i = 0; i < length; i++) {
+			if (!this->step(current.data(), next.data(), word[i])) {
+				return false;
+			}
+			current.swap(next);
+		}
+		return this->intersectsFinalSet(current.data());
+	}
+
+	/**
+	 * Restituisce TRUE se la parola contenuta nello stream (nel formato descritto in testa al file)
+	 * viene accettata dall'NFA.
+	 */
+	bool DenseNFA::accepts(std::istream& stream) {
+		vector<LabelId> buffer(DENSE_STREAM_CHUNK_SIZE);
+		vector<uint64_t> current = this->m_initial_set;
+		vector<uint64_t> next(this->m_words_per_set);
+		while (stream) {
+			stream.read((char*) buffer.data(), buffer.size() * sizeof(LabelId));
+			unsigned long int length = stream.gcount() / sizeof(LabelId);
+			for (unsigned long int i = 0; i < length; i++) {
+				if (!this->step(current.data(), next.data(), buffer[i])) {
+					return false;
+				}
+				current.swap(next);
+			}
+		}
+		return this->intersectsFinalSet(current.data());
+	}
+
+} /* namespace translated_automata */
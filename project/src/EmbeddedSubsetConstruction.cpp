@@ -13,11 +13,14 @@
 #include "EmbeddedSubsetConstruction.hpp"
 
 #include <algorithm>
+#include <thread>
 
 #include "AutomataDrawer_impl.hpp"
 //#define DEBUG_MODE
 #include "Debug.hpp"
+#include "ExtensionPool.hpp"
 #include "Properties.hpp"
+#include "Trace.hpp"
 
 #define REMOVING_LABEL "~"
 
@@ -30,15 +33,26 @@ namespace translated_automata {
 	 */
 	EmbeddedSubsetConstruction::EmbeddedSubsetConstruction(Configurations* configurations) {
 		// Memorizzazione delle configurationi desiderate
-		this->m_active_automaton_pruning = configurations->valueOf<bool>(ActiveAutomatonPruning);
-		this->m_active_distance_check_in_translation = configurations->valueOf<bool>(ActiveDistanceCheckInTranslation);
-		this->m_active_removing_label = configurations->valueOf<bool>(ActiveRemovingLabel);
+		const ConfigurationsSnapshot& config = configurations->getSnapshot();
+		this->m_active_automaton_pruning = config.active_automaton_pruning;
+		this->m_active_distance_check_in_translation = config.active_distance_check_in_translation;
+		this->m_active_removing_label = config.active_removing_label;
+		this->m_active_wavefront_processing = config.active_wavefront_processing;
+		this->m_wavefront_distance = DEFAULT_VOID_DISTANCE;
+
+		// I thread del wavefront processing vengono creati una sola volta, e riutilizzati per ogni strato;
+		// il thread che esegue l'algoritmo partecipa al calcolo, quindi viene escluso dal conteggio
+		this->m_worker_pool = NULL;
+		if (this->m_active_wavefront_processing) {
+			this->m_worker_pool = new WorkerPool(std::max(1U, std::thread::hardware_concurrency()) - 1);
+		}
 
 		this->m_original_dfa = NULL;
 		this->m_translation = NULL;
-		this->m_buds = NULL;
+		this->m_buds = new BudsList();
 		this->m_reference_nfa = NULL;
 		this->m_translated_dfa = NULL;
+		this->m_containing_index_active = false;
 	}
 
 	/**
@@ -48,12 +62,15 @@ namespace translated_automata {
 	 * finale (poiché ancora usato all'esterno).
 	 */
 	EmbeddedSubsetConstruction::~EmbeddedSubsetConstruction() {
-		if (this->m_buds != NULL) {
-			delete this->m_buds;
-		}
-		if (this->m_reference_nfa) {
+		delete this->m_buds;
+		// L'NFA di riferimento viene eliminato solo se generato internamente (problema di traduzione),
+		// altrimenti appartiene al problema di determinizzazione
+		if (this->m_reference_nfa != NULL && this->m_original_dfa != NULL) {
 			delete this->m_reference_nfa;
 		}
+		if (this->m_worker_pool != NULL) {
+			delete this->m_worker_pool;
+		}
 	}
 
 	/**
@@ -61,22 +78,36 @@ namespace translated_automata {
 	 * Viene richiamato all'inizio di runAutomatonTranslation (che inizia la risoluzione di un
 	 * problema di traduzione) e di runAutomatonCheckup (che inizia la risoluzione di un problema
 	 * di determinizzazione).
+	 * Le strutture di lavoro (lista dei bud e mappe di associazione fra stati) non vengono eliminate ma
+	 * svuotate: mantengono la capacità raggiunta e i bud allocati, in modo che la risoluzione di una lunga
+	 * serie di problemi piccoli non richieda di riallocarle ad ogni problema.
 	 */
 	void EmbeddedSubsetConstruction::cleanInternalStatus() {
-		// Rimozione degli eventuali oggetti dell'esecuzione precedente
-		if (this->m_buds != NULL) {
-			delete this->m_buds;
-		}
-		if (this->m_reference_nfa) {
+		// Svuotamento della lista di bud dell'esecuzione precedente (i bud vengono riciclati)
+		this->m_buds->clear();
+		// L'NFA di riferimento viene eliminato solo se generato internamente (problema di traduzione),
+		// altrimenti appartiene al problema di determinizzazione
+		if (this->m_reference_nfa != NULL && this->m_original_dfa != NULL) {
 			delete this->m_reference_nfa;
 		}
 		// Nota: non cancello il risultato DFA poiché potrebbe essere ancora utilizzato da metodi esterni
 
 		this->m_original_dfa = NULL;
 		this->m_translation = NULL;
-		this->m_buds = NULL;
 		this->m_reference_nfa = NULL;
 		this->m_translated_dfa = NULL;
+		this->m_translation_states_map.clear();
+		this->m_checkup_states_map.clear();
+		this->m_applied_translation.clear();
+		this->m_reference_nfa_states.clear();
+		this->m_original_states_by_label.clear();
+		this->m_containing_states.clear();
+		this->m_containing_index_active = false;
+		this->m_extension_states.clear();
+		this->m_relocation_queue.clear();
+		this->m_wavefront_distance = DEFAULT_VOID_DISTANCE;
+		this->m_precomputed_l_closures.clear();
+		this->m_profile = ESCProfile();
 	}
 
 	/**
@@ -95,19 +126,24 @@ namespace translated_automata {
 		DEBUG_ASSERT_NOT_NULL(translation);
 		this->m_original_dfa = automaton;
 		this->m_translation = translation;
+		// La traduzione risale ai genitori degli stati del DFA originale
+		automaton->buildIncomingIndex();
 
 		// Istanziazione degli oggetti ausiliari
-		this->m_buds = new BudsList();
 		this->m_reference_nfa = new NFA();
 		this->m_translated_dfa = new DFA();
 
-		// Variabili locali ausiliarie
-		map<StateDFA*, pair<StateNFA*, ConstructedStateDFA*>> states_map = map<StateDFA*, pair<StateNFA*, ConstructedStateDFA*>>();
+		// Strutture di lavoro ausiliarie
+		auto& states_map = this->m_translation_states_map;
 				/* Mantiene le associazioni fra gli stati tradotti:
-				 * per ciascun stato dell'automa in input, memorizzo il puntatore allo stato DFA e allo stato NFA in output */
+				 * per ciascun stato dell'automa in input (indicizzato per identificatore), memorizzo il puntatore
+				 * allo stato DFA e allo stato NFA in output */
+		const vector<StateDFA*> original_states = this->m_original_dfa->getStatesVector();
+		states_map.assign(original_states.size(), pair<StateNFA*, ConstructedStateDFA*>(NULL, NULL));
+		this->m_reference_nfa_states.assign(original_states.size(), NULL);
 
 		// Iterazione su tutti gli stati dell'automa in input per creare gli stati corrispondenti
-		for (StateDFA* state : this->m_original_dfa->getStatesVector()) {
+		for (StateDFA* state : original_states) {
 
 			// Creo uno stato copia nell'NFA
 			StateNFA* translated_nfa_state = new StateNFA(state->getName(), state->isFinal());
@@ -120,9 +156,11 @@ namespace translated_automata {
 			ConstructedStateDFA* translated_dfa_state = new ConstructedStateDFA(extension);
 			// Lo aggiungo al DFA
 			this->m_translated_dfa->addState(translated_dfa_state);
+			this->indexExtension(translated_dfa_state);
 
 			// Associo allo stato originale i due nuovi stati, in modo da poterli ritrovare facilmente
-			states_map[state] = pair<StateNFA*, ConstructedStateDFA*>(translated_nfa_state, translated_dfa_state);
+			states_map[state->getId()] = pair<StateNFA*, ConstructedStateDFA*>(translated_nfa_state, translated_dfa_state);
+			this->m_reference_nfa_states[state->getId()] = translated_nfa_state;
 
 		}
 
@@ -130,18 +168,22 @@ namespace translated_automata {
 		// solamente quando le associazioni fra gli stati sono complete
 
 		// Iterazione su tutti gli stati dell'automa in input per copiare le transizioni
-		for (StateDFA* state : this->m_original_dfa->getStatesVector()) {
+		for (StateDFA* state : original_states) {
 
 			// Vengono recuperati gli stati creati in precedenza, associati allo stato dell'automa originale
-			StateNFA* translated_nfa_state = states_map[state].first;
-			ConstructedStateDFA* translated_dfa_state = states_map[state].second;
+			StateNFA* translated_nfa_state = states_map[state->getId()].first;
+			ConstructedStateDFA* translated_dfa_state = states_map[state->getId()].second;
 
 			// Iterazione su tutte le transizioni uscenti dallo stato dell'automa
-			for (auto &pair : state->getExitingTransitions()) {
+			for (auto &pair : state->getExitingTransitionsRef()) {
 
 				// Traduzione della label
 				string translated_label = this->m_translation->translate(pair.first);
 
+				// Memorizzazione delle informazioni necessarie ad un'eventuale ri-traduzione incrementale
+				this->m_applied_translation[pair.first] = translated_label;
+				this->m_original_states_by_label[pair.first].push_back(state);
+
 				// Distinguo due casi, basandomi sulla label tradotta
 				if (translated_label == EPSILON) {
 					// caso EPSILON-TRANSIZIONE
@@ -155,19 +197,19 @@ namespace translated_automata {
 						}
 
 						// Inserisco la transizione tradotta nell'automa NON DETERMINISTICO N
-						translated_nfa_state->connectChild(translated_label, states_map[child].first);
+						translated_nfa_state->connectChild(translated_label, states_map[child->getId()].first);
 
 						// Prima di inserire la transizione anche nell'automa DFA tradotto, verifico se le impostazioni
 						// richiedono l'uso della "label da rimozione"
 						if (this->m_active_removing_label) {
 							// Inserisco la transizione tradotta (ma con label DA RIMOZIONE) nell'automa DETERMINISTICO D'
-							translated_dfa_state->connectChild(REMOVING_LABEL, states_map[child].second);
+							translated_dfa_state->connectChild(REMOVING_LABEL, states_map[child->getId()].second);
 							// Inserisco il nuovo bud nella lista, che servirà per rimuovere la transizione.
 							this->addBudToList(translated_dfa_state, REMOVING_LABEL);
 						}
 						else {
 							// Inserisco la transizione NON TRADOTTA nell'automa DETERMINISTICO D'
-							translated_dfa_state->connectChild(pair.first, states_map[child].second);
+							translated_dfa_state->connectChild(pair.first, states_map[child->getId()].second);
 							// Inserisco un nuovo bud nella lista con la label NON TRADOTTA. Questo permetterà di rimuovere la transizione durante l'esecuzione.
 							this->addBudToList(translated_dfa_state, pair.first);
 						}
@@ -192,7 +234,7 @@ namespace translated_automata {
 												|| parent->getDistance() <= current_distance) {
 
 											// Aggiungo il bud (stato_genitore, label)
-											this->addBudToList(states_map[parent].second, translated_parent_label);
+											this->addBudToList(states_map[parent->getId()].second, translated_parent_label);
 										}
 									}
 								}
@@ -207,15 +249,15 @@ namespace translated_automata {
 					// Per tutti gli stati figli raggiunti da transizioni marcate con la label originaria
 					for (StateDFA* child : pair.second) {
 						// Inserisco la transizione tradotta nell'automa NON DETERMINISTICO N
-						translated_nfa_state->connectChild(translated_label, states_map[child].first);
+						translated_nfa_state->connectChild(translated_label, states_map[child->getId()].first);
 						// Inserisco la transizione tradotta nell'automa DETERMINISTICO D'
-						translated_dfa_state->connectChild(translated_label, states_map[child].second);
+						translated_dfa_state->connectChild(translated_label, states_map[child->getId()].second);
 					}
 
 					// Verifico i punti di non determinismo:
 					// se gli stati raggiunti dalle transizioni marcate con quest'etichetta sono più di uno,
 					// allora aggiungo un bud alla lista.
-					auto children_with_translated_label = translated_dfa_state->getExitingTransitionsRef().at(translated_label);
+					const auto& children_with_translated_label = translated_dfa_state->getExitingTransitionsRef().at(translated_label);
 					if (children_with_translated_label.size() > 1) {
 						this->addBudToList(translated_dfa_state, translated_label);
 					}
@@ -226,8 +268,124 @@ namespace translated_automata {
 		}
 
 		// Marco gli stati iniziali
-		this->m_reference_nfa->setInitialState(states_map[this->m_original_dfa->getInitialState()].first);
-		this->m_translated_dfa->setInitialState(states_map[this->m_original_dfa->getInitialState()].second);
+		this->m_reference_nfa->setInitialState(states_map[this->m_original_dfa->getInitialState()->getId()].first);
+		this->m_translated_dfa->setInitialState(states_map[this->m_original_dfa->getInitialState()->getId()].second);
+	}
+
+	/**
+	 * Metodo che implementa la ri-traduzione incrementale.
+	 * Applica una nuova traduzione allo stesso automa dell'ultimo problema di traduzione risolto, riutilizzando
+	 * il DFA risultante (che viene modificato direttamente) invece di ricostruirlo da capo.
+	 *
+	 * Vengono individuate le label originali la cui traduzione è cambiata; l'NFA di riferimento viene aggiornato
+	 * solamente sulle transizioni uscenti dagli stati che possiedono transizioni marcate da quelle label.
+	 * Poiché l'epsilon-chiusura non cambia, le uniche l-closure che possono essere cambiate sono quelle, rispetto
+	 * alle label tradotte coinvolte (vecchie e nuove), degli stati DFA la cui estensione contiene uno stato NFA
+	 * modificato: solo queste coppie (stato, label) vengono inserite come bud. Gli stati DFA coinvolti sono individuati
+	 * tramite l'indice inverso delle estensioni (si veda "getStatesContaining"), senza scorrere l'intero DFA.
+	 * La successiva esecuzione della fase "Bud Processing" si occupa di propagare le modifiche.
+	 *
+	 * Se una delle traduzioni modificate coinvolge la label EPSILON, le epsilon-chiusure (e quindi le estensioni)
+	 * possono cambiare in tutto l'automa: in tal caso viene eseguita la traduzione completa.
+	 *
+	 * Nota: il risultato del problema precedente non deve essere stato eliminato, poiché viene riutilizzato.
+	 * Il nuovo risultato deve essere comunque richiesto con "getResult" (in caso di traduzione completa è un nuovo automa).
+	 *
+	 * INPUT:
+	 * @param translation La nuova traduzione da applicare all'automa del problema precedente.
+	 */
+	void EmbeddedSubsetConstruction::runIncrementalTranslation(Translation* translation) {
+		DEBUG_ASSERT_NOT_NULL(translation);
+		if (this->m_original_dfa == NULL || this->m_translated_dfa == NULL) {
+			DEBUG_LOG_ERROR("Impossibile eseguire la traduzione incrementale senza un precedente problema di traduzione");
+			return;
+		}
+
+		// Individuazione delle label originali la cui traduzione è cambiata
+		set<string> changed_labels;
+		set<string> involved_translated_labels;
+		for (auto &pair : this->m_applied_translation) {
+			string new_translated_label = translation->translate(pair.first);
+			if (new_translated_label != pair.second) {
+				// Con la label EPSILON è necessaria la traduzione completa
+				if (pair.second == EPSILON || new_translated_label == EPSILON) {
+					DEBUG_LOG("La traduzione della label %s coinvolge EPSILON: eseguo la traduzione completa", pair.first.c_str());
+					this->runAutomatonTranslation(this->m_original_dfa, translation);
+					return;
+				}
+				changed_labels.insert(pair.first);
+				involved_translated_labels.insert(pair.second);
+				involved_translated_labels.insert(new_translated_label);
+			}
+		}
+
+		// Reset delle strutture della precedente esecuzione (ma non degli automi)
+		this->m_translation = translation;
+		this->m_wavefront_distance = DEFAULT_VOID_DISTANCE;
+		this->m_precomputed_l_closures.clear();
+		this->m_profile = ESCProfile();
+
+		// Stati originali coinvolti dalla modifica
+		set<StateDFA*> affected_original_states;
+		for (string label : changed_labels) {
+			for (StateDFA* state : this->m_original_states_by_label[label]) {
+				affected_original_states.insert(state);
+			}
+		}
+
+		// Aggiornamento dell'NFA di riferimento
+		set<StateNFA*> affected_nfa_states;
+		for (StateDFA* state : affected_original_states) {
+			StateNFA* nfa_state = this->m_reference_nfa_states[state->getId()];
+			affected_nfa_states.insert(nfa_state);
+
+			// Transizioni tradotte con la vecchia e con la nuova traduzione
+			// Nota: più label originali possono avere la stessa traduzione, quindi si confrontano gli insiemi complessivi
+			set<pair<string, StateNFA*>> old_transitions, new_transitions;
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				string old_label = this->m_applied_translation.at(pair.first);
+				string new_label = translation->translate(pair.first);
+				for (StateDFA* child : pair.second) {
+					old_transitions.insert({ old_label, this->m_reference_nfa_states[child->getId()] });
+					new_transitions.insert({ new_label, this->m_reference_nfa_states[child->getId()] });
+				}
+			}
+			for (auto &transition : old_transitions) {
+				if (new_transitions.count(transition) == 0) {
+					nfa_state->disconnectChild(transition.first, transition.second);
+				}
+			}
+			for (auto &transition : new_transitions) {
+				if (old_transitions.count(transition) == 0) {
+					nfa_state->connectChild(transition.first, transition.second);
+				}
+			}
+		}
+		for (string label : changed_labels) {
+			this->m_applied_translation[label] = translation->translate(label);
+		}
+
+		// Stati DFA la cui estensione contiene uno stato NFA modificato, tramite l'indice inverso delle estensioni
+		set<ConstructedStateDFA*> affected_dfa_states;
+		for (StateNFA* nfa_state : affected_nfa_states) {
+			for (ConstructedStateDFA* dfa_state : this->getStatesContaining(nfa_state)) {
+				affected_dfa_states.insert(dfa_state);
+			}
+		}
+
+		// Inserimento dei bud per gli stati DFA coinvolti
+		for (ConstructedStateDFA* dfa_state : affected_dfa_states) {
+			for (string label : involved_translated_labels) {
+				// Il bud è utile solo se esiste una transizione nel DFA oppure nell'estensione
+				bool has_transitions = !dfa_state->getChildren(label).empty();
+				for (auto it = dfa_state->getExtension().begin(); !has_transitions && it != dfa_state->getExtension().end(); it++) {
+					has_transitions = !(*it)->getChildren(label).empty();
+				}
+				if (has_transitions) {
+					this->addBudToList(dfa_state, label);
+				}
+			}
+		}
 	}
 
 	/**
@@ -239,24 +397,37 @@ namespace translated_automata {
 	 * @param automaton L'automa da determinizzare.
 	 */
 	void EmbeddedSubsetConstruction::runAutomatonCheckup(NFA* automaton) {
+		this->runAutomatonCheckup(automaton, new DFA());
+	}
+
+	/**
+	 * Metodo privato.
+	 * Implementazione della fase "Automaton Checkup", che costruisce l'automa isomorfo all'interno
+	 * del DFA (vuoto) passato come parametro.
+	 */
+	void EmbeddedSubsetConstruction::runAutomatonCheckup(NFA* automaton, DFA* result) {
 		this->cleanInternalStatus();
 		// Acquisizione degli input
 		DEBUG_ASSERT_NOT_NULL(automaton);
+		DEBUG_ASSERT_NOT_NULL(result);
 		this->m_reference_nfa = automaton;
+		// Il checkup (e le eventuali modifiche incrementali) risalgono ai genitori degli stati dell'NFA
+		automaton->buildIncomingIndex();
 
 		// Istanziazione degli oggetti ausiliari
-		this->m_buds = new BudsList();
-		this->m_translated_dfa = new DFA();
+		this->m_translated_dfa = result;
 		// NOTA: "original_dfa" e "translation" non vengono utilizzati per i problemi di determinizzazione.
 
-		// Variabili locali ausiliarie
-		map<StateNFA*, ConstructedStateDFA*> states_map = map<StateNFA*, ConstructedStateDFA*>();
-			/* Poiché è necessario generare un automa isomorfo a quello originale, questa mappa
-			 * mantiene la corrispondenza fra gli stati dell'NFA con quelli del DFA.
+		// Strutture di lavoro ausiliarie
+		auto& states_map = this->m_checkup_states_map;
+			/* Poiché è necessario generare un automa isomorfo a quello originale, questo vettore
+			 * mantiene la corrispondenza fra gli stati dell'NFA (indicizzati per identificatore) con quelli del DFA.
 			 */
+		const vector<StateNFA*> reference_states = this->m_reference_nfa->getStatesVector();
+		states_map.assign(reference_states.size(), NULL);
 
 		// Iterazione su tutti gli stati dell'automa in input per creare gli stati corrispondenti
-		for (StateNFA* state : this->m_reference_nfa->getStatesVector()) {
+		for (StateNFA* state : reference_states) {
 
 			// Creo uno stato copia nel DFA
 			ExtensionDFA extension;
@@ -264,9 +435,10 @@ namespace translated_automata {
 			ConstructedStateDFA* translated_dfa_state = new ConstructedStateDFA(extension);
 			// Lo aggiungo al DFA
 			this->m_translated_dfa->addState(translated_dfa_state);
+			this->indexExtension(translated_dfa_state);
 
 			// Associo allo stato originale il nuovo stato del DFA, in modo da poterlo ritrovare facilmente
-			states_map[state] = translated_dfa_state;
+			states_map[state->getId()] = translated_dfa_state;
 
 		}
 
@@ -275,16 +447,16 @@ namespace translated_automata {
 		// solamente quando le associazioni fra gli stati sono complete
 
 		// Iterazione su tutti gli stati dell'automa in input per copiare le transizioni
-		for (StateNFA* state : this->m_reference_nfa->getStatesVector()) {
+		for (StateNFA* state : reference_states) {
 
 			// Viene recuperato lo stato creato in precedenza, associato allo stato dell'automa originale
-			ConstructedStateDFA* translated_dfa_state = states_map[state];
+			ConstructedStateDFA* translated_dfa_state = states_map[state->getId()];
 
 			// Iterazione su tutte le transizioni uscenti dallo stato dell'automa
-			for (auto &pair : state->getExitingTransitions()) {
+			for (auto &pair : state->getExitingTransitionsRef()) {
 
 				// Label corrente
-				string current_label = pair.first;
+				const string& current_label = pair.first;
 
 				// Distinguo due casi, basandomi sulla label dell'automa NFA di riferimento
 				if (current_label == EPSILON) {
@@ -299,7 +471,7 @@ namespace translated_automata {
 						}
 
 						// Inserisco la transizione con label che segnala la RIMOZIONE nell'automa DETERMINISTICO D'
-						translated_dfa_state->connectChild(REMOVING_LABEL, states_map[child]);
+						translated_dfa_state->connectChild(REMOVING_LABEL, states_map[child->getId()]);
 						// Inserisco il nuovo bud nella lista, che servirà per rimuovere la transizione.
 						this->addBudToList(translated_dfa_state, REMOVING_LABEL);
 
@@ -324,7 +496,7 @@ namespace translated_automata {
 												|| parent->getDistance() <= current_distance) {
 
 											// Aggiungo il bud (stato_genitore, label)
-											this->addBudToList(states_map[parent], parent_label);
+											this->addBudToList(states_map[parent->getId()], parent_label);
 										}
 									}
 								}
@@ -339,7 +511,7 @@ namespace translated_automata {
 					// Per tutti gli stati figli raggiunti da transizioni marcate con la label originaria
 					for (StateNFA* child : pair.second) {
 						// Inserisco la transizione tradotta nell'automa DETERMINISTICO D'
-						translated_dfa_state->connectChild(current_label, states_map[child]);
+						translated_dfa_state->connectChild(current_label, states_map[child->getId()]);
 					}
 
 					// Verifico i punti di non determinismo: se gli stati raggiunti dalle transizioni marcate
@@ -354,17 +526,28 @@ namespace translated_automata {
 		}
 
 		// Marco gli stati iniziali
-		this->m_translated_dfa->setInitialState(states_map[this->m_reference_nfa->getInitialState()]);
+		this->m_translated_dfa->setInitialState(states_map[this->m_reference_nfa->getInitialState()->getId()]);
 	}
 
 	/**
 	 * Fornisce un'implementazione della seconda fase dell'algoritmo "Embedded Subset Construction"
 	 * per la traduzione di automi (più specificamente, DFA).
+	 *
+	 * Se è attivo il "wavefront processing", ogni volta che si raggiunge un nuovo strato di bud (ossia
+	 * di bud alla stessa distanza) le l-closure di tutti i bud dello strato vengono calcolate in parallelo.
+	 * I bud vengono comunque estratti ed elaborati uno alla volta e nello stesso ordine della versione
+	 * seriale; una l-closure pre-calcolata viene utilizzata solo se l'estensione dello stato non è stata
+	 * modificata nel frattempo. In questo modo il DFA risultante è identico a quello dell'algoritmo seriale.
 	 */
 	void EmbeddedSubsetConstruction::runBudProcessing() {
 		// Finché la coda dei bud non si svuota
 		while (!this->m_buds->empty()) {
 
+			// Pre-calcolo delle l-closure del nuovo strato
+			if (this->m_active_wavefront_processing && this->m_buds->front()->getState()->getDistance() != this->m_wavefront_distance) {
+				this->runWavefrontPrecomputation();
+			}
+
 			DEBUG_MARK_PHASE( "Nuova iterazione per un nuovo bud" ) {
 
 //			DEBUG_LOG( "Stampa dell'automa finale FINO A QUI:" );
@@ -377,6 +560,8 @@ namespace translated_automata {
 			// Estrazione del primo elemento della coda
 			Bud* current_bud = this->m_buds->pop();
 			DEBUG_LOG( "Estrazione del Bud corrente: %s", current_bud->toString().c_str());
+			TraceLabel trace_label = TRACE_LABEL( current_bud->getLabel() );
+			TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_BUD_POPPED, current_bud->getState(), trace_label, current_bud->getState()->getDistance() );
 
 			// Preparazione dei riferimenti allo stato e alla label
 			ConstructedStateDFA* current_dfa_state = current_bud->getState();
@@ -386,6 +571,8 @@ namespace translated_automata {
 			// (In tal caso, non convien proseguire con il ciclo)
 			if (current_label == EPSILON && this->m_translated_dfa->isInitial(current_dfa_state)) {											/* RULE 0 */
 				DEBUG_LOG( "RULE 0" );
+				TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 0 );
+				PROFILE_SCOPE( this->m_profile, PROF_RULE_0 );
 				// Computazione della epsilon-chiusura
 				ExtensionDFA epsilon_closure = ConstructedStateDFA::computeEpsilonClosure(current_dfa_state->getExtension());
 				// Procedura "Extension Update" sullo stato inziale e sulla sua epsilon-chiusura
@@ -402,13 +589,19 @@ namespace translated_automata {
 
 			DEBUG_LOG("Front distance = %u", front_distance);
 
-			ExtensionDFA l_closure = current_dfa_state->computeLClosureOfExtension(current_label); // Nell'algoritmo è rappresentata con un N in grassetto.
-			string l_closure_name = ConstructedStateDFA::createNameFromExtension(l_closure);
-			DEBUG_LOG("|N| = %s", l_closure_name.c_str());
+			ExtensionDFA l_closure; // Nell'algoritmo è rappresentata con un N in grassetto.
+			if (!this->m_active_wavefront_processing || !this->takePrecomputedLClosure(current_dfa_state, current_label, l_closure)) {
+				l_closure = current_dfa_state->computeLClosureOfExtension(current_label);
+			}
+			// Riferimento all'estensione internata: gli stati con estensione pari alla l-closure vengono riconosciuti tramite questo
+			ExtensionHandle l_closure_handle = ExtensionPool::shared().intern(l_closure);
+			DEBUG_LOG("|N| = %s", ConstructedStateDFA::createNameFromExtension(l_closure).c_str());
 
 			// Se le impostazioni lo prevedono, verifico se l'estensione è vuota
 			if (this->m_active_automaton_pruning && l_closure.empty()) {
 				DEBUG_LOG( "RULE 1" );																								/* RULE 1 */
+				TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 1 );
+				PROFILE_SCOPE( this->m_profile, PROF_RULE_1 );
 				DEBUG_MARK_PHASE("Automaton pruning sul bud %s", current_bud->toString().c_str()) {
 					this->runAutomatonPruning(current_bud);
 				}
@@ -417,11 +610,13 @@ namespace translated_automata {
 			else if (current_exiting_transitions[current_label].empty()) {
 
 				// Se esiste uno stato nel DFA con la stessa estensione
-				if (this->m_translated_dfa->hasState(l_closure_name)) { 																	/* RULE 2 */
+				StateDFA* child = this->getStateWithExtension(l_closure_handle);
+				if (child != NULL) { 																										/* RULE 2 */
 					DEBUG_LOG( "RULE 2" );
+					TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 2 );
+					PROFILE_SCOPE( this->m_profile, PROF_RULE_2 );
 
 					// Aggiunta della transizione dallo stato corrente a quello appena trovato
-					StateDFA* child = this->m_translated_dfa->getState(l_closure_name);
 					current_dfa_state->connectChild(current_label, child);
 					DEBUG_LOG("Creazione della transizione %s --(%s)--> %s",
 							current_dfa_state->getName().c_str(), current_label.c_str(), child->getName().c_str());
@@ -432,12 +627,16 @@ namespace translated_automata {
 				// Se nel DFA non c'è nessuno stato con l'estensione prevista
 				else { 																												/* RULE 3 */
 					DEBUG_LOG( "RULE 3" );
+					TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 3 );
+					PROFILE_SCOPE( this->m_profile, PROF_RULE_3 );
 
 					// Creazione di un nuovo stato StateDFA apposito e collegamento da quello corrente
-					ConstructedStateDFA* new_state = new ConstructedStateDFA(l_closure);
+					ConstructedStateDFA* new_state = new ConstructedStateDFA(l_closure_handle);
 					this->m_translated_dfa->addState(new_state);
+					this->indexExtension(new_state);
 					current_dfa_state->connectChild(current_label, new_state);
 					new_state->setDistance(front_distance + 1);
+					TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_STATE_CREATED, new_state, trace_label, front_distance + 1 );
 
 					// Per ogni transizione uscente dall'estensione, viene creato e aggiunto alla lista un nuovo Bud
 					// Nota: si sta prendendo a riferimento l'NFA associato
@@ -460,7 +659,7 @@ namespace translated_automata {
 					DEBUG_LOG("Considero la transizione:  %s --(%s)--> %s", current_dfa_state->getName().c_str(), current_label.c_str(), child->getName().c_str());
 
 					// Escludo gli stati con estensione diversa da |N|
-					if (child->getName() == l_closure_name) {
+					if (child->hasExtension(l_closure_handle)) {
 						continue;
 					}
 
@@ -480,6 +679,8 @@ namespace translated_automata {
 					// (che sappiamo esistere per certo, per come è stato trovato lo stato child)
 					if (!child_is_initial && child->getIncomingTransitionsCount() == 1) {												/* RULE 4 */
 						DEBUG_LOG( "RULE 4" );
+						TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 4 );
+						PROFILE_SCOPE( this->m_profile, PROF_RULE_4 );
 
 						DEBUG_MARK_PHASE( "Extension Update" ) {
 						// Aggiornamento dell'estensione
@@ -495,11 +696,13 @@ namespace translated_automata {
 //						string l_closure_name = ConstructedStateDFA::createNameFromExtension(l_closure);
 
 						// Se esiste uno stato nel DFA con la stessa estensione
-						if (this->m_translated_dfa->hasState(l_closure_name)) { 																/* RULE 5 */
+						StateDFA* old_child = this->getStateWithExtension(l_closure_handle);
+						if (old_child != NULL) { 																								/* RULE 5 */
 							DEBUG_LOG( "RULE 5" );
+							TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 5 );
+							PROFILE_SCOPE( this->m_profile, PROF_RULE_5 );
 
 							// Ridirezione della transizione dallo stato corrente a quello appena trovato
-							StateDFA* old_child = this->m_translated_dfa->getState(l_closure_name);
 							current_dfa_state->connectChild(current_label, old_child);
 							current_dfa_state->disconnectChild(current_label, child);
 							DEBUG_MARK_PHASE("Distance Relocation su %s, distanza %ul", old_child->getName().c_str(), (front_distance + 1)) {
@@ -510,13 +713,17 @@ namespace translated_automata {
 						// Se nel DFA non c'è nessuno stato con l'estensione prevista
 						else { 																											/* RULE 6 */
 							DEBUG_LOG( "RULE 6" );
+							TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 6 );
+							PROFILE_SCOPE( this->m_profile, PROF_RULE_6 );
 
 							// Creazione di un nuovo stato StateDFA apposito e collegamento da quello corrente
-							ConstructedStateDFA* new_state = new ConstructedStateDFA(l_closure);
+							ConstructedStateDFA* new_state = new ConstructedStateDFA(l_closure_handle);
 							this->m_translated_dfa->addState(new_state);
+							this->indexExtension(new_state);
 							current_dfa_state->connectChild(current_label, new_state);
 							current_dfa_state->disconnectChild(current_label, child);
 							new_state->setDistance(front_distance + 1);
+							TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_STATE_CREATED, new_state, trace_label, front_distance + 1 );
 
 							DEBUG_MARK_PHASE( "Aggiunta di tutte le labels" )
 							// Per ogni transizione uscente dall'estensione, viene creato e aggiunto alla lista un nuovo Bud
@@ -534,6 +741,8 @@ namespace translated_automata {
 					// Altrimenti, se non si verificano le condizioni precedenti
 					else {																												/* RULE 7 */
 						DEBUG_LOG( "RULE 7" );
+						TRACE_EVENT( TRACE_LEVEL_INFO, TRACE_RULE_FIRED, current_dfa_state, trace_label, 7 );
+						PROFILE_SCOPE( this->m_profile, PROF_RULE_7 );
 
 						set<std::pair<ConstructedStateDFA*, string>> transitions_to_remove = set<std::pair<ConstructedStateDFA*, string>>();
 
@@ -560,12 +769,13 @@ namespace translated_automata {
 
 								// Preparazione delle informazioni sullo stato genitore
 								ExtensionDFA parent_x_closure = parent->computeLClosureOfExtension(pair.first);
-								string x_closure_name = ConstructedStateDFA::createNameFromExtension(parent_x_closure);
 
-								DEBUG_LOG("Confronto le due estensioni: %s VS %s", l_closure_name.c_str(), x_closure_name.c_str());
+								DEBUG_LOG("Confronto le due estensioni: %s VS %s",
+										ConstructedStateDFA::createNameFromExtension(l_closure).c_str(),
+										ConstructedStateDFA::createNameFromExtension(parent_x_closure).c_str());
 
 								// Se lo stato genitore ha un'estensione differente dallo stato corrente
-								if (x_closure_name != l_closure_name) {
+								if (parent_x_closure != l_closure) {
 
 									DEBUG_LOG("Le due estensioni sono differenti!");
 									DEBUG_LOG("Al termine, rimuoverò la transizione :  %s --(%s)--> %s", parent->getName().c_str(), pair.first.c_str(), child->getName().c_str());
@@ -608,15 +818,24 @@ namespace translated_automata {
 		// Verifico se è disattivata l'opzione di Automaton Pruning (che evita la creazione di stati vuoti)
 		// e contemporaneamente verifico che siano presenti epsilon-transizioni
 		if (!(this->m_active_automaton_pruning)) {
-			StateDFA* empty_state = this->m_translated_dfa->getState(EMPTY_EXTENSION_NAME);
+			StateDFA* empty_state = this->getStateWithExtension(ExtensionPool::shared().intern(ExtensionDFA()));
 			if (empty_state != NULL) {
 				// Se effettivamente esiste uno stato vuoto, viene eliminato
 				this->m_translated_dfa->removeState(empty_state);
+				this->unindexExtension((ConstructedStateDFA*) empty_state);
 				DEBUG_LOG("Eliminazione dello stato vuoto completata");
 				auto removed_states = this->m_translated_dfa->removeUnreachableStates();
+				for (StateDFA* removed_state : removed_states) {
+					this->unindexExtension((ConstructedStateDFA*) removed_state);
+				}
 				DEBUG_LOG("Ho eliminato %lu stati irraggiungibili", removed_states.size());
 			}
 		}
+
+		// Calcolo dei nomi degli stati, poiché il DFA può sopravvivere all'NFA di riferimento
+		for (int id = 0; id < this->m_translated_dfa->size(); id++) {
+			((ConstructedStateDFA*) this->m_translated_dfa->getStateById(id))->resolveName();
+		}
 	}
 
 	/**
@@ -629,17 +848,256 @@ namespace translated_automata {
 		return this->m_translated_dfa;
 	}
 
+	/**
+	 * Restituisce il profilo dell'ultima esecuzione dell'algoritmo ESC, con il numero di esecuzioni
+	 * e il tempo impiegato da ciascuna regola e procedura interna.
+	 * Il profilo viene popolato solamente se la macro PROFILING_MODE è attiva.
+	 */
+	const ESCProfile& EmbeddedSubsetConstruction::getProfile() {
+		return this->m_profile;
+	}
+
+	/**
+	 * Aggiunge una transizione all'NFA di riferimento dell'ultimo problema di determinizzazione,
+	 * aggiornando in maniera incrementale il DFA risultante.
+	 *
+	 * Si tratta della prima delle operazioni di modifica della "sessione" aperta da runAutomatonCheckup e
+	 * runBudProcessing: il DFA risultante rimane in vita e viene corretto dopo ciascuna modifica, inserendo
+	 * come bud solamente le coppie (stato, label) la cui l-closure può essere cambiata ed eseguendo nuovamente
+	 * la fase "Bud Processing".
+	 * Restituisce FALSE se la transizione era già presente (in tal caso non viene effettuata alcuna operazione).
+	 *
+	 * Nota: il risultato non deve essere stato eliminato; al termine della modifica è lo stesso automa
+	 * restituito da "getResult".
+	 */
+	bool EmbeddedSubsetConstruction::addTransition(StateNFA* from, string label, StateNFA* to) {
+		if (!this->isEditingSessionActive() || from->hasExitingTransition(label, to)) {
+			return false;
+		}
+		this->resetEditingStatus();
+		from->connectChild(label, to);
+
+		// Le epsilon-transizioni ad anello non modificano le epsilon-chiusure
+		if (label == EPSILON && from == to) {
+			return true;
+		}
+
+		if (label == EPSILON) {
+			// Caso EPSILON-TRANSIZIONE:
+			// le estensioni che contengono lo stato di partenza non sono più epsilon-chiuse
+			this->seedEpsilonEditBuds(from);
+		} else {
+			// Caso TRANSIZIONE NORMALE:
+			// cambiano solamente le l-closure (rispetto alla label) delle estensioni che contengono lo stato di partenza
+			for (ConstructedStateDFA* dfa_state : this->getStatesContaining(from)) {
+				this->addBudToList(dfa_state, label);
+			}
+		}
+
+		this->runBudProcessing();
+		return true;
+	}
+
+	/**
+	 * Rimuove una transizione dall'NFA di riferimento dell'ultimo problema di determinizzazione,
+	 * aggiornando in maniera incrementale il DFA risultante.
+	 * Restituisce FALSE se la transizione non era presente (in tal caso non viene effettuata alcuna operazione).
+	 * Si veda "addTransition" per maggiori dettagli.
+	 *
+	 * Nota: la rimozione di una epsilon-transizione non viene gestita in maniera incrementale, ma comporta la
+	 * ricostruzione del DFA a partire dall'NFA modificato (all'interno dello stesso oggetto DFA).
+	 */
+	bool EmbeddedSubsetConstruction::removeTransition(StateNFA* from, string label, StateNFA* to) {
+		if (!this->isEditingSessionActive() || !from->hasExitingTransition(label, to)) {
+			return false;
+		}
+		this->resetEditingStatus();
+		from->disconnectChild(label, to);
+
+		if (label == EPSILON && from == to) {
+			return true;
+		}
+
+		if (label == EPSILON) {
+			// La rimozione di una epsilon-transizione può dividere le estensioni esistenti in più stati,
+			// operazione non prevista dalle regole della fase "Bud Processing": il DFA viene ricostruito
+			this->rebuildEditedResult();
+			return true;
+		}
+
+		for (ConstructedStateDFA* dfa_state : this->getStatesContaining(from)) {
+			this->addBudToList(dfa_state, label);
+		}
+
+		this->runBudProcessing();
+		return true;
+	}
+
+	/**
+	 * Modifica la condizione di stato finale di uno stato dell'NFA di riferimento dell'ultimo problema
+	 * di determinizzazione, aggiornando gli stati del DFA risultante la cui estensione lo contiene.
+	 * Non essendo modificata alcuna transizione, non è necessario eseguire la fase "Bud Processing".
+	 * Restituisce FALSE se lo stato aveva già la condizione richiesta.
+	 */
+	bool EmbeddedSubsetConstruction::setFinal(StateNFA* state, bool final) {
+		if (!this->isEditingSessionActive() || state->isFinal() == final) {
+			return false;
+		}
+		state->setFinal(final);
+
+		for (ConstructedStateDFA* dfa_state : this->getStatesContaining(state)) {
+			dfa_state->setFinal(ConstructedStateDFA::hasFinalStates(dfa_state->getExtension()));
+		}
+		return true;
+	}
+
+	/**
+	 * Rilascia il risultato dell'ultimo problema risolto, che da questo momento appartiene solamente al chiamante.
+	 * Deve essere chiamato prima di eliminare il risultato (o l'NFA di un problema di determinizzazione) se l'oggetto
+	 * ESC continua ad essere utilizzato: chiude la sessione di modifica e impedisce la ri-traduzione incrementale,
+	 * che altrimenti farebbero riferimento ad automi già eliminati.
+	 * Dopo la chiamata "getResult" restituisce NULL e le operazioni di modifica restituiscono FALSE.
+	 */
+	void EmbeddedSubsetConstruction::releaseResult() {
+		this->cleanInternalStatus();
+	}
+
+	/**
+	 * Metodo privato.
+	 * Verifica che sia possibile modificare l'automa dell'ultimo problema risolto, ossia che l'ultimo
+	 * problema sia un problema di determinizzazione di cui è ancora disponibile il risultato.
+	 */
+	bool EmbeddedSubsetConstruction::isEditingSessionActive() {
+		if (this->m_reference_nfa == NULL || this->m_translated_dfa == NULL || this->m_original_dfa != NULL) {
+			DEBUG_LOG_ERROR("Impossibile modificare l'automa senza un precedente problema di determinizzazione");
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Prepara le strutture interne per la nuova esecuzione della fase "Bud Processing" che segue una modifica dell'NFA.
+	 */
+	void EmbeddedSubsetConstruction::resetEditingStatus() {
+		// Le l-closure pre-calcolate non sono più valide, poiché l'NFA viene modificato
+		this->m_wavefront_distance = DEFAULT_VOID_DISTANCE;
+		this->m_precomputed_l_closures.clear();
+		this->m_profile = ESCProfile();
+	}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce il primo stato del DFA risultante (in ordine di identificatore) con l'estensione internata
+	 * passata come parametro, oppure NULL se non esiste.
+	 * Il confronto avviene fra riferimenti tramite l'indice delle estensioni, senza costruire i nomi degli stati
+	 * e senza scorrere gli stati del DFA.
+	 */
+	ConstructedStateDFA* EmbeddedSubsetConstruction::getStateWithExtension(const ExtensionHandle& extension) {
+		auto search = this->m_extension_states.find(extension.get());
+		if (search == this->m_extension_states.end()) {
+			return NULL;
+		}
+		ConstructedStateDFA* first_state = NULL;
+		for (ConstructedStateDFA* dfa_state : search->second) {
+			if (first_state == NULL || dfa_state->getId() < first_state->getId()) {
+				first_state = dfa_state;
+			}
+		}
+		return first_state;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce tutti gli stati del DFA risultante con l'estensione internata passata come parametro,
+	 * in ordine di identificatore.
+	 */
+	vector<ConstructedStateDFA*> EmbeddedSubsetConstruction::getStatesWithExtension(const ExtensionHandle& extension) {
+		auto search = this->m_extension_states.find(extension.get());
+		if (search == this->m_extension_states.end()) {
+			return vector<ConstructedStateDFA*>();
+		}
+		vector<ConstructedStateDFA*> states = search->second;
+		std::sort(states.begin(), states.end(), [](ConstructedStateDFA* lhs, ConstructedStateDFA* rhs) {
+			return lhs->getId() < rhs->getId();
+		});
+		return states;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Gestisce l'aggiunta di una epsilon-transizione uscente da uno stato NFA.
+	 * Le estensioni che contengono lo stato non corrispondono più ad una epsilon-chiusura: per ciascuno di questi
+	 * stati DFA vengono inseriti come bud tutte le transizioni entranti, in modo che la fase "Bud Processing"
+	 * ricalcoli le l-closure dei genitori e corregga l'estensione (tramite le regole 4-7).
+	 * Lo stato iniziale, che può non avere genitori, viene invece aggiornato direttamente.
+	 */
+	void EmbeddedSubsetConstruction::seedEpsilonEditBuds(StateNFA* nfa_state) {
+		for (ConstructedStateDFA* dfa_state : this->getStatesContaining(nfa_state)) {
+			for (auto &pair : dfa_state->getIncomingTransitionsRef()) {
+				for (StateDFA* parent : pair.second) {
+					this->addBudToList((ConstructedStateDFA*) parent, pair.first);
+				}
+			}
+		}
+
+		// Aggiornamento dell'estensione dello stato iniziale
+		ConstructedStateDFA* initial_state = (ConstructedStateDFA*) this->m_translated_dfa->getInitialState();
+		ExtensionDFA initial_extension;
+		initial_extension.insert(this->m_reference_nfa->getInitialState());
+		initial_extension = ConstructedStateDFA::computeEpsilonClosure(initial_extension);
+		if (!initial_state->hasExtension(initial_extension)) {
+			this->runExtensionUpdate(initial_state, initial_extension);
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Ricostruisce il DFA risultante a partire dall'NFA di riferimento modificato, mantenendo lo stesso
+	 * oggetto DFA restituito da "getResult".
+	 * A differenza di una nuova determinizzazione, gli stati NFA non raggiungibili dallo stato iniziale
+	 * vengono esclusi prima della fase "Bud Processing", poiché le modifiche possono renderne irraggiungibili
+	 * alcuni (che altrimenti rimarrebbero nel DFA risultante).
+	 */
+	void EmbeddedSubsetConstruction::rebuildEditedResult() {
+		NFA* nfa = this->m_reference_nfa;
+		DFA* result = this->m_translated_dfa;
+
+		// Eliminazione degli stati del DFA precedente
+		for (StateDFA* state : result->getStatesVector()) {
+			result->removeState(state);
+			delete state;
+		}
+
+		this->runAutomatonCheckup(nfa, result);
+
+		// Eliminazione degli stati irraggiungibili, insieme ai loro bud
+		for (StateDFA* state : result->removeUnreachableStates()) {
+			this->unindexExtension((ConstructedStateDFA*) state);
+			this->m_buds->removeBudsOfState((ConstructedStateDFA*) state);
+			state->detachAllTransitions();
+			delete state;
+		}
+
+		this->runBudProcessing();
+	}
+
 	/**
 	 * Metodo privato.
 	 * Fornisce un'implementazione della procedura "Distance Relocation".
-	 * Modifica la distanza di una sequenza di nodi secondo i valori passati come argomento. La modifica
-	 * viene poi propagata sui figli finché la nuova distanza risulta migliore. La propagazione avviene
-	 * in maniera "width-first".
+	 * Modifica la distanza della sequenza di nodi presente nella coda di rilocazione secondo i valori
+	 * associati a ciascuno di essi. La modifica viene poi propagata sui figli finché la nuova distanza
+	 * risulta migliore. La propagazione avviene in maniera "width-first".
+	 * La coda è un membro della classe, riutilizzato fra le diverse chiamate per evitare allocazioni.
+	 * Al termine, i bud degli stati la cui distanza è stata effettivamente modificata vengono
+	 * riposizionati nella lista di bud, in modo che questa rimanga ordinata.
 	 */
-	void EmbeddedSubsetConstruction::runDistanceRelocation(list<pair<StateDFA*, int>> relocation_sequence) {
-		while (!relocation_sequence.empty()) {
-			auto current = relocation_sequence.front();
-			relocation_sequence.pop_front();
+	void EmbeddedSubsetConstruction::runDistanceRelocation() {
+		PROFILE_SCOPE( this->m_profile, PROF_DISTANCE_RELOCATION );
+		this->m_relocated_states.clear();
+		while (!this->m_relocation_queue.empty()) {
+			auto current = this->m_relocation_queue.pop();
+			PROFILE_COUNT( this->m_profile, relocation_visited_nodes, 1 );
 			StateDFA* current_state = current.first;
 
 			DEBUG_LOG("Esecuzione di \"Distance Relocation\" sullo stato %s", current_state->getName().c_str());
@@ -648,31 +1106,36 @@ namespace translated_automata {
 			if (current_state->getDistance() > current.second) {
 				DEBUG_LOG("La distanza è stata effettivamente ridotta da %u a %u", current_state->getDistance(), current.second);
 				current_state->setDistance(current.second);
+				TRACE_EVENT( TRACE_LEVEL_VERBOSE, TRACE_DISTANCE_RELOCATED, current_state, TRACE_NO_LABEL, current.second );
+				this->m_relocated_states.push_back((ConstructedStateDFA*) current_state);
 
 				// Propago la modifica ai figli
 				for (auto &trans : current_state->getExitingTransitionsRef()) {
 					for (StateDFA* child : trans.second) {
 
 						// Aggiungo il figlio in coda
-						relocation_sequence.push_back(pair<StateDFA*, int>(child, current.second + 1));
+						this->m_relocation_queue.push(pair<StateDFA*, unsigned int>(child, current.second + 1));
 					}
 				}
 			}
 		}
+
+		// Riposizionamento dei bud relativi agli stati modificati
+		if (!this->m_relocated_states.empty()) {
+			this->m_buds->repositionBudsOfStates(this->m_relocated_states);
+		}
 	}
 
 	/**
 	 * Metodo privato.
-	 * Wrapper per la funzione "runDistanceRelocation" che richiede in ingresso una lista di coppie
-	 * (StateDFA*, int). Poiché più di una volta, all'interno dell'algoritmo "Bud Processing", viene
-	 * richiamata la procedura "Distance Relocation" con un singolo argomento, questo metodo fornisce
-	 * un'utile interfaccia per semplificare la costruzione dei parametri della chiamata.
+	 * Wrapper per la funzione "runDistanceRelocation" che opera sulla coda di rilocazione. Poiché più
+	 * di una volta, all'interno dell'algoritmo "Bud Processing", viene richiamata la procedura
+	 * "Distance Relocation" con un singolo argomento, questo metodo fornisce un'utile interfaccia per
+	 * semplificare la costruzione dei parametri della chiamata.
 	 */
-	void EmbeddedSubsetConstruction::runDistanceRelocation(StateDFA* state, int new_distance) {
-		pair<StateDFA*, int> new_pair(state, new_distance);
-		list<pair<StateDFA*, int>> list;
-		list.push_back(new_pair);
-		this->runDistanceRelocation(list);
+	void EmbeddedSubsetConstruction::runDistanceRelocation(StateDFA* state, unsigned int new_distance) {
+		this->m_relocation_queue.push(pair<StateDFA*, unsigned int>(state, new_distance));
+		this->runDistanceRelocation();
 	}
 
 	/**
@@ -681,6 +1144,7 @@ namespace translated_automata {
 	 * stato DFA aggiungendo eventuali stati NFA non presenti.
 	 */
 	void EmbeddedSubsetConstruction::runExtensionUpdate(ConstructedStateDFA* d_state, ExtensionDFA& new_extension) {
+		PROFILE_SCOPE( this->m_profile, PROF_EXTENSION_UPDATE );
 		// Computazione degli stati aggiuntivi dell'update
 		ExtensionDFA difference_states_1 = ConstructedStateDFA::subtractExtensions(new_extension, d_state->getExtension());
 		ExtensionDFA difference_states_2 = ConstructedStateDFA::subtractExtensions(d_state->getExtension(), new_extension);
@@ -712,20 +1176,23 @@ namespace translated_automata {
 
 		DEBUG_LOG("Estensione prima dell'aggiornamento: %s", ConstructedStateDFA::createNameFromExtension(d_state->getExtension()).c_str());
 		// Aggiornamento dell'estensione dello stato DFA
+		this->unindexExtension(d_state);
 		d_state->replaceExtensionWith(new_extension);
+		this->indexExtension(d_state);
+		TRACE_EVENT( TRACE_LEVEL_DEBUG, TRACE_EXTENSION_UPDATED, d_state, TRACE_NO_LABEL, new_extension.size() );
+
+		// Nota: la posizione dei bud nella lista non dipende dall'estensione, quindi non deve essere aggiornata
 		DEBUG_LOG("Estensione dopo l'aggiornamento: %s", ConstructedStateDFA::createNameFromExtension(d_state->getExtension()).c_str());
 
 		// Verifica dell'esistenza di un secondo stato nel DFA che abbia estensione uguale a "new_extension"
-		string new_extension_name = ConstructedStateDFA::createNameFromExtension(new_extension);
-
-		DEBUG_LOG("Verifico se esiste un altro stato in D con estensione pari a : %s", new_extension_name.c_str());
+		DEBUG_LOG("Verifico se esiste un altro stato in D con estensione pari a : %s", d_state->getName().c_str());
 
-		// Estrazione di tutti gli stati con il nome previsto
-		vector<StateDFA*> namesake_states = this->m_translated_dfa->getStatesByName(new_extension_name);
+		// Estrazione di tutti gli stati con la stessa estensione (ossia con lo stesso nome)
+		vector<ConstructedStateDFA*> namesake_states = this->getStatesWithExtension(d_state->getExtensionHandle());
 
 		// Controllo se esiste più di uno stato con la medesima estensione
 		if (namesake_states.size() > 1) {
-			DEBUG_LOG("E' stato trovato più di uno stato con la stessa estensione \"%s\"", new_extension_name.c_str());
+			DEBUG_LOG("E' stato trovato più di uno stato con la stessa estensione \"%s\"", d_state->getName().c_str());
 
 			ConstructedStateDFA* min_dist_state;
 			ConstructedStateDFA* max_dist_state;
@@ -756,6 +1223,8 @@ namespace translated_automata {
 			// Rimozione dello stato dall'automa DFA
 			bool removed = this->m_translated_dfa->removeState(max_dist_state);		// Rimuove il riferimento dello stato
 			DEBUG_ASSERT_TRUE( removed );
+			this->unindexExtension(max_dist_state);
+			TRACE_EVENT( TRACE_LEVEL_DEBUG, TRACE_STATE_REMOVED, max_dist_state, TRACE_NO_LABEL, max_dist_state->getDistance() );
 
 			// All'interno della lista di bud, elimino ogni occorrenza allo stato con distanza massima,
 			// salvando tuttavia le label dei bud che erano presenti.
@@ -770,15 +1239,14 @@ namespace translated_automata {
 
 			// Procedura "Distance Relocation" su tutti i figli dello stato con dist.min, poiché i figli acquisiti dallo stato
 			// con dist.max. devono essere modificati
-			list<pair<StateDFA*, int>> to_be_relocated_list;
+			// (La procedura si occupa anche di riposizionare i bud degli stati modificati, senza riordinare l'intera lista)
 			for (auto &trans : min_dist_state->getExitingTransitionsRef()) {
 				for (StateDFA* child : trans.second) {
 					DEBUG_LOG("Aggiungo alla lista di cui fare la distance_relocation: (%s, %u)", child->getName().c_str(), min_dist_state->getDistance() + 1);
-					to_be_relocated_list.push_back(pair<StateDFA*, int>(child, min_dist_state->getDistance() + 1));
+					this->m_relocation_queue.push(pair<StateDFA*, unsigned int>(child, min_dist_state->getDistance() + 1));
 				}
 			}
-			this->runDistanceRelocation(to_be_relocated_list);
-			this->m_buds->sort();
+			this->runDistanceRelocation();
 
 		}
 	}
@@ -788,15 +1256,163 @@ namespace translated_automata {
 	 * Eventualmente, segnala anche gli errori.
 	 */
 	void EmbeddedSubsetConstruction::addBudToList(ConstructedStateDFA* bud_state, string bud_label) {
-		Bud* new_bud = new Bud(bud_state, bud_label);
-		// Provo ad inserire il bud nella lista
-		if (this->m_buds->insert(new_bud)) {
+		// Provo ad inserire il bud nella lista (in caso di duplicati il bud non viene aggiunto)
+		if (this->m_buds->insert(bud_state, bud_label)) {
 			// Caso in cui non sono presenti bud uguali
-			DEBUG_LOG("Aggiungo alla lista il Bud %s" , new_bud->toString().c_str());
+			DEBUG_LOG("Aggiungo alla lista il Bud (%s, %s)", bud_state->getName().c_str(), bud_label.c_str());
+			TRACE_EVENT( TRACE_LEVEL_VERBOSE, TRACE_BUD_ADDED, bud_state, TRACE_LABEL( bud_label ), bud_state->getDistance() );
 		} else {
 			// Caso in cui esistono bud duplicati
-			DEBUG_LOG("Il Bud %s è già presente nella lista, pertanto non è stato aggiunto" , new_bud->toString().c_str());
-			delete new_bud;
+			DEBUG_LOG("Il Bud (%s, %s) è già presente nella lista, pertanto non è stato aggiunto", bud_state->getName().c_str(), bud_label.c_str());
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Fase parallela del "wavefront processing".
+	 * Calcola le l-closure di tutti i bud che si trovano all'inizio della lista con la
+	 * stessa distanza. Il calcolo accede all'automa in sola lettura, pertanto lo strato può essere suddiviso
+	 * fra i thread del pool senza ulteriore sincronizzazione; ciascun thread scrive solamente nelle proprie posizioni del vettore
+	 * dei risultati, che vengono poi memorizzati serialmente.
+	 */
+	void EmbeddedSubsetConstruction::runWavefrontPrecomputation() {
+		vector<Bud*> layer = this->m_buds->getFrontLayer();
+		this->m_wavefront_distance = layer.front()->getState()->getDistance();
+		this->m_precomputed_l_closures.clear();
+
+		vector<PrecomputedLClosure> results(layer.size());
+		auto compute_range = [&layer, &results](unsigned long int begin, unsigned long int end) {
+			for (unsigned long int i = begin; i < end; i++) {
+				ConstructedStateDFA* state = layer[i]->getState();
+				// Il bud iniziale (con label EPSILON) non necessita della l-closure
+				if (layer[i]->getLabel() == EPSILON) {
+					continue;
+				}
+				results[i].extension_version = state->getExtensionVersion();
+				results[i].l_closure = state->computeLClosureOfExtension(layer[i]->getLabel());
+			}
+		};
+
+		// Suddivisione dello strato fra i thread del pool
+		unsigned long int threads_count = std::min<unsigned long int>(
+				this->m_worker_pool->getWorkersCount() + 1,
+				(layer.size() + WAVEFRONT_MIN_BUDS_PER_THREAD - 1) / WAVEFRONT_MIN_BUDS_PER_THREAD);
+		if (threads_count <= 1) {
+			compute_range(0, layer.size());
+		} else {
+			unsigned long int chunk_size = (layer.size() + threads_count - 1) / threads_count;
+			this->m_worker_pool->run(threads_count, [&layer, &compute_range, chunk_size](unsigned long int chunk) {
+				compute_range(chunk * chunk_size, std::min<unsigned long int>((chunk + 1) * chunk_size, layer.size()));
+			});
+		}
+
+		// Memorizzazione dei risultati
+		for (unsigned long int i = 0; i < layer.size(); i++) {
+			if (layer[i]->getLabel() != EPSILON) {
+				this->m_precomputed_l_closures[{ layer[i]->getState(), layer[i]->getLabel() }] = std::move(results[i]);
+			}
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Recupera la l-closure pre-calcolata per la coppia (stato, label), se presente e ancora valida
+	 * (ossia se l'estensione dello stato non è stata modificata dopo il calcolo).
+	 * In caso positivo, la l-closure viene spostata nel parametro e viene restituito TRUE.
+	 */
+	bool EmbeddedSubsetConstruction::takePrecomputedLClosure(ConstructedStateDFA* state, string label, ExtensionDFA& l_closure) {
+		auto it = this->m_precomputed_l_closures.find({ state, label });
+		if (it == this->m_precomputed_l_closures.end()) {
+			return false;
+		}
+		bool valid = (it->second.extension_version == state->getExtensionVersion());
+		if (valid) {
+			l_closure = std::move(it->second.l_closure);
+		}
+		this->m_precomputed_l_closures.erase(it);
+		return valid;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce tutti gli stati del DFA risultante la cui estensione contiene lo stato NFA passato come parametro.
+	 * Alla prima chiamata costruisce l'indice inverso delle estensioni, che da quel momento viene mantenuto
+	 * aggiornato: le chiamate successive non richiedono di scorrere gli stati del DFA.
+	 */
+	vector<ConstructedStateDFA*> EmbeddedSubsetConstruction::getStatesContaining(StateNFA* nfa_state) {
+		if (!this->m_containing_index_active) {
+			this->buildContainingIndex();
+		}
+		DEBUG_ASSERT_TRUE( nfa_state->getId() < this->m_containing_states.size() );
+		return this->m_containing_states[nfa_state->getId()];
+	}
+
+	/**
+	 * Metodo privato.
+	 * Costruisce l'indice inverso delle estensioni degli stati del DFA risultante, e ne attiva il mantenimento
+	 * durante le successive esecuzioni della fase "Bud Processing".
+	 */
+	void EmbeddedSubsetConstruction::buildContainingIndex() {
+		this->m_containing_states.assign(this->m_reference_nfa->size(), vector<ConstructedStateDFA*>());
+		this->m_containing_index_active = true;
+		for (int id = 0; id < this->m_translated_dfa->size(); id++) {
+			ConstructedStateDFA* state = (ConstructedStateDFA*) this->m_translated_dfa->getStateById(id);
+			for (StateNFA* member : state->getExtension()) {
+				this->m_containing_states[member->getId()].push_back(state);
+			}
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Aggiunge lo stato all'indice delle estensioni internate e, se questo è mantenuto, all'indice inverso
+	 * delle estensioni.
+	 * Deve essere chiamato quando uno stato viene aggiunto al DFA risultante o dopo la modifica della sua estensione.
+	 */
+	void EmbeddedSubsetConstruction::indexExtension(ConstructedStateDFA* state) {
+		this->m_extension_states[&state->getExtension()].push_back(state);
+		if (!this->m_containing_index_active) {
+			return;
+		}
+		for (StateNFA* member : state->getExtension()) {
+			this->m_containing_states[member->getId()].push_back(state);
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Rimuove lo stato dall'indice delle estensioni internate e, se questo è mantenuto, dall'indice inverso
+	 * delle estensioni.
+	 * Deve essere chiamato quando uno stato viene rimosso dal DFA risultante o prima della modifica della sua estensione.
+	 */
+	void EmbeddedSubsetConstruction::unindexExtension(ConstructedStateDFA* state) {
+		auto search = this->m_extension_states.find(&state->getExtension());
+		if (search != this->m_extension_states.end()) {
+			vector<ConstructedStateDFA*>& namesake_states = search->second;
+			for (auto it = namesake_states.begin(); it != namesake_states.end(); it++) {
+				if (*it == state) {
+					*it = namesake_states.back();
+					namesake_states.pop_back();
+					break;
+				}
+			}
+			// L'estensione può essere eliminata dal pool, e il suo indirizzo riutilizzato
+			if (namesake_states.empty()) {
+				this->m_extension_states.erase(search);
+			}
+		}
+		if (!this->m_containing_index_active) {
+			return;
+		}
+		for (StateNFA* member : state->getExtension()) {
+			vector<ConstructedStateDFA*>& containing_states = this->m_containing_states[member->getId()];
+			for (auto it = containing_states.begin(); it != containing_states.end(); it++) {
+				if (*it == state) {
+					*it = containing_states.back();
+					containing_states.pop_back();
+					break;
+				}
+			}
 		}
 	}
 
@@ -808,6 +1424,7 @@ namespace translated_automata {
 	 * @param bud Il bud corrente che ha generato un'estensione |N| vuota; contiene lo stato da cui partire e la label interessata,
 	 */
 	void EmbeddedSubsetConstruction::runAutomatonPruning(Bud* bud) {
+		PROFILE_SCOPE( this->m_profile, PROF_AUTOMATON_PRUNING );
 		// Lista di (potenziali) candidati, ossia coloro che verranno eliminati
 		list<ConstructedStateDFA*> candidates = list<ConstructedStateDFA*>();
 
@@ -881,6 +1498,12 @@ namespace translated_automata {
 								is_possible_entry_point = true;
 							}
 						}
+						// Un genitore candidato può risultare raggiungibile solamente in seguito (ad esempio uno stato
+						// con distanza inferiore raggiunto dalla transizione rimossa, che viene marcato prima di essere
+						// esaminato): anche in questo caso lo stato va ricontrollato fra i possibili entry points
+						else if (parent != current) {
+							is_possible_entry_point = true;
+						}
 					}
 					// Se è raggiunto, è inutile continuare ad iterare
 					if (is_reachable) {
@@ -1021,6 +1644,8 @@ namespace translated_automata {
 				DEBUG_LOG("Rimuovo lo stato %s", candidate->getName().c_str());
 				// Rimuovo lo stato dall'automa (rimuovendo anche le sue transizioni
 				this->m_translated_dfa->removeState(candidate);
+				this->unindexExtension(candidate);
+				TRACE_EVENT( TRACE_LEVEL_DEBUG, TRACE_STATE_REMOVED, candidate, TRACE_NO_LABEL, candidate->getDistance() );
 				// Rimuovo lo stato dalla lista dei bud
 				this->m_buds->removeBudsOfState(candidate);
 			}
@@ -0,0 +1,138 @@
+/*
+ * ExtensionPool.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione dell'insieme condiviso delle estensioni.
+ * Il pool memorizza solamente riferimenti deboli alle estensioni: la loro vita è determinata dagli stati
+ * che le utilizzano. L'accesso è sincronizzato, poiché gli stati possono essere creati e distrutti anche
+ * al di fuori del thread principale.
+ *
+ */
+
+#include "ExtensionPool.hpp"
+
+#include <functional>
+
+namespace translated_automata {
+
+	/**
+	 * Calcola l'hash di una chiave combinando, in ordine, i numeri progressivi dei suoi stati.
+	 */
+	size_t ExtensionPool::Hasher::operator()(const ExtensionKey* key) const {
+		size_t hash = key->size();
+		for (unsigned long int serial : *key) {
+			hash ^= std::hash<unsigned long int>()(serial) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+		}
+		return hash;
+	}
+
+	/**
+	 * Costruttore privato.
+	 */
+	ExtensionPool::ExtensionPool() {}
+
+	/**
+	 * Distruttore.
+	 */
+	ExtensionPool::~ExtensionPool() {}
+
+	/**
+	 * Metodo statico.
+	 * Restituisce il pool condiviso da tutti gli stati.
+	 * Nota: il pool non viene mai distrutto, poiché alcune estensioni possono essere rilasciate
+	 * durante la distruzione degli oggetti statici.
+	 */
+	ExtensionPool& ExtensionPool::shared() {
+		static ExtensionPool* pool = new ExtensionPool();
+		return *pool;
+	}
+
+	/**
+	 * Restituisce il riferimento all'estensione del pool uguale a quella passata come parametro.
+	 * Se non è presente, l'estensione viene copiata all'interno del pool.
+	 */
+	ExtensionHandle ExtensionPool::intern(const ExtensionDFA& extension) {
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		ExtensionHandle handle = this->lookup(extension);
+		if (handle) {
+			return handle;
+		}
+		return this->share(new PooledExtension { extension, std::move(this->m_lookup_key) });
+	}
+
+	/**
+	 * Restituisce il riferimento all'estensione del pool uguale a quella passata come parametro.
+	 * Se non è presente, il contenuto dell'estensione viene spostato all'interno del pool.
+	 */
+	ExtensionHandle ExtensionPool::intern(ExtensionDFA&& extension) {
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		ExtensionHandle handle = this->lookup(extension);
+		if (handle) {
+			return handle;
+		}
+		return this->share(new PooledExtension { std::move(extension), std::move(this->m_lookup_key) });
+	}
+
+	/**
+	 * Metodo privato.
+	 * Calcola la chiave dell'estensione (memorizzandola in "m_lookup_key") e restituisce il riferimento
+	 * all'estensione uguale presente nel pool, oppure un riferimento nullo se non è presente.
+	 * Nota: deve essere chiamato con l'accesso al pool già acquisito.
+	 */
+	ExtensionHandle ExtensionPool::lookup(const ExtensionDFA& extension) {
+		this->m_lookup_key.clear();
+		for (StateNFA* member : extension) {
+			this->m_lookup_key.push_back(member->getSerial());
+		}
+		auto search = this->m_extensions.find(&this->m_lookup_key);
+		if (search != this->m_extensions.end()) {
+			return search->second.lock();
+		}
+		return ExtensionHandle();
+	}
+
+	/**
+	 * Metodo privato.
+	 * Inserisce nel pool una nuova estensione, sostituendo l'eventuale elemento uguale già rilasciato,
+	 * e ne restituisce il riferimento.
+	 * Il riferimento punta all'estensione, ma condivide il conteggio con l'intero elemento del pool
+	 * (estensione e chiave), che viene rilasciato insieme all'ultimo riferimento.
+	 * Nota: deve essere chiamato con l'accesso al pool già acquisito.
+	 */
+	ExtensionHandle ExtensionPool::share(PooledExtension* pooled) {
+		std::shared_ptr<PooledExtension> owner(pooled, [this](PooledExtension* released) {
+			this->release(released);
+		});
+		ExtensionHandle handle(owner, &pooled->extension);
+		this->m_extensions.erase(&pooled->key);
+		this->m_extensions.emplace(&pooled->key, handle);
+		return handle;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Chiamato al rilascio dell'ultimo riferimento ad un'estensione: la rimuove dal pool e la elimina.
+	 * L'elemento del pool viene rimosso solamente se si riferisce ancora a questa estensione, poiché
+	 * nel frattempo un'estensione uguale potrebbe averla sostituita.
+	 */
+	void ExtensionPool::release(PooledExtension* pooled) {
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			auto search = this->m_extensions.find(&pooled->key);
+			if (search != this->m_extensions.end() && search->first == &pooled->key) {
+				this->m_extensions.erase(search);
+			}
+		}
+		delete pooled;
+	}
+
+	/**
+	 * Restituisce il numero di estensioni distinte presenti nel pool.
+	 */
+	unsigned long int ExtensionPool::size() {
+		std::lock_guard<std::mutex> lock(this->m_mutex);
+		return this->m_extensions.size();
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,175 @@
+/*
+ * FlatAutomaton.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione della rappresentazione CSR di un automa.
+ *
+ */
+
+#include "FlatAutomaton.hpp"
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Costruttore.
+	 * Converte un DFA nella rappresentazione CSR.
+	 */
+	FlatAutomaton::FlatAutomaton(DFA* dfa) : m_label_index(dfa->getAlphabet()) {
+		this->build(dfa);
+	}
+
+	/**
+	 * Costruttore.
+	 * Converte un NFA nella rappresentazione CSR; le epsilon-transizioni sono marcate dall'identificatore
+	 * riservato alla label EPSILON.
+	 */
+	FlatAutomaton::FlatAutomaton(NFA* nfa) : m_label_index(nfa->getAlphabet()) {
+		this->build(nfa);
+	}
+
+	/**
+	 * Costruttore.
+	 * Crea un automa con la stessa struttura (stati e transizioni) dell'automa passato come parametro,
+	 * ma con le label specificate. La struttura viene condivisa e non copiata.
+	 */
+	FlatAutomaton::FlatAutomaton(const FlatAutomaton& structure, const LabelIndex& label_index, vector<LabelId>&& labels)
+			: m_label_index(label_index) {
+		DEBUG_ASSERT_TRUE(labels.size() == structure.m_targets->size());
+		this->m_offsets = structure.m_offsets;
+		this->m_targets = structure.m_targets;
+		this->m_final = structure.m_final;
+		this->m_names = structure.m_names;
+		this->m_labels = std::move(labels);
+		this->m_initial_state = structure.m_initial_state;
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	FlatAutomaton::~FlatAutomaton() {}
+
+	/**
+	 * Metodo privato.
+	 * Copia le transizioni dell'automa, stato per stato, nei vettori CSR.
+	 * Gli stati mantengono la numerazione dell'automa: il numero di ciascuno stato è il suo identificatore.
+	 */
+	template <class State>
+	void FlatAutomaton::build(Automaton<State>* automaton) {
+		vector<State*> states = automaton->getStatesVector();
+
+		auto offsets = std::make_shared<vector<uint32_t>>();
+		auto targets = std::make_shared<vector<uint32_t>>();
+		auto final = std::make_shared<vector<uint8_t>>();
+		auto names = std::make_shared<vector<string>>();
+		offsets->reserve(states.size() + 1);
+		final->reserve(states.size());
+		names->reserve(states.size());
+
+		for (State* state : states) {
+			offsets->push_back(targets->size());
+			final->push_back(state->isFinal());
+			names->push_back(state->getName());
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				LabelId label = this->m_label_index.getId(pair.first);
+				for (State* child : pair.second) {
+					targets->push_back(child->getId());
+					this->m_labels.push_back(label);
+				}
+			}
+		}
+		offsets->push_back(targets->size());
+
+		this->m_offsets = offsets;
+		this->m_targets = targets;
+		this->m_final = final;
+		this->m_names = names;
+		State* initial_state = automaton->getInitialState();
+		this->m_initial_state = (initial_state == NULL) ? FLAT_NO_STATE : initial_state->getId();
+	}
+
+	/**
+	 * Restituisce il numero di stati.
+	 */
+	unsigned int FlatAutomaton::size() const {
+		return this->m_final->size();
+	}
+
+	/**
+	 * Restituisce il numero di transizioni.
+	 */
+	unsigned long int FlatAutomaton::getTransitionsCount() const {
+		return this->m_labels.size();
+	}
+
+	/**
+	 * Restituisce la corrispondenza fra label e identificatori utilizzata dall'automa.
+	 */
+	const LabelIndex& FlatAutomaton::getLabelIndex() const {
+		return this->m_label_index;
+	}
+
+	/**
+	 * Restituisce il numero dello stato iniziale, oppure FLAT_NO_STATE se l'automa non ha stato iniziale.
+	 */
+	uint32_t FlatAutomaton::getInitialState() const {
+		return this->m_initial_state;
+	}
+
+	bool FlatAutomaton::isFinal(uint32_t state) const {
+		return (*this->m_final)[state];
+	}
+
+	const string& FlatAutomaton::getName(uint32_t state) const {
+		return (*this->m_names)[state];
+	}
+
+	/**
+	 * Restituisce il vettore degli offset: le transizioni uscenti dallo stato i occupano le posizioni
+	 * comprese nell'intervallo [offsets[i], offsets[i + 1]) dei vettori delle destinazioni e delle label.
+	 */
+	const uint32_t* FlatAutomaton::getOffsets() const {
+		return this->m_offsets->data();
+	}
+
+	const uint32_t* FlatAutomaton::getTargets() const {
+		return this->m_targets->data();
+	}
+
+	const LabelId* FlatAutomaton::getLabels() const {
+		return this->m_labels.data();
+	}
+
+	/**
+	 * Converte l'automa in un NFA, con stati omonimi a quelli dell'automa originale.
+	 * Le transizioni marcate con l'identificatore delle label sconosciute non vengono riportate.
+	 */
+	NFA* FlatAutomaton::toNFA() const {
+		NFA* nfa = new NFA();
+		vector<StateNFA*> states;
+		states.reserve(this->size());
+		for (uint32_t i = 0; i < this->size(); i++) {
+			StateNFA* state = new StateNFA(this->getName(i), this->isFinal(i));
+			states.push_back(state);
+			nfa->addState(state);
+		}
+
+		const uint32_t* offsets = this->getOffsets();
+		const uint32_t* targets = this->getTargets();
+		for (uint32_t i = 0; i < this->size(); i++) {
+			for (uint32_t t = offsets[i]; t < offsets[i + 1]; t++) {
+				if (this->m_labels[t] != this->m_label_index.getUnknownId()) {
+					states[i]->connectChild(this->m_label_index.getLabel(this->m_labels[t]), states[targets[t]]);
+				}
+			}
+		}
+
+		if (this->m_initial_state != FLAT_NO_STATE) {
+			nfa->setInitialState(states[this->m_initial_state]);
+		}
+		return nfa;
+	}
+
+} /* namespace translated_automata */
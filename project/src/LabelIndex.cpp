@@ -0,0 +1,103 @@
+/*
+ * LabelIndex.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione della corrispondenza fra label e identificatori numerici.
+ *
+ */
+
+#include "LabelIndex.hpp"
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Costruttore.
+	 * Assegna gli identificatori alle label secondo l'ordine in cui compaiono nell'alfabeto.
+	 * La label EPSILON e le label duplicate vengono ignorate.
+	 */
+	LabelIndex::LabelIndex(const Alphabet& alphabet) {
+		for (const string& label : alphabet) {
+			if (label == EPSILON || this->m_ids.count(label) > 0) {
+				continue;
+			}
+			this->m_ids[label] = this->m_labels.size();
+			this->m_labels.push_back(label);
+		}
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	LabelIndex::~LabelIndex() {}
+
+	/**
+	 * Restituisce il numero di label dell'alfabeto.
+	 */
+	unsigned int LabelIndex::size() const {
+		return this->m_labels.size();
+	}
+
+	/**
+	 * Restituisce l'identificatore riservato alle label che non appartengono all'alfabeto.
+	 * Corrisponde al numero di label, in modo che gli identificatori validi siano sempre
+	 * compresi nell'intervallo [0, size()].
+	 */
+	LabelId LabelIndex::getUnknownId() const {
+		return this->m_labels.size();
+	}
+
+	/**
+	 * Restituisce l'identificatore riservato alla label EPSILON, successivo a quello delle label sconosciute.
+	 * Le tabelle indicizzate per label possono così riservare una colonna anche alle epsilon-transizioni.
+	 */
+	LabelId LabelIndex::getEpsilonId() const {
+		return this->m_labels.size() + 1;
+	}
+
+	/**
+	 * Restituisce l'identificatore della label, oppure l'identificatore riservato alle
+	 * label sconosciute se la label non appartiene all'alfabeto.
+	 */
+	LabelId LabelIndex::getId(const string& label) const {
+		if (label == EPSILON) {
+			return this->getEpsilonId();
+		}
+		auto search = this->m_ids.find(label);
+		if (search == this->m_ids.end()) {
+			return this->getUnknownId();
+		}
+		return search->second;
+	}
+
+	/**
+	 * Restituisce la label associata all'identificatore.
+	 * All'identificatore delle label sconosciute non corrisponde alcuna label.
+	 */
+	const string& LabelIndex::getLabel(LabelId id) const {
+		static const string epsilon = EPSILON;
+		if (id == this->getEpsilonId()) {
+			return epsilon;
+		}
+		DEBUG_ASSERT_TRUE(id < this->m_labels.size());
+		return this->m_labels[id];
+	}
+
+	/**
+	 * Converte una parola (sequenza di label) nella sequenza dei corrispondenti identificatori.
+	 * Le label EPSILON, che rappresentano la parola vuota, vengono omesse.
+	 */
+	vector<LabelId> LabelIndex::encode(const vector<string>& word) const {
+		vector<LabelId> encoded_word;
+		encoded_word.reserve(word.size());
+		for (const string& label : word) {
+			if (label != EPSILON) {
+				encoded_word.push_back(this->getId(label));
+			}
+		}
+		return encoded_word;
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,367 @@
+/*
+ * LazyDFA.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione del DFA costruito al volo durante il riconoscimento di parole su un NFA.
+ *
+ * Ogni stato in cache è un ConstructedStateDFA, la cui estensione è un'epsilon-chiusura di stati dell'NFA.
+ * Le transizioni già calcolate sono memorizzate come normali transizioni fra gli stati in cache: un passo
+ * di riconoscimento lungo una transizione nota (hit) non richiede alcun calcolo di l-closure.
+ * Quando uno stato viene rimosso dalla cache vengono rimosse anche tutte le sue transizioni, entranti e
+ * uscenti; se necessario, lo stato verrà ricostruito in seguito.
+ *
+ * La memoria occupata dalla cache è stimata sommando, per ciascuno stato, la dimensione dell'oggetto e della
+ * sua estensione (inclusa la porzione del nome), e la dimensione delle sue transizioni uscenti (ciascuna delle
+ * quali è memorizzata sia fra le transizioni uscenti del genitore sia fra quelle entranti del figlio).
+ *
+ */
+
+#include "LazyDFA.hpp"
+
+#include <map>
+#include <new>
+#include <set>
+
+#include "Debug.hpp"
+#include "ExtensionPool.hpp"
+
+// Dimensione stimata di un elemento di un'estensione: nodo dell'insieme ordinato e porzione del nome dello stato
+#define LAZY_DFA_EXTENSION_ENTRY_BYTES	(sizeof(StateNFA*) + 4 * sizeof(void*) + 8)
+// Dimensione stimata di una transizione: nodi delle mappe (uscente ed entrante) con la label e l'insieme di stati
+#define LAZY_DFA_TRANSITION_BYTES		(2 * (sizeof(string) + sizeof(std::set<StateDFA*>) + 4 * sizeof(void*) + sizeof(StateDFA*) + 4 * sizeof(void*)))
+
+namespace translated_automata {
+
+	/**
+	 * Costruttore.
+	 * Il limite di memoria deve permettere di mantenere in cache sia lo stato corrente sia lo stato successivo
+	 * (con la transizione che li collega): se uno stato non può essere inserito in cache, il riconoscimento
+	 * della parola corrente prosegue tramite simulazione diretta dell'NFA.
+	 *
+	 * Nota: l'NFA non deve essere modificato durante l'utilizzo di questo oggetto, altrimenti gli stati in
+	 * cache non sarebbero più validi.
+	 */
+	LazyDFA::LazyDFA(NFA* nfa, unsigned long int budget) {
+		DEBUG_ASSERT_NOT_NULL(nfa);
+		this->m_nfa = nfa;
+		this->m_budget = budget;
+		this->m_used_bytes = 0;
+		this->m_clock_hand = 0;
+		this->m_current_state = NULL;
+		this->m_simulation_active = false;
+		this->m_hits = 0;
+		this->m_misses = 0;
+		this->m_evictions = 0;
+		this->m_fallbacks = 0;
+
+		StateNFA* initial_state = this->m_nfa->getInitialState();
+		if (initial_state == NULL) {
+			DEBUG_LOG_ERROR("L'NFA non ha uno stato iniziale: il linguaggio riconosciuto è vuoto");
+		} else {
+			this->m_initial_extension.insert(initial_state);
+			this->m_initial_extension = ConstructedStateDFA::computeEpsilonClosure(this->m_initial_extension);
+		}
+
+		this->reset();
+	}
+
+	/**
+	 * Distruttore.
+	 * Elimina tutti gli stati in cache; l'NFA di riferimento non viene eliminato.
+	 */
+	LazyDFA::~LazyDFA() {
+		this->clearCache();
+	}
+
+	/**
+	 * Metodo privato statico.
+	 * Restituisce la memoria stimata (in byte) occupata da uno stato in cache con l'estensione passata
+	 * come parametro, escluse le transizioni.
+	 */
+	unsigned long int LazyDFA::estimateStateBytes(const ExtensionDFA& extension) {
+		return sizeof(ConstructedStateDFA) + extension.size() * LAZY_DFA_EXTENSION_ENTRY_BYTES;
+	}
+
+	/**
+	 * Metodo privato statico.
+	 * Restituisce la memoria stimata (in byte) occupata dalle transizioni uscenti dallo stato.
+	 */
+	unsigned long int LazyDFA::estimateTransitionsBytes(StateDFA* state) {
+		unsigned long int transitions = 0;
+		for (auto &pair : state->getExitingTransitionsRef()) {
+			transitions += pair.second.size();
+		}
+		return transitions * LAZY_DFA_TRANSITION_BYTES;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce lo stato in cache avente l'estensione passata come parametro, creandolo se non presente.
+	 * Oltre allo stato, nella cache viene riservato lo spazio per la transizione che lo raggiungerà dallo stato
+	 * corrente (se presente). Se lo spazio non è sufficiente nemmeno dopo aver rimosso tutti gli stati rimovibili,
+	 * viene restituito NULL e la cache non viene modificata.
+	 * In caso di esaurimento della memoria viene lanciata l'eccezione std::bad_alloc.
+	 */
+	ConstructedStateDFA* LazyDFA::getOrCreateState(ExtensionDFA& extension) {
+		unsigned long int transition_bytes = (this->m_current_state != NULL) ? LAZY_DFA_TRANSITION_BYTES : 0;
+		ExtensionHandle handle = ExtensionPool::shared().intern(extension);
+		auto search = this->m_index.find(handle.get());
+		if (search != this->m_index.end()) {
+			ConstructedStateDFA* cached_state = this->m_slots[search->second];
+			cached_state->setMarked(true);
+			if (!this->makeRoom(transition_bytes, cached_state)) {
+				return NULL;
+			}
+			return cached_state;
+		}
+
+		unsigned long int state_bytes = estimateStateBytes(extension);
+		if (!this->makeRoom(state_bytes + transition_bytes, NULL)) {
+			return NULL;
+		}
+
+		unsigned long int slot;
+		if (this->m_free_slots.empty()) {
+			slot = this->m_slots.size();
+			this->m_slots.push_back(NULL);
+		} else {
+			slot = this->m_free_slots.back();
+			this->m_free_slots.pop_back();
+		}
+		ConstructedStateDFA* new_state = new ConstructedStateDFA(handle);
+		new_state->setMarked(true);
+		this->m_slots[slot] = new_state;
+		this->m_index[handle.get()] = slot;
+		this->m_used_bytes += state_bytes;
+		return new_state;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Libera la cache finché non è disponibile lo spazio (in byte) richiesto, scegliendo gli stati da rimuovere
+	 * secondo l'algoritmo "clock": la lancetta scorre gli slot azzerando i bit di riferimento finché non trova
+	 * uno stato non riferito di recente, che viene rimosso. Lo stato corrente e lo stato passato come parametro
+	 * non vengono mai rimossi.
+	 * Restituisce FALSE se lo spazio non è sufficiente anche rimuovendo tutti gli altri stati.
+	 */
+	bool LazyDFA::makeRoom(unsigned long int bytes, ConstructedStateDFA* kept_state) {
+		// Numero di slot esaminati dall'ultima rimozione: dopo due giri completi, tutti gli stati
+		// rimovibili sarebbero già stati rimossi
+		unsigned long int scanned_slots = 0;
+		while (this->m_used_bytes + bytes > this->m_budget) {
+			if (scanned_slots >= 2 * this->m_slots.size()) {
+				return false;
+			}
+			unsigned long int slot = this->m_clock_hand;
+			this->m_clock_hand = (this->m_clock_hand + 1) % this->m_slots.size();
+			scanned_slots++;
+
+			ConstructedStateDFA* candidate = this->m_slots[slot];
+			if (candidate == NULL || candidate == this->m_current_state || candidate == kept_state) {
+				continue;
+			} else if (candidate->isMarked()) {
+				candidate->setMarked(false);
+			} else {
+				this->evictSlot(slot);
+				scanned_slots = 0;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Rimuove dalla cache lo stato contenuto nello slot, eliminando tutte le sue transizioni.
+	 * La memoria liberata comprende anche le transizioni entranti, conteggiate negli stati genitori.
+	 */
+	void LazyDFA::evictSlot(unsigned long int slot) {
+		ConstructedStateDFA* evicted_state = this->m_slots[slot];
+		DEBUG_LOG("Rimozione dalla cache dello stato %s", evicted_state->getName().c_str());
+		unsigned long int freed_bytes = estimateStateBytes(evicted_state->getExtension()) + estimateTransitionsBytes(evicted_state);
+		for (auto &pair : evicted_state->getIncomingTransitionsRef()) {
+			for (StateDFA* parent : pair.second) {
+				if (parent != evicted_state) {
+					freed_bytes += LAZY_DFA_TRANSITION_BYTES;
+				}
+			}
+		}
+		DEBUG_ASSERT_TRUE( freed_bytes <= this->m_used_bytes );
+		this->m_used_bytes -= freed_bytes;
+
+		this->m_index.erase(&evicted_state->getExtension());
+		evicted_state->detachAllTransitions();
+		delete evicted_state;
+		this->m_slots[slot] = NULL;
+		this->m_free_slots.push_back(slot);
+		this->m_evictions++;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Svuota completamente la cache, liberando la memoria occupata dagli stati.
+	 */
+	void LazyDFA::clearCache() {
+		for (ConstructedStateDFA* state : this->m_slots) {
+			if (state != NULL) {
+				state->detachAllTransitions();
+				delete state;
+			}
+		}
+		this->m_slots.clear();
+		this->m_slots.shrink_to_fit();
+		this->m_free_slots.clear();
+		this->m_free_slots.shrink_to_fit();
+		this->m_index.clear();
+		this->m_clock_hand = 0;
+		this->m_current_state = NULL;
+		this->m_used_bytes = 0;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Prosegue il riconoscimento della parola corrente tramite simulazione diretta dell'NFA,
+	 * a partire dall'insieme di stati NFA passato come parametro.
+	 */
+	void LazyDFA::startSimulation(const ExtensionDFA& extension) {
+		this->m_simulation_active = true;
+		this->m_simulated_extension = extension;
+	}
+
+	/**
+	 * Riporta il riconoscimento allo stato iniziale, per iniziare una nuova parola.
+	 * Gli stati in cache vengono mantenuti. Se in precedenza era stata attivata la simulazione
+	 * diretta dell'NFA, viene nuovamente tentato l'utilizzo della cache.
+	 */
+	void LazyDFA::reset() {
+		this->m_simulation_active = false;
+		this->m_current_state = NULL;
+
+		try {
+			this->m_current_state = this->getOrCreateState(this->m_initial_extension);
+			if (this->m_current_state == NULL) {
+				DEBUG_LOG("Lo stato iniziale supera il limite di memoria della cache: passaggio alla simulazione dell'NFA");
+				this->m_fallbacks++;
+				this->startSimulation(this->m_initial_extension);
+			}
+		} catch (std::bad_alloc& e) {
+			DEBUG_LOG_ERROR("Memoria esaurita durante la costruzione dello stato iniziale: passaggio alla simulazione dell'NFA");
+			this->m_fallbacks++;
+			this->clearCache();
+			this->startSimulation(this->m_initial_extension);
+		}
+	}
+
+	/**
+	 * Esegue un passo di riconoscimento leggendo la label passata come parametro.
+	 * Se la transizione dallo stato corrente non è ancora stata calcolata, viene calcolata la l-closure
+	 * dell'estensione corrente e lo stato raggiunto viene cercato (o inserito) nella cache.
+	 * Un'estensione vuota è rappresentata da uno stato (non finale) come le altre, in modo che anche
+	 * le transizioni verso di essa vengano memorizzate.
+	 * La label EPSILON rappresenta la parola vuota, pertanto non modifica lo stato corrente.
+	 */
+	void LazyDFA::step(const string& label) {
+		if (label == EPSILON) {
+			return;
+		}
+
+		// Simulazione diretta dell'NFA
+		if (this->m_simulation_active) {
+			ExtensionDFA l_closure;
+			for (StateNFA* member : this->m_simulated_extension) {
+				for (StateNFA* child : member->getChildren(label)) {
+					l_closure.insert(child);
+				}
+			}
+			this->m_simulated_extension = ConstructedStateDFA::computeEpsilonClosure(l_closure);
+			return;
+		}
+
+		// Transizione già presente in cache
+		auto &transitions = this->m_current_state->getExitingTransitionsRef();
+		auto search = transitions.find(label);
+		if (search != transitions.end() && !search->second.empty()) {
+			this->m_hits++;
+			this->m_current_state = (ConstructedStateDFA*) *(search->second.begin());
+			this->m_current_state->setMarked(true);
+			return;
+		}
+
+		// Costruzione della transizione
+		this->m_misses++;
+		ExtensionDFA l_closure = this->m_current_state->computeLClosureOfExtension(label);
+		try {
+			ConstructedStateDFA* next_state = this->getOrCreateState(l_closure);
+			if (next_state == NULL) {
+				// Lo stato non può essere mantenuto in cache: la parola corrente prosegue con la simulazione,
+				// mentre gli stati in cache restano disponibili per le parole successive
+				DEBUG_LOG("Lo stato raggiunto supera il limite di memoria della cache: passaggio alla simulazione dell'NFA");
+				this->m_fallbacks++;
+				this->startSimulation(l_closure);
+				return;
+			}
+			this->m_current_state->connectChild(label, next_state);
+			this->m_used_bytes += LAZY_DFA_TRANSITION_BYTES;
+			this->m_current_state = next_state;
+		} catch (std::bad_alloc& e) {
+			DEBUG_LOG_ERROR("Memoria esaurita durante la costruzione di uno stato: passaggio alla simulazione dell'NFA");
+			this->m_fallbacks++;
+			this->clearCache();
+			this->startSimulation(l_closure);
+		}
+	}
+
+	/**
+	 * Restituisce TRUE se la parola letta a partire dall'ultimo reset viene accettata.
+	 */
+	bool LazyDFA::isAccepting() {
+		if (this->m_simulation_active) {
+			return ConstructedStateDFA::hasFinalStates(this->m_simulated_extension);
+		}
+		return this->m_current_state->isFinal();
+	}
+
+	/**
+	 * Restituisce TRUE se la parola (intesa come sequenza di label) viene accettata dall'NFA.
+	 */
+	bool LazyDFA::accepts(const vector<string>& word) {
+		this->reset();
+		for (const string& label : word) {
+			this->step(label);
+		}
+		return this->isAccepting();
+	}
+
+	unsigned long int LazyDFA::getBudget() {
+		return this->m_budget;
+	}
+
+	unsigned long int LazyDFA::getUsedBytes() {
+		return this->m_used_bytes;
+	}
+
+	unsigned long int LazyDFA::getCachedStatesCount() {
+		return this->m_index.size();
+	}
+
+	bool LazyDFA::isSimulationActive() {
+		return this->m_simulation_active;
+	}
+
+	unsigned long int LazyDFA::getHitsCount() {
+		return this->m_hits;
+	}
+
+	unsigned long int LazyDFA::getMissesCount() {
+		return this->m_misses;
+	}
+
+	unsigned long int LazyDFA::getEvictionsCount() {
+		return this->m_evictions;
+	}
+
+	unsigned long int LazyDFA::getFallbacksCount() {
+		return this->m_fallbacks;
+	}
+
+} /* namespace translated_automata */
@@ -10,6 +10,11 @@
  * Subset Construction".
  * Si vedano le rispettive classi per informazioni più dettagliate.
  *
+ * Le configurazioni predefinite possono essere modificate senza ricompilare,
+ * tramite file di configurazione e assegnamenti da riga di comando, applicati in ordine:
+ * 	Usage: "algo_esc [-c <file>] [Parametro=Valore] ..."
+ * 	Esempio: "algo_esc -c campaign.ini AutomatonSize=1000..100000:x2 ActiveAutomatonPruning=false"
+ *
  */
 
 #include <iostream>
@@ -33,6 +38,26 @@ int main(int argc, char **argv) {
 		// Creazione delle configurazioni
 		config = new Configurations();
 		config->load();
+
+		// Applicazione dei file di configurazione e degli assegnamenti da riga di comando
+		for (int i = 1; i < argc; i++) {
+			string argument = argv[i];
+			try {
+				if (argument == "-c" || argument == "--config") {
+					if (i + 1 >= argc) {
+						throw "Manca il percorso del file di configurazione";
+					}
+					argument = argv[++i];
+					config->loadFile(argument);
+				} else {
+					config->loadAssignment(argument);
+				}
+			} catch (const char* error) {
+				std::cerr << "Argomento non valido \"" << argument << "\": " << error << std::endl;
+				std::cerr << "Usage: " << argv[0] << " [-c <file>] [Parametro=Valore] ..." << std::endl;
+				return 1;
+			}
+		}
 	}
 
 	do {
@@ -43,7 +68,7 @@ int main(int argc, char **argv) {
 		ProblemSolver solver = ProblemSolver(config);
 
 		// Risoluzione effettiva
-		solver.solveSeries(config->valueOf<int>(Testcases));
+		solver.solveSeries(config->getSnapshot().testcases);
 
 		// Presentazione delle statistiche risultanti
 		solver.getResultCollector()->presentResults();
@@ -0,0 +1,182 @@
+/*
+ * PerformanceCounters.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione della classe "PerformanceCounters", che misura un gruppo di
+ * contatori hardware tramite la system call "perf_event_open" di Linux.
+ *
+ */
+
+#include "PerformanceCounters.hpp"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+#ifdef __linux__
+	// Tipo e configurazione dell'evento perf associato a ciascun contatore, nell'ordine dell'enum HardwareCounter
+	static const struct {
+		unsigned int type;
+		unsigned long long int config;
+	} counter_events[HW_COUNTERS_COUNT] = {
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+			{ PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+			{ PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS }
+	};
+#endif
+
+	/**
+	 * Metodo statico.
+	 * Restituisce il nome del contatore.
+	 */
+	string PerformanceCounters::nameOf(HardwareCounter counter) {
+		switch (counter) {
+		case HW_CYCLES :			return "cycles";
+		case HW_INSTRUCTIONS :		return "instructions";
+		case HW_CACHE_MISSES :		return "cache-misses";
+		case HW_BRANCH_MISSES :		return "branch-misses";
+		case HW_PAGE_FAULTS :		return "page-faults";
+		default :
+			DEBUG_LOG_ERROR("Valore %d non riconosciuto all'interno dell'enumerazione HardwareCounter", counter);
+			return "unknown";
+		}
+	}
+
+	/**
+	 * Costruttore.
+	 * Se le misurazioni sono abilitate, apre il gruppo di contatori per il thread corrente.
+	 */
+	PerformanceCounters::PerformanceCounters(bool enabled) {
+		this->m_enabled = enabled;
+		for (int i = 0; i < HW_COUNTERS_COUNT; i++) {
+			this->m_fds[i] = -1;
+			this->m_group_index[i] = -1;
+		}
+		if (enabled) {
+			this->openCounters();
+		}
+	}
+
+	/**
+	 * Distruttore.
+	 * Chiude i descrittori dei contatori.
+	 */
+	PerformanceCounters::~PerformanceCounters() {
+		this->closeCounters();
+	}
+
+	/**
+	 * Metodo privato.
+	 * Apre i contatori come un unico gruppo, in modo che vengano schedulati congiuntamente.
+	 * Il primo contatore aperto con successo diventa il "leader" del gruppo; i contatori
+	 * non supportati dal sistema vengono semplicemente ignorati.
+	 */
+	void PerformanceCounters::openCounters() {
+#ifdef __linux__
+		for (int i = 0; i < HW_COUNTERS_COUNT; i++) {
+			struct perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = counter_events[i].type;
+			attr.config = counter_events[i].config;
+			attr.disabled = (this->m_group_fd == -1) ? 1 : 0;	// Solo il leader parte disabilitato
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+			int fd = syscall(__NR_perf_event_open, &attr, 0, -1, this->m_group_fd, 0);
+			if (fd == -1) {
+				DEBUG_LOG_FAIL("Impossibile aprire il contatore \"%s\"", nameOf((HardwareCounter) i).c_str());
+				continue;
+			}
+			if (this->m_group_fd == -1) {
+				this->m_group_fd = fd;
+			}
+			this->m_fds[i] = fd;
+			this->m_group_index[i] = this->m_opened_counters++;
+		}
+#endif
+	}
+
+	/**
+	 * Metodo privato.
+	 * Chiude tutti i contatori aperti.
+	 */
+	void PerformanceCounters::closeCounters() {
+#ifdef __linux__
+		for (int i = 0; i < HW_COUNTERS_COUNT; i++) {
+			if (this->m_fds[i] != -1) {
+				close(this->m_fds[i]);
+				this->m_fds[i] = -1;
+			}
+		}
+#endif
+		this->m_group_fd = -1;
+		this->m_opened_counters = 0;
+	}
+
+	/**
+	 * Restituisce TRUE se almeno un contatore è disponibile per le misurazioni.
+	 */
+	bool PerformanceCounters::isAvailable() {
+		return this->m_opened_counters > 0;
+	}
+
+	/**
+	 * Azzera e avvia i contatori del gruppo.
+	 */
+	void PerformanceCounters::start() {
+#ifdef __linux__
+		if (this->m_group_fd != -1) {
+			ioctl(this->m_group_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+			ioctl(this->m_group_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+		}
+#endif
+	}
+
+	/**
+	 * Ferma i contatori del gruppo e restituisce i valori misurati dall'ultima chiamata a "start".
+	 * Nel caso in cui il kernel abbia dovuto condividere i contatori con altri gruppi (multiplexing),
+	 * i valori vengono scalati in proporzione al tempo di effettiva misurazione.
+	 */
+	CounterSample PerformanceCounters::stop() {
+		CounterSample sample;
+#ifdef __linux__
+		if (this->m_group_fd == -1) {
+			return sample;
+		}
+		ioctl(this->m_group_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+		// Formato della lettura: { nr, time_enabled, time_running, values[nr] }
+		unsigned long long int buffer[3 + HW_COUNTERS_COUNT];
+		if (read(this->m_group_fd, buffer, sizeof(buffer)) == -1) {
+			DEBUG_LOG_FAIL("Impossibile leggere i contatori hardware");
+			return sample;
+		}
+		unsigned long long int time_enabled = buffer[1];
+		unsigned long long int time_running = buffer[2];
+		double scale = (time_running > 0 && time_running < time_enabled) ? ((double) time_enabled / time_running) : 1.0;
+
+		for (int i = 0; i < HW_COUNTERS_COUNT; i++) {
+			if (this->m_group_index[i] != -1 && (unsigned long long int) this->m_group_index[i] < buffer[0]) {
+				sample.values[i] = (unsigned long long int) (buffer[3 + this->m_group_index[i]] * scale);
+				sample.valid_mask |= (1U << i);
+			}
+		}
+#endif
+		return sample;
+	}
+
+} /* namespace translated_automata */
@@ -104,12 +104,12 @@ namespace translated_automata {
 
 		// Impostazione dell'alfabeto comune
 		AlphabetGenerator* alphabet_generator = new AlphabetGenerator();
-		alphabet_generator->setCardinality((configurations->valueOf<unsigned int>(AlphabetCardinality)));
+		alphabet_generator->setCardinality(configurations->getSnapshot().alphabet_cardinality);
 		DEBUG_LOG("Cardinalità dell'alfabeto impostata a: %u", alphabet_generator->getCardinality());
 		this->m_alphabet = alphabet_generator->generate();
 		delete alphabet_generator;
 
-		this->m_problem_type = (Problem::ProblemType) configurations->valueOf<int>(ProblemType);
+		this->m_problem_type = (Problem::ProblemType) configurations->getSnapshot().problem_type;
 
 		// Istanzio i generatori delegati
 		switch (this->m_problem_type) {
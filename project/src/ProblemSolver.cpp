@@ -14,6 +14,7 @@
 
 #include "Debug.hpp"
 #include "Properties.hpp"
+#include "Trace.hpp"
 
 namespace translated_automata {
 
@@ -36,6 +37,17 @@ namespace translated_automata {
 				CONCAT( ms_result, _for_counter++ ),									\
 				ms_result = std::chrono::duration_cast<std::chrono::milliseconds>(chrono::high_resolution_clock::now() - CONCAT( ms_result, _start )).count() )
 
+	/**
+	 * Macro function che si occupa di misurare i contatori hardware durante l'esecuzione di un blocco di codice.
+	 * I valori misurati vengono memorizzati nella variabile (di tipo CounterSample) passata come parametro.
+	 * Se i contatori non sono abilitati o disponibili, la variabile conterrà un campione vuoto.
+	 */
+	#define MEASURE_HARDWARE_COUNTERS( sample ) 										\
+		for (	int CONCAT( hw_counters, __LINE__ ) = (this->counters->start(), 0); 	\
+				CONCAT( hw_counters, __LINE__ ) < 1;									\
+				CONCAT( hw_counters, __LINE__ )++,										\
+				sample = this->counters->stop() )
+
 	/**
 	 * Costruttore.
 	 */
@@ -46,6 +58,17 @@ namespace translated_automata {
 
 		this->sc = new SubsetConstruction();
 		this->esc = new EmbeddedSubsetConstruction(configurations);
+
+		const ConfigurationsSnapshot& config = configurations->getSnapshot();
+		this->counters = new PerformanceCounters(config.active_hardware_counters);
+
+		this->cache = NULL;
+		if (config.active_result_cache) {
+			this->cache = new ResultCache(
+					(unsigned long int) config.result_cache_capacity * 1024,
+					config.active_result_cache_spill,
+					DIR_RESULT_CACHE);
+		}
 	}
 
 	/**
@@ -58,6 +81,11 @@ namespace translated_automata {
 			delete this->collector;
 			delete this->sc;
 			delete this->esc;
+			delete this->counters;
+			if (this->cache != NULL) {
+				DEBUG_LOG("Cache dei risultati: %lu hit, %lu miss", this->cache->getHitsCount(), this->cache->getMissesCount());
+				delete this->cache;
+			}
 		}
 	}
 
@@ -73,6 +101,9 @@ namespace translated_automata {
 	 * La risoluzione avviene attraverso due algoritmi:
 	 * - Subset Construction
 	 * - Embedded Subset Construction
+	 * Se la cache dei risultati è attiva, la soluzione SC di un problema già risolto (a meno dei nomi
+	 * degli stati) viene recuperata dalla cache: in tal caso la fase SC non viene misurata, e il risultato
+	 * viene escluso dalle statistiche che dipendono dal tempo di SC (si veda ResultCollector::addResult).
 	 */
 	void ProblemSolver::solve(TranslationProblem* problem) {
 		DEBUG_ASSERT_NOT_NULL(problem);
@@ -81,28 +112,59 @@ namespace translated_automata {
 
 		DEBUG_MARK_PHASE("Subset Construction") {
 
-			// Fase di traduzione
-			NFA* nfa = problem->getTranslation()->translate(problem->getDFA());
+			// Ricerca della soluzione nella cache
+			ResultFingerprint fingerprint;
+			if (this->cache != NULL) {
+				fingerprint = ResultCache::computeFingerprint(problem->getDFA(), problem->getTranslation());
+				result->sc_solution = this->cache->lookup(fingerprint);
+			}
 
-			// Fase di costruzione
-			MEASURE_MILLISECONDS( sc_time ) {
-				result->sc_solution = this->sc->run(nfa); // Chiamata all'algoritmo
+			if (result->sc_solution != NULL) {
+				// Nota: la soluzione ricostruita dalla cache è composta da semplici StateDFA, senza estensioni
+				DEBUG_LOG("Soluzione SC recuperata dalla cache");
+				result->sc_cached = true;
+
+			} else {
+				// Fase di traduzione
+				NFA* nfa = problem->getTranslation()->translate(problem->getDFA());
+
+				// Fase di costruzione
+				MEASURE_MILLISECONDS( sc_time ) {
+					MEASURE_HARDWARE_COUNTERS( result->hw_counters[PHASE_SC_RUN] ) {
+						result->sc_solution = this->sc->run(nfa); // Chiamata all'algoritmo
+					}
+				}
+				result->sc_elapsed_time = sc_time;
+
+				// Memorizzazione della soluzione (finché l'NFA tradotto, a cui fanno riferimento le estensioni, esiste)
+				if (this->cache != NULL) {
+					this->cache->store(fingerprint, result->sc_solution);
+				}
+
+				// L'NFA tradotto non è più necessario
+				delete nfa;
 			}
-			result->sc_elapsed_time = sc_time;
 		}
 
 		DEBUG_MARK_PHASE("Embedded Subset Construction") {
 
 			// Fase di traduzione
-			this->esc->runAutomatonTranslation(problem->getDFA(), problem->getTranslation()); // Chiamata all'algoritmo per la fase di traduzione
+			MEASURE_HARDWARE_COUNTERS( result->hw_counters[PHASE_ESC_TRANSLATION] ) {
+				this->esc->runAutomatonTranslation(problem->getDFA(), problem->getTranslation()); // Chiamata all'algoritmo per la fase di traduzione
+			}
 
 			// Fase di costruzione
 			MEASURE_MILLISECONDS( esc_time ) {
-				this->esc->runBudProcessing(); // Chiamata all'algoritmo per la fase di costruzione
+				MEASURE_HARDWARE_COUNTERS( result->hw_counters[PHASE_ESC_BUD_PROCESSING] ) {
+					this->esc->runBudProcessing(); // Chiamata all'algoritmo per la fase di costruzione
+				}
 			}
 			result->esc_elapsed_time = esc_time;
 
 			result->esc_solution = this->esc->getResult();
+			result->esc_profile = this->esc->getProfile();
+			// Il risultato (e l'NFA del problema) appartengono ora al collector, che può eliminarli
+			this->esc->releaseResult();
 		}
 
 		this->collector->addResult(result);
@@ -123,7 +185,9 @@ namespace translated_automata {
 
 			// Fase di costruzione
 			MEASURE_MILLISECONDS( sc_time ) {
-				result->sc_solution = this->sc->run(problem->getNFA()); // Chiamata all'algoritmo
+				MEASURE_HARDWARE_COUNTERS( result->hw_counters[PHASE_SC_RUN] ) {
+					result->sc_solution = this->sc->run(problem->getNFA()); // Chiamata all'algoritmo
+				}
 			}
 			result->sc_elapsed_time = sc_time;
 		}
@@ -132,12 +196,19 @@ namespace translated_automata {
 
 			// Fase di checkup + costruzione
 			MEASURE_MILLISECONDS( esc_time ) {
-				this->esc->runAutomatonCheckup(problem->getNFA());
-				this->esc->runBudProcessing(); // Chiamata all'algoritmo per la fase di costruzione
+				MEASURE_HARDWARE_COUNTERS( result->hw_counters[PHASE_ESC_CHECKUP] ) {
+					this->esc->runAutomatonCheckup(problem->getNFA());
+				}
+				MEASURE_HARDWARE_COUNTERS( result->hw_counters[PHASE_ESC_BUD_PROCESSING] ) {
+					this->esc->runBudProcessing(); // Chiamata all'algoritmo per la fase di costruzione
+				}
 			}
 			result->esc_elapsed_time = esc_time;
 
 			result->esc_solution = this->esc->getResult();
+			result->esc_profile = this->esc->getProfile();
+			// Il risultato (e l'NFA del problema) appartengono ora al collector, che può eliminarli
+			this->esc->releaseResult();
 		}
 
 		this->collector->addResult(result);
@@ -196,6 +267,9 @@ namespace translated_automata {
 			DEBUG_LOG_SUCCESS("Risolto il problema (%d)!", (i+1));
 		}
 		std::cout << std::endl;
+
+		// Salvataggio della traccia degli eventi (solo se il tracciamento è attivo)
+		TRACE_DUMP( string(DIR_RESULTS) + FILE_NAME_TRACE + FILE_EXTENSION_TRACE );
 		}
 	}
 
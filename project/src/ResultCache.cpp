@@ -0,0 +1,465 @@
+/*
+ * ResultCache.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione della cache delle soluzioni dei problemi di traduzione.
+ *
+ */
+
+#include "ResultCache.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+#include "CompiledTranslation.hpp"
+#include "Debug.hpp"
+#include "FlatAutomaton.hpp"
+#include "Properties.hpp"
+#include "State.hpp"
+
+#define RESULT_CACHE_NO_REF UINT32_MAX		// Riferimento non ancora assegnato (stato o label)
+#define RESULT_CACHE_ENTRY_OVERHEAD 128		// Stima della memoria occupata dalle strutture di un elemento (in byte)
+
+namespace translated_automata {
+
+	using std::ifstream;
+	using std::ofstream;
+
+	/**
+	 * Funzioni ausiliarie per l'hash FNV-1a a 64 bit.
+	 */
+	static inline void hashBytes(uint64_t& hash, const void* data, size_t length) {
+		const unsigned char* bytes = (const unsigned char*) data;
+		for (size_t i = 0; i < length; i++) {
+			hash ^= bytes[i];
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	static inline void hashWord(uint64_t& hash, uint32_t word) {
+		hashBytes(hash, &word, sizeof(word));
+	}
+
+	/**
+	 * Costruttore.
+	 * La capacità è espressa in byte; se il salvataggio su disco è attivo, gli elementi rimossi dalla
+	 * memoria vengono scritti nella cartella specificata.
+	 */
+	ResultCache::ResultCache(unsigned long int capacity, bool spill, string directory) {
+		this->m_capacity = capacity;
+		this->m_spill = spill;
+		this->m_directory = directory;
+	}
+
+	/**
+	 * Distruttore.
+	 * Se il salvataggio su disco è attivo, gli elementi ancora in memoria vengono salvati, in modo
+	 * da poter essere riutilizzati nelle esecuzioni successive.
+	 */
+	ResultCache::~ResultCache() {
+		if (this->m_spill) {
+			for (const Entry& entry : this->m_entries) {
+				this->spill(entry);
+			}
+		}
+	}
+
+	/**
+	 * Metodo statico.
+	 * Calcola l'impronta canonica del problema di traduzione (DFA, traduzione).
+	 * Gli stati raggiungibili sono numerati nell'ordine in cui vengono scoperti da una visita BFS che parte
+	 * dallo stato iniziale e scorre le transizioni di ciascuno stato in ordine di label; le label tradotte
+	 * sono numerate nell'ordine in cui vengono incontrate. Entrambe le numerazioni non dipendono dai nomi
+	 * degli stati, per cui problemi identici a meno dei nomi hanno la stessa impronta.
+	 */
+	ResultFingerprint ResultCache::computeFingerprint(DFA* dfa, Translation* translation) {
+		DEBUG_ASSERT_NOT_NULL(dfa);
+		DEBUG_ASSERT_NOT_NULL(translation);
+		ResultFingerprint fingerprint;
+		FlatAutomaton flat(dfa);
+		CompiledTranslation compiled(translation, flat.getLabelIndex());
+		const LabelIndex& target_index = compiled.getTargetLabelIndex();
+
+		uint32_t initial_state = flat.getInitialState();
+		if (initial_state != FLAT_NO_STATE) {
+			const uint32_t* offsets = flat.getOffsets();
+			const uint32_t* targets = flat.getTargets();
+			const LabelId* labels = flat.getLabels();
+			vector<uint32_t> numbers(flat.size(), RESULT_CACHE_NO_REF);
+			vector<uint32_t> label_refs(target_index.getEpsilonId() + 1, RESULT_CACHE_NO_REF);
+			vector<uint32_t> order;
+			order.reserve(flat.size());
+
+			numbers[initial_state] = 0;
+			order.push_back(initial_state);
+			for (uint32_t current = 0; current < order.size(); current++) {
+				uint32_t state = order[current];
+				fingerprint.names.push_back(flat.getName(state));
+				fingerprint.encoding.push_back(flat.isFinal(state));
+				fingerprint.encoding.push_back(offsets[state + 1] - offsets[state]);
+
+				for (uint32_t t = offsets[state]; t < offsets[state + 1]; t++) {
+					LabelId translated = compiled.translate(labels[t]);
+					if (label_refs[translated] == RESULT_CACHE_NO_REF) {
+						label_refs[translated] = fingerprint.labels.size();
+						fingerprint.labels.push_back(target_index.getLabel(translated));
+					}
+					if (numbers[targets[t]] == RESULT_CACHE_NO_REF) {
+						numbers[targets[t]] = order.size();
+						order.push_back(targets[t]);
+					}
+					fingerprint.encoding.push_back(label_refs[translated]);
+					fingerprint.encoding.push_back(numbers[targets[t]]);
+				}
+			}
+		}
+
+		// Calcolo dell'hash della chiave
+		fingerprint.hash = 14695981039346656037ULL;
+		hashWord(fingerprint.hash, fingerprint.labels.size());
+		for (const string& label : fingerprint.labels) {
+			hashWord(fingerprint.hash, label.size());
+			hashBytes(fingerprint.hash, label.data(), label.size());
+		}
+		hashBytes(fingerprint.hash, fingerprint.encoding.data(), fingerprint.encoding.size() * sizeof(uint32_t));
+		return fingerprint;
+	}
+
+	/**
+	 * Metodo statico privato.
+	 * Verifica che l'elemento corrisponda effettivamente all'impronta, escludendo le collisioni dell'hash.
+	 */
+	bool ResultCache::matches(const Entry& entry, const ResultFingerprint& fingerprint) {
+		return entry.hash == fingerprint.hash
+				&& entry.labels == fingerprint.labels
+				&& entry.encoding == fingerprint.encoding;
+	}
+
+	/**
+	 * Metodo statico privato.
+	 * Stima la memoria occupata da un elemento.
+	 */
+	unsigned long int ResultCache::computeBytes(const Entry& entry) {
+		unsigned long int bytes = sizeof(Entry) + RESULT_CACHE_ENTRY_OVERHEAD;
+		bytes += (entry.encoding.size() + entry.solution.size()) * sizeof(uint32_t);
+		for (const string& label : entry.labels) {
+			bytes += sizeof(string) + label.size();
+		}
+		return bytes;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce il percorso del file su disco associato all'hash.
+	 */
+	string ResultCache::getFilePath(uint64_t hash) {
+		char name[17];
+		snprintf(name, sizeof(name), "%016llx", (unsigned long long int) hash);
+		return this->m_directory + name + FILE_EXTENSION_CACHE;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Inserisce un elemento come più recente, rimuovendo gli elementi meno recenti finché la memoria
+	 * occupata non rientra nella capacità. Un elemento più grande dell'intera capacità non viene mantenuto
+	 * in memoria (ma viene comunque salvato su disco, se previsto).
+	 */
+	void ResultCache::insert(Entry&& entry) {
+		auto search = this->m_index.find(entry.hash);
+		if (search != this->m_index.end()) {
+			this->m_used -= search->second->bytes;
+			this->m_entries.erase(search->second);
+			this->m_index.erase(search);
+		}
+
+		entry.bytes = ResultCache::computeBytes(entry);
+		if (entry.bytes > this->m_capacity) {
+			if (this->m_spill) {
+				this->spill(entry);
+			}
+			return;
+		}
+
+		this->m_used += entry.bytes;
+		this->m_entries.push_front(std::move(entry));
+		this->m_index[this->m_entries.front().hash] = this->m_entries.begin();
+		while (this->m_used > this->m_capacity) {
+			this->evict();
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Rimuove dalla memoria l'elemento utilizzato meno di recente.
+	 */
+	void ResultCache::evict() {
+		DEBUG_ASSERT_FALSE(this->m_entries.empty());
+		const Entry& entry = this->m_entries.back();
+		if (this->m_spill) {
+			this->spill(entry);
+		}
+		this->m_used -= entry.bytes;
+		this->m_index.erase(entry.hash);
+		this->m_entries.pop_back();
+	}
+
+	/**
+	 * Metodo privato.
+	 * Salva un elemento su disco, in un file binario il cui nome è dato dall'hash.
+	 */
+	void ResultCache::spill(const Entry& entry) {
+		std::error_code error;
+		std::filesystem::create_directories(this->m_directory, error);
+		ofstream file(this->getFilePath(entry.hash), std::ios::binary | std::ios::trunc);
+		if (!file) {
+			DEBUG_LOG_ERROR("Impossibile salvare su disco l'elemento %016llx della cache", (unsigned long long int) entry.hash);
+			return;
+		}
+
+		auto write_words = [&file](const vector<uint32_t>& words) {
+			uint64_t size = words.size();
+			file.write((const char*) &size, sizeof(size));
+			file.write((const char*) words.data(), size * sizeof(uint32_t));
+		};
+
+		uint64_t labels_count = entry.labels.size();
+		file.write((const char*) &entry.hash, sizeof(entry.hash));
+		file.write((const char*) &labels_count, sizeof(labels_count));
+		for (const string& label : entry.labels) {
+			uint64_t length = label.size();
+			file.write((const char*) &length, sizeof(length));
+			file.write(label.data(), length);
+		}
+		write_words(entry.encoding);
+		write_words(entry.solution);
+	}
+
+	/**
+	 * Metodo privato.
+	 * Carica da disco l'elemento corrispondente all'impronta, se presente.
+	 * Un file non leggibile, troncato o relativo ad un problema differente viene ignorato.
+	 */
+	bool ResultCache::restore(const ResultFingerprint& fingerprint, Entry& entry) {
+		string path = this->getFilePath(fingerprint.hash);
+		ifstream file(path, std::ios::binary | std::ios::ate);
+		if (!file) {
+			return false;
+		}
+		uint64_t file_size = file.tellg();
+		file.seekg(0);
+
+		auto read_words = [&file, file_size](vector<uint32_t>& words) {
+			uint64_t size = 0;
+			if (!file.read((char*) &size, sizeof(size)) || size * sizeof(uint32_t) > file_size) {
+				return false;
+			}
+			words.resize(size);
+			return (bool) file.read((char*) words.data(), size * sizeof(uint32_t));
+		};
+
+		uint64_t labels_count = 0;
+		if (!file.read((char*) &entry.hash, sizeof(entry.hash))
+				|| !file.read((char*) &labels_count, sizeof(labels_count))
+				|| labels_count > file_size) {
+			return false;
+		}
+		entry.labels.resize(labels_count);
+		for (string& label : entry.labels) {
+			uint64_t length = 0;
+			if (!file.read((char*) &length, sizeof(length)) || length > file_size) {
+				return false;
+			}
+			label.resize(length);
+			if (!file.read(&label[0], length)) {
+				return false;
+			}
+		}
+		if (!read_words(entry.encoding) || !read_words(entry.solution)) {
+			DEBUG_LOG_ERROR("Il file %s della cache è incompleto", path.c_str());
+			return false;
+		}
+		return ResultCache::matches(entry, fingerprint);
+	}
+
+	/**
+	 * Cerca la soluzione del problema identificato dall'impronta, prima in memoria e poi (se previsto) su disco.
+	 * In caso di successo, la soluzione viene ricostruita come un nuovo DFA i cui stati hanno gli stessi nomi
+	 * che avrebbero ottenuto risolvendo il problema corrente; il DFA è di proprietà del chiamante.
+	 * Restituisce NULL se la soluzione non è presente.
+	 *
+	 * Nota: gli stati ricostruiti sono semplici StateDFA e non ConstructedStateDFA come quelli prodotti da
+	 * SubsetConstruction, poiché l'NFA tradotto del problema corrente non viene costruito: il nome di ciascuno
+	 * stato riporta l'estensione, ma questa non è disponibile come insieme di stati NFA.
+	 */
+	DFA* ResultCache::lookup(const ResultFingerprint& fingerprint) {
+		Entry restored;
+		const Entry* entry = NULL;
+
+		auto search = this->m_index.find(fingerprint.hash);
+		if (search != this->m_index.end() && ResultCache::matches(*search->second, fingerprint)) {
+			// Spostamento dell'elemento in testa alla lista (più recente)
+			this->m_entries.splice(this->m_entries.begin(), this->m_entries, search->second);
+			entry = &this->m_entries.front();
+		} else if (this->m_spill && this->restore(fingerprint, restored)) {
+			entry = &restored;
+		} else {
+			this->m_misses++;
+			return NULL;
+		}
+		this->m_hits++;
+
+		// Creazione degli stati, con i nomi ricostruiti a partire dalle estensioni
+		const vector<uint32_t>& solution = entry->solution;
+		uint32_t states_count = solution[0];
+		vector<StateDFA*> states;
+		vector<uint32_t> transitions_positions;
+		states.reserve(states_count);
+		transitions_positions.reserve(states_count);
+		DFA* dfa = new DFA();
+		uint32_t position = 1;
+		for (uint32_t i = 0; i < states_count; i++) {
+			bool final = solution[position++];
+			uint32_t extension_size = solution[position++];
+			vector<const string*> members;
+			members.reserve(extension_size);
+			for (uint32_t m = 0; m < extension_size; m++) {
+				members.push_back(&fingerprint.names[solution[position++]]);
+			}
+			std::sort(members.begin(), members.end(), [](const string* lhs, const string* rhs) {
+				return *lhs < *rhs;
+			});
+
+			string name;
+			if (members.empty()) {
+				name = EMPTY_EXTENSION_NAME;
+			} else {
+				name = "{";
+				for (const string* member : members) {
+					name += *member + ',';
+				}
+				name.back() = '}';
+			}
+
+			StateDFA* state = new StateDFA(name, final);
+			dfa->addState(state);
+			states.push_back(state);
+			transitions_positions.push_back(position);
+			position += 2 * solution[position] + 1;
+		}
+
+		// Creazione delle transizioni
+		for (uint32_t i = 0; i < states_count; i++) {
+			position = transitions_positions[i];
+			uint32_t transitions_count = solution[position++];
+			for (uint32_t t = 0; t < transitions_count; t++, position += 2) {
+				states[i]->connectChild(entry->labels[solution[position]], states[solution[position + 1]]);
+			}
+		}
+		if (states_count > 0) {
+			dfa->setInitialState(states[0]);
+		}
+
+		// Un elemento caricato da disco torna in memoria come più recente
+		if (entry == &restored) {
+			this->insert(std::move(restored));
+		}
+		return dfa;
+	}
+
+	/**
+	 * Memorizza la soluzione del problema identificato dall'impronta.
+	 * La soluzione deve essere stata costruita sull'NFA tradotto del problema (ad esempio da SubsetConstruction),
+	 * in modo che le estensioni dei suoi stati facciano riferimento agli stati omonimi del DFA originale.
+	 * Se la soluzione non può essere ricondotta alla numerazione canonica non viene memorizzata.
+	 * Il DFA non viene modificato e rimane di proprietà del chiamante.
+	 */
+	void ResultCache::store(const ResultFingerprint& fingerprint, DFA* solution) {
+		DEBUG_ASSERT_NOT_NULL(solution);
+		unordered_map<string, uint32_t> numbers;
+		for (uint32_t i = 0; i < fingerprint.names.size(); i++) {
+			numbers[fingerprint.names[i]] = i;
+		}
+		unordered_map<string, uint32_t> label_refs;
+		for (uint32_t i = 0; i < fingerprint.labels.size(); i++) {
+			label_refs[fingerprint.labels[i]] = i;
+		}
+
+		// Numerazione degli stati della soluzione, a partire dallo stato iniziale
+		vector<StateDFA*> states = solution->getStatesVector();
+		StateDFA* initial_state = solution->getInitialState();
+		if (initial_state != NULL) {
+			auto initial_position = std::find(states.begin(), states.end(), initial_state);
+			std::iter_swap(states.begin(), initial_position);
+		}
+		unordered_map<StateDFA*, uint32_t> positions;
+		for (uint32_t i = 0; i < states.size(); i++) {
+			positions[states[i]] = i;
+		}
+
+		Entry entry;
+		entry.hash = fingerprint.hash;
+		entry.labels = fingerprint.labels;
+		entry.encoding = fingerprint.encoding;
+		entry.solution.push_back(states.size());
+		for (StateDFA* state : states) {
+			ConstructedStateDFA* constructed = dynamic_cast<ConstructedStateDFA*>(state);
+			if (constructed == NULL) {
+				DEBUG_LOG_ERROR("Lo stato %s della soluzione non ha un'estensione", state->getName().c_str());
+				return;
+			}
+			entry.solution.push_back(state->isFinal());
+			entry.solution.push_back(constructed->getExtension().size());
+			for (StateNFA* member : constructed->getExtension()) {
+				auto search = numbers.find(member->getName());
+				if (search == numbers.end()) {
+					DEBUG_LOG_ERROR("Lo stato %s dell'estensione non è raggiungibile nel problema", member->getName().c_str());
+					return;
+				}
+				entry.solution.push_back(search->second);
+			}
+
+			uint32_t count_position = entry.solution.size();
+			entry.solution.push_back(0);
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				auto search = label_refs.find(pair.first);
+				if (search == label_refs.end()) {
+					DEBUG_LOG_ERROR("La label %s della soluzione non appartiene alla traduzione", pair.first.c_str());
+					return;
+				}
+				for (StateDFA* child : pair.second) {
+					entry.solution.push_back(search->second);
+					entry.solution.push_back(positions[child]);
+					entry.solution[count_position]++;
+				}
+			}
+		}
+
+		this->insert(std::move(entry));
+	}
+
+	/**
+	 * Restituisce il numero di elementi mantenuti in memoria.
+	 */
+	unsigned long int ResultCache::size() {
+		return this->m_entries.size();
+	}
+
+	/**
+	 * Restituisce la memoria (stimata, in byte) occupata dagli elementi mantenuti in memoria.
+	 */
+	unsigned long int ResultCache::getUsedMemory() {
+		return this->m_used;
+	}
+
+	unsigned long int ResultCache::getHitsCount() {
+		return this->m_hits;
+	}
+
+	unsigned long int ResultCache::getMissesCount() {
+		return this->m_misses;
+	}
+
+} /* namespace translated_automata */
@@ -7,6 +7,7 @@
 #include "ResultCollector.hpp"
 
 #include <fstream>
+#include <functional>
 
 #include "AutomataDrawer_impl.hpp"
 #define DEBUG_MODE
@@ -24,18 +25,108 @@ namespace translated_automata {
 		"EMP_GAIN    [.] "		// Guadagno sperimentale di tempo di ESC rispetto a SC, normalizzato fra -1 e 1
 	};
 
+	// Stringhe per l'identificazione delle statistiche nei file di log
+	vector<string> stat_abbreviations = vector<string> {
+		"SC_TIME",
+		"ESC_TIME",
+		"SOL_SIZE",
+		"SOL_GROWTH",
+		"EMP_GAIN"
+	};
+
+	// Statistiche di cui vengono analizzate le distribuzioni (deviazione standard, percentili, istogrammi)
+	vector<ResultStat> distribution_stats = vector<ResultStat> {
+		SC_TIME,
+		ESC_TIME,
+		SOL_SIZE,
+		EMPIRICAL_GAIN
+	};
+
+	// Percentili calcolati per le statistiche di cui vengono analizzate le distribuzioni
+	vector<double> distribution_percentiles = vector<double> { 0.5, 0.9, 0.99, 0.999 };
+	vector<string> percentile_headlines = vector<string> { "p50", "p90", "p99", "p99.9" };
+
+	// Stringhe per la visualizzazione delle fasi in cui vengono misurati i contatori hardware
+	vector<string> phase_headlines = vector<string> {
+		"SC",
+		"ESC_TRANSL",
+		"ESC_CHECKUP",
+		"ESC_BUDS"
+	};
+
+	// Stringhe per la visualizzazione delle procedure profilate di ESC
+	vector<string> procedure_headlines = vector<string> {
+		"RULE_0",
+		"RULE_1",
+		"RULE_2",
+		"RULE_3",
+		"RULE_4",
+		"RULE_5",
+		"RULE_6",
+		"RULE_7",
+		"PRUNING",
+		"EXT_UPDATE",
+		"DIST_RELOC"
+	};
+
 	/**
 	 * Costruttore.
 	 */
 	ResultCollector::ResultCollector(Configurations* configurations) {
 		this->m_results = list<Result*>();
 		this->m_config_reference = configurations;
+		this->m_config = configurations->getSnapshot();
+
+		// Preparazione degli accumulatori e degli estrattori per ciascuna statistica
+		this->m_stats = vector<StatAccumulator>(RESULT_STATS_COUNT);
+		for (int int_stat = SC_TIME; int_stat < RESULT_STATS_COUNT; int_stat++) {
+			this->m_getters.push_back(this->getStatGetter(static_cast<ResultStat>(int_stat)));
+		}
+
+		// Preparazione degli accumulatori per i contatori hardware
+		this->m_hardware_counters = this->m_config.active_hardware_counters;
+		if (this->m_hardware_counters) {
+			this->m_counter_stats = vector<StatAccumulator>(MEASURED_PHASES_COUNT * HW_COUNTERS_COUNT);
+		}
+
+		// Preparazione degli accumulatori per il profilo di ESC
+		if (IS_PROFILING_ACTIVE) {
+			this->m_profile_calls_stats = vector<StatAccumulator>(PROFILED_PROCEDURES_COUNT);
+			this->m_profile_time_stats = vector<StatAccumulator>(PROFILED_PROCEDURES_COUNT);
+
+			// I profili dei singoli risultati vengono scritti su file man mano che vengono aggiunti,
+			// in modo da poterli correlare con il guadagno empirico senza mantenere i risultati in memoria
+			if (this->m_config.log_statistics) {
+				string profile_headline = "Testcase, SC_TIME, ESC_TIME, EMP_GAIN";
+				for (string headline : procedure_headlines) {
+					profile_headline += ", " + headline + " calls";
+				}
+				for (string headline : procedure_headlines) {
+					profile_headline += ", " + headline + " time [us]";
+				}
+				profile_headline += ", DIST_RELOC nodes";
+				this->m_profile_log = this->openLogFile(FILE_NAME_STATS_PROFILES, profile_headline);
+			}
+		}
+
+		// I risultati vengono mantenuti solo se necessari alla presentazione
+		this->m_retain_results =
+				this->m_config.print_translation ||
+				this->m_config.print_original_automaton ||
+				this->m_config.print_sc_solution ||
+				this->m_config.print_esc_solution ||
+				this->m_config.draw_original_automaton ||
+				this->m_config.draw_sc_solution ||
+				this->m_config.draw_esc_solution;
 	}
 
 	/**
 	 * Distruttore della classe ResultCollector.
+	 * Distrugge tutti i risultati ancora mantenuti in memoria.
 	 */
-	ResultCollector::~ResultCollector() {}
+	ResultCollector::~ResultCollector() {
+		this->reset();
+	}
 
 	/**
 	 * Metodo privato.
@@ -74,7 +165,7 @@ namespace translated_automata {
 
 		// Rapporto fra la dimensione dell'automa ottenuto nella soluzione e la dimensione dell'automa originale.
 		case SOL_GROWTH :
-			aux_size = this->m_config_reference->valueOf<unsigned int>(AutomatonSize);
+			aux_size = this->m_config.automaton_size;
 			getter = [aux_size](Result* result) {
 				return ((double) (result->sc_solution->size()) / aux_size) * 100;
 			};
@@ -110,70 +201,246 @@ namespace translated_automata {
 	}
 
 	/**
-	 * Aggiunge un risultato alla lista.
-	 * Non essendo ordinata, l'aggiunta è effettuata di default in coda.
+	 * Metodo privato.
+	 * Distrugge un risultato, insieme al problema originale e agli automi delle soluzioni.
+	 */
+	void ResultCollector::releaseResult(Result* result) {
+		delete result->original_problem;
+		delete result->sc_solution;
+		delete result->esc_solution;
+		delete result;
+	}
+
+	/**
+	 * Aggiunge un risultato, aggiornando le statistiche aggregate.
+	 * Il risultato viene mantenuto in coda alla lista solo se richiesto dalle configurazioni
+	 * di stampa o disegno; altrimenti viene distrutto immediatamente.
 	 */
 	void ResultCollector::addResult(Result* result) {
 		DEBUG_ASSERT_NOT_NULL(result);
-		if (result != NULL) {
+		if (result == NULL) {
+			return;
+		}
+
+		// Aggiornamento delle statistiche
+		// Se la soluzione SC è stata recuperata dalla cache, il tempo di SC non è stato misurato:
+		// il risultato non contribuisce alle statistiche che ne dipendono, ma viene conteggiato a parte
+		for (int int_stat = SC_TIME; int_stat < RESULT_STATS_COUNT; int_stat++) {
+			if (result->sc_cached && (int_stat == SC_TIME || int_stat == EMPIRICAL_GAIN)) {
+				continue;
+			}
+			this->m_stats[int_stat].add(this->m_getters[int_stat](result));
+		}
+		this->m_test_case_number++;
+		if (result->sc_cached) {
+			this->m_sc_cached_number++;
+		}
+
+		// Aggiornamento dei contatori hardware (solo quelli effettivamente misurati)
+		if (this->m_hardware_counters) {
+			for (int phase = PHASE_SC_RUN; phase < MEASURED_PHASES_COUNT; phase++) {
+				const CounterSample& sample = result->hw_counters[phase];
+				for (int counter = HW_CYCLES; counter < HW_COUNTERS_COUNT; counter++) {
+					if (sample.isValid((HardwareCounter) counter)) {
+						this->m_counter_stats[phase * HW_COUNTERS_COUNT + counter].add(sample.values[counter]);
+					}
+				}
+			}
+		}
+
+		// Aggiornamento del profilo di ESC
+		if (IS_PROFILING_ACTIVE) {
+			for (int procedure = PROF_RULE_0; procedure < PROFILED_PROCEDURES_COUNT; procedure++) {
+				this->m_profile_calls_stats[procedure].add(result->esc_profile.calls[procedure]);
+				this->m_profile_time_stats[procedure].add(result->esc_profile.nanoseconds[procedure] / 1000.0);
+			}
+			this->m_relocation_nodes_stats.add(result->esc_profile.relocation_visited_nodes);
+			if (this->m_profile_log.is_open()) {
+				this->logProfile(result);
+			}
+		}
+
+		if (this->m_retain_results) {
 			this->m_results.push_back(result);
+		} else {
+			this->releaseResult(result);
 		}
 	}
 
+	/**
+	 * Unisce al collettore corrente i risultati di un altro collettore (ad esempio
+	 * relativo ad un differente thread), che viene svuotato.
+	 * Le statistiche aggregate vengono combinate senza che sia necessario riprocessare
+	 * i singoli risultati; gli eventuali risultati mantenuti vengono trasferiti.
+	 */
+	void ResultCollector::mergeWith(ResultCollector& other) {
+		for (int int_stat = SC_TIME; int_stat < RESULT_STATS_COUNT; int_stat++) {
+			this->m_stats[int_stat].merge(other.m_stats[int_stat]);
+		}
+		for (unsigned long int i = 0; i < this->m_counter_stats.size() && i < other.m_counter_stats.size(); i++) {
+			this->m_counter_stats[i].merge(other.m_counter_stats[i]);
+		}
+		for (unsigned long int i = 0; i < this->m_profile_calls_stats.size() && i < other.m_profile_calls_stats.size(); i++) {
+			this->m_profile_calls_stats[i].merge(other.m_profile_calls_stats[i]);
+			this->m_profile_time_stats[i].merge(other.m_profile_time_stats[i]);
+		}
+		this->m_relocation_nodes_stats.merge(other.m_relocation_nodes_stats);
+		this->m_test_case_number += other.m_test_case_number;
+		this->m_sc_cached_number += other.m_sc_cached_number;
+		this->m_results.splice(this->m_results.end(), other.m_results);
+		other.reset();
+	}
+
 	/**
 	 * Rimuove tutti i risultati della lista, chiamandone il distruttore
-	 * per ripulire la memoria.
+	 * per ripulire la memoria, e azzera le statistiche aggregate.
 	 */
 	void ResultCollector::reset() {
-		// TODO Controllare
 		while (!this->m_results.empty()) {
-			delete (this->m_results.back());
+			this->releaseResult(this->m_results.back());
 			this->m_results.pop_back();
 		}
+		for (StatAccumulator& accumulator : this->m_stats) {
+			accumulator.reset();
+		}
+		for (StatAccumulator& accumulator : this->m_counter_stats) {
+			accumulator.reset();
+		}
+		for (StatAccumulator& accumulator : this->m_profile_calls_stats) {
+			accumulator.reset();
+		}
+		for (StatAccumulator& accumulator : this->m_profile_time_stats) {
+			accumulator.reset();
+		}
+		this->m_relocation_nodes_stats.reset();
+		this->m_test_case_number = 0;
+		this->m_sc_cached_number = 0;
 	}
 
 	/**
-	 * Restituisce il numero di testcases attualmente contenuto
-	 * nella lista di risultati.
+	 * Restituisce il numero di testcases aggregati nelle statistiche.
 	 * In caso di chiamata al metodo "reset", questo numero viene azzerato
 	 * e viene persa la memoria dei testcase precedenti.
 	 */
 	unsigned int ResultCollector::getTestCaseNumber() {
-		return this->m_results.size();
+		return this->m_test_case_number;
 	}
 
 	/**
-	 * Restituisce una terna di valori (MIN, AVG, MAX) calcolati secondo una breve
-	 * analisi statistica su tutti i testcases attualmente contenuti nella lista.
-	 * I valori vengono estratti da ciascun risultato in funzione del parametro in
-	 * ingresso.
+	 * Restituisce il numero di testcases la cui soluzione SC è stata recuperata dalla cache dei risultati,
+	 * esclusi dalle statistiche SC_TIME e EMP_GAIN.
+	 */
+	unsigned int ResultCollector::getSCCachedNumber() {
+		return this->m_sc_cached_number;
+	}
+
+	/**
+	 * Restituisce una terna di valori (MIN, AVG, MAX) relativi a tutti i testcases aggregati.
+	 * I valori sono aggiornati ad ogni aggiunta di un risultato, pertanto non è necessario
+	 * scorrere i risultati.
 	 */
 	std::tuple<double, double, double> ResultCollector::getStat(ResultStat stat) {
-		// Inizializzo le variabili
-		double min = 1E20, sum = 0, max = -2;
-		// Preparo la funzione estrattore
-		auto getter = this->getStatGetter(stat);
-		DEBUG_LOG("Ho appena estratto l'estrattore");
-		// Scorro su tutti i risultati
-		for (Result* result : this->m_results) {
-			// Chiamo la funzione estrattore, estraendo la statistica dal risultato
-			double current_value = getter(result);
-			// Aggiorno i valori
-			if (current_value < min) {
-				min = current_value;
-			}
-			sum += current_value;
-			if (current_value > max) {
-				max = current_value;
-			}
+		const StatAccumulator& accumulator = this->m_stats[stat];
+		return std::make_tuple(accumulator.getMin(), accumulator.getMean(), accumulator.getMax());
+	}
+
+	/**
+	 * Restituisce la deviazione standard (campionaria) della statistica richiesta,
+	 * calcolata su tutti i testcases aggregati.
+	 */
+	double ResultCollector::getStandardDeviation(ResultStat stat) {
+		return this->m_stats[stat].getStandardDeviation();
+	}
+
+	/**
+	 * Restituisce una stima del percentile richiesto (espresso come frazione fra 0 e 1)
+	 * per la statistica passata come parametro.
+	 */
+	double ResultCollector::getPercentile(ResultStat stat, double percentile) {
+		return this->m_stats[stat].getQuantile(percentile);
+	}
+
+	/**
+	 * Restituisce l'istogramma della statistica richiesta, suddividendo l'intervallo [MIN, MAX]
+	 * in un numero di intervalli di uguale ampiezza pari al parametro "bins".
+	 * Il numero di valori contenuti in ciascun intervallo è stimato mediante la funzione
+	 * di ripartizione dello sketch associato alla statistica.
+	 */
+	vector<HistogramBin> ResultCollector::getHistogram(ResultStat stat, unsigned int bins) {
+		vector<HistogramBin> histogram;
+		StatAccumulator& accumulator = this->m_stats[stat];
+		if (accumulator.getCount() == 0 || bins == 0) {
+			return histogram;
+		}
+
+		double min = accumulator.getMin();
+		double max = accumulator.getMax();
+		// Se tutti i valori sono uguali, l'istogramma è costituito da un unico intervallo
+		if (min == max) {
+			histogram.push_back({min, max, (double) accumulator.getCount()});
+			return histogram;
 		}
-		// Costruisco e restituisco la tupla
-		return std::make_tuple(min, (sum / this->m_results.size()), max);
+
+		double width = (max - min) / bins;
+		double previous_cdf = 0;
+		for (unsigned int i = 0; i < bins; i++) {
+			double lower_bound = min + i * width;
+			double upper_bound = (i == bins - 1) ? max : (min + (i + 1) * width);
+			double current_cdf = accumulator.getCumulativeDistribution(upper_bound);
+			histogram.push_back({lower_bound, upper_bound, (current_cdf - previous_cdf) * accumulator.getCount()});
+			previous_cdf = current_cdf;
+		}
+		return histogram;
+	}
+
+	/**
+	 * Restituisce una terna di valori (MIN, AVG, MAX) relativi al contatore hardware misurato
+	 * durante la fase richiesta, su tutti i testcases aggregati.
+	 * Se il contatore non è stato misurato, i valori restituiti sono NaN.
+	 */
+	std::tuple<double, double, double> ResultCollector::getHardwareCounterStat(MeasuredPhase phase, HardwareCounter counter) {
+		if (!this->m_hardware_counters) {
+			StatAccumulator empty;
+			return std::make_tuple(empty.getMin(), empty.getMean(), empty.getMax());
+		}
+		const StatAccumulator& accumulator = this->m_counter_stats[phase * HW_COUNTERS_COUNT + counter];
+		return std::make_tuple(accumulator.getMin(), accumulator.getMean(), accumulator.getMax());
+	}
+
+	/**
+	 * Restituisce una terna di valori (MIN, AVG, MAX) relativi al numero di esecuzioni della procedura
+	 * di ESC passata come parametro, su tutti i testcases aggregati.
+	 * Se la profilazione non è attiva, i valori restituiti sono NaN.
+	 */
+	std::tuple<double, double, double> ResultCollector::getProfileCallsStat(ProfiledProcedure procedure) {
+		StatAccumulator accumulator = IS_PROFILING_ACTIVE ? this->m_profile_calls_stats[procedure] : StatAccumulator();
+		return std::make_tuple(accumulator.getMin(), accumulator.getMean(), accumulator.getMax());
+	}
+
+	/**
+	 * Restituisce una terna di valori (MIN, AVG, MAX) relativi al tempo [us] impiegato dalla procedura
+	 * di ESC passata come parametro, su tutti i testcases aggregati.
+	 * Se la profilazione non è attiva, i valori restituiti sono NaN.
+	 */
+	std::tuple<double, double, double> ResultCollector::getProfileTimeStat(ProfiledProcedure procedure) {
+		StatAccumulator accumulator = IS_PROFILING_ACTIVE ? this->m_profile_time_stats[procedure] : StatAccumulator();
+		return std::make_tuple(accumulator.getMin(), accumulator.getMean(), accumulator.getMax());
+	}
+
+	/**
+	 * Restituisce una terna di valori (MIN, AVG, MAX) relativi al numero di nodi visitati durante
+	 * le procedure di Distance Relocation, su tutti i testcases aggregati.
+	 */
+	std::tuple<double, double, double> ResultCollector::getRelocationNodesStat() {
+		const StatAccumulator& accumulator = this->m_relocation_nodes_stats;
+		return std::make_tuple(accumulator.getMin(), accumulator.getMean(), accumulator.getMax());
 	}
 
 	/**
 	 * Restituisce la percentuale di successo dell'algoritmo ESC, confrontato
 	 * sul campione di tutti i testcase disponibili.
+	 * Nota: il confronto richiede gli automi delle soluzioni, pertanto il campione
+	 * comprende solamente i risultati mantenuti in memoria.
 	 */
 	double ResultCollector::getSuccessPercentage() {
 		int correct_result_counter = 0;
@@ -185,6 +452,51 @@ namespace translated_automata {
 		return ((double)(correct_result_counter)) / this->m_results.size();
 	}
 
+	/**
+	 * Metodo privato.
+	 * Apre in modalità "append" il file CSV di log con il nome passato come parametro.
+	 * Se il file non esiste, viene scritta la headline composta dai nomi dei parametri di test
+	 * seguiti dalle colonne specifiche del file.
+	 */
+	ofstream ResultCollector::openLogFile(string file_name, string headline) {
+		string file_path = string(DIR_RESULTS) + file_name + FILE_EXTENSION_CSV;
+		ifstream ifile(file_path);
+		ofstream file_out(file_path, ios::app);
+
+		// Stampa della headline
+		if (! (bool)ifile) {
+			for (int setting = 0; setting < DrawESCSOlution; setting++) {
+				SettingID id = static_cast<SettingID>(setting);
+				if (this->m_config_reference->isTestParam(id)) {
+					file_out << Configurations::nameOf(id) + ", ";
+				}
+			}
+			file_out << headline << std::endl;
+		}
+		return file_out;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Scrive sul file di log dei profili una riga relativa al risultato passato come parametro,
+	 * contenente le statistiche temporali del risultato e il profilo delle procedure di ESC.
+	 */
+	void ResultCollector::logProfile(Result* result) {
+		// I valori non misurati (soluzione SC recuperata dalla cache) vengono lasciati vuoti
+		this->m_profile_log << this->m_config_reference->getValueString()
+							<< this->m_test_case_number << ", "
+							<< (result->sc_cached ? "" : std::to_string(result->sc_elapsed_time)) << ", "
+							<< result->esc_elapsed_time << ", "
+							<< (result->sc_cached ? "" : std::to_string(this->m_getters[EMPIRICAL_GAIN](result)));
+		for (int procedure = PROF_RULE_0; procedure < PROFILED_PROCEDURES_COUNT; procedure++) {
+			this->m_profile_log << ", " << result->esc_profile.calls[procedure];
+		}
+		for (int procedure = PROF_RULE_0; procedure < PROFILED_PROCEDURES_COUNT; procedure++) {
+			this->m_profile_log << ", " << std::to_string(result->esc_profile.nanoseconds[procedure] / 1000.0);
+		}
+		this->m_profile_log << ", " << result->esc_profile.relocation_visited_nodes << std::endl;
+	}
+
 	/**
 	 * Presentazione di un singolo problema e delle sue soluzioni.
 	 * Il contenuto in output dipende dalle impostazioni del programma.
@@ -203,18 +515,18 @@ namespace translated_automata {
 				TranslationProblem* translation_problem = (TranslationProblem*) result->original_problem;
 				DFADrawer dfa_drawer = DFADrawer(translation_problem->getDFA());
 
-				if (this->m_config_reference->valueOf<bool>(PrintTranslation)) {
+				if (this->m_config.print_translation) {
 					std::cout << "TRANSLATION:\n";
 					Alphabet computed_alpha = translation_problem->getDFA()->getAlphabet();
 					std::cout << translation_problem->getTranslation()->toString(computed_alpha);
 				}
 
-				if (this->m_config_reference->valueOf<bool>(PrintOriginalAutomaton)) {
+				if (this->m_config.print_original_automaton) {
 					std::cout << "ORIGINAL DFA:\n";
 					std::cout << dfa_drawer.asString();
 				}
 
-				if (this->m_config_reference->valueOf<bool>(DrawOriginalAutomaton)) {
+				if (this->m_config.draw_original_automaton) {
 					// Stampa su file dell'automa originale
 					string filename = std::string(DIR_RESULTS) + FILE_NAME_ORIGINAL_AUTOMATON + FILE_EXTENSION_GRAPHVIZ;
 					dfa_drawer.asDotFile(filename);
@@ -228,12 +540,12 @@ namespace translated_automata {
 				DeterminizationProblem* determinization_problem = (DeterminizationProblem*) result->original_problem;
 				NFADrawer nfa_drawer = NFADrawer(determinization_problem->getNFA());
 
-				if (this->m_config_reference->valueOf<bool>(PrintOriginalAutomaton)) {
+				if (this->m_config.print_original_automaton) {
 					std::cout << "ORIGINAL NFA:\n";
 					std::cout << nfa_drawer.asString();
 				}
 
-				if (this->m_config_reference->valueOf<bool>(DrawOriginalAutomaton)) {
+				if (this->m_config.draw_original_automaton) {
 					// Stampa su file dell'automa originale
 					string filename = std::string(DIR_RESULTS) + FILE_NAME_ORIGINAL_AUTOMATON + FILE_EXTENSION_GRAPHVIZ;
 					nfa_drawer.asDotFile(filename);
@@ -252,16 +564,17 @@ namespace translated_automata {
 		DEBUG_MARK_PHASE("Presentazione della soluzione ottenuta con SC") {
 			DFADrawer sc_drawer = DFADrawer(result->sc_solution);
 
-			if (this->m_config_reference->valueOf<bool>(PrintSCSolution)) {
+			if (this->m_config.print_sc_solution) {
 				// [SC] Stampa in formato testuale
 				std::cout << "SOLUZIONE di SC:\n";
 				std::cout << std::endl << sc_drawer.asString() << std::endl;
 			}
 
-			if (this->m_config_reference->valueOf<bool>(DrawSCSolution)) {
+			if (this->m_config.draw_sc_solution) {
 				// [SC] Stampa su file
 				string sc_filename = std::string(DIR_RESULTS) + FILE_NAME_SC_SOLUTION + FILE_EXTENSION_GRAPHVIZ;
-				sc_drawer.asDotFile(sc_filename);
+				TableDFA sc_table = TableDFA(result->sc_solution);
+				TableDFADrawer(&sc_table).asDotFile(sc_filename);
 				string sc_command = "dot -Tpdf \"" + sc_filename + "\" -o " + DIR_RESULTS + FILE_NAME_SC_SOLUTION + FILE_EXTENSION_PDF;
 				system(sc_command.c_str());
 			}
@@ -270,16 +583,17 @@ namespace translated_automata {
 		DEBUG_MARK_PHASE("Presentazione della soluzione ottenuta con ESC") {
 			DFADrawer esc_drawer = DFADrawer(result->esc_solution);
 
-			if (this->m_config_reference->valueOf<bool>(PrintESCSOlution)) {
+			if (this->m_config.print_esc_solution) {
 				// [ESC] Stampa in formato testuale
 				std::cout << "SOLUZIONE di ESC:\n";
 				std::cout << std::endl << esc_drawer.asString() << std::endl;
 			}
 
-			if (this->m_config_reference->valueOf<bool>(DrawESCSOlution)) {
+			if (this->m_config.draw_esc_solution) {
 				// [ESC] Stampa su file
 				string esc_filename = std::string(DIR_RESULTS) + FILE_NAME_ESC_SOLUTION + FILE_EXTENSION_GRAPHVIZ;
-				esc_drawer.asDotFile(esc_filename);
+				TableDFA esc_table = TableDFA(result->esc_solution);
+				TableDFADrawer(&esc_table).asDotFile(esc_filename);
 				string esc_command = "dot -Tpdf \"" + esc_filename + "\" -o " + DIR_RESULTS + FILE_NAME_ESC_SOLUTION + FILE_EXTENSION_PDF;
 				system(esc_command.c_str());
 			}
@@ -295,12 +609,16 @@ namespace translated_automata {
 		}
 
 		DEBUG_MARK_PHASE("Presentazione delle statistiche") {
-		if (this->m_config_reference->valueOf<bool>(PrintStatistics)) {
+		if (this->m_config.print_statistics) {
 			printf("STATS:\n");
-			printf("Based on %u testcases with automata of size %d and alphabet of cardinality %d.\n",
+			printf("Based on %u testcases with automata of size %u and alphabet of cardinality %u.\n",
 					this->getTestCaseNumber(),
-					this->m_config_reference->valueOf<int>(AutomatonSize),
-					this->m_config_reference->valueOf<int>(AlphabetCardinality));
+					this->m_config.automaton_size,
+					this->m_config.alphabet_cardinality);
+			if (this->getSCCachedNumber() > 0) {
+				printf("SC solutions of %u testcases taken from the result cache (excluded from SC_TIME and EMP_GAIN).\n",
+						this->getSCCachedNumber());
+			}
 //			printf("ESC success percentage = %f %%\n", (100 * this->getSuccessPercentage()));
 			printf("__________________|    MIN    |    AVG    |    MAX    |\n");
 			for (int int_stat = SC_TIME; int_stat <= EMPIRICAL_GAIN; int_stat++) {
@@ -313,28 +631,59 @@ namespace translated_automata {
 						std::get<1>(stat_values),
 						std::get<2>(stat_values));
 			}
-		}}
-
-		DEBUG_MARK_PHASE("Logging dei risultati aggregati") {
-		if (this->m_config_reference->valueOf<bool>(LogStatistics)) {
+			printf("__________________|  STD DEV  |");
+			for (string headline : percentile_headlines) {
+				printf(" %9s |", headline.c_str());
+			}
+			printf("\n");
+			for (ResultStat stat : distribution_stats) {
+				printf(" %12s | %9.4f |", stat_headlines[stat].c_str(), this->getStandardDeviation(stat));
+				for (double percentile : distribution_percentiles) {
+					printf(" %9.4f |", this->getPercentile(stat, percentile));
+				}
+				printf("\n");
+			}
 
-			// Scrittura su file dei risultati del blocco di testcase
-			string stat_file_name = DIR_RESULTS;
-			stat_file_name += "stats.csv";
-			ifstream ifile(stat_file_name);
-			ofstream file_out(stat_file_name, ios::app);
-
-			// Stampa della headline
-			if (! (bool)ifile) {
-				for (int setting = 0; setting < DrawESCSOlution; setting++) {
-					SettingID id = static_cast<SettingID>(setting);
-					if (this->m_config_reference->isTestParam(id)) {
-						file_out << Configurations::nameOf(id) + ", ";
+			// Contatori hardware: valori medi per ciascuna fase
+			if (this->m_hardware_counters) {
+				printf("HARDWARE COUNTERS (AVG per testcase):\n");
+				printf("_____________|");
+				for (int counter = HW_CYCLES; counter < HW_COUNTERS_COUNT; counter++) {
+					printf(" %14s |", PerformanceCounters::nameOf((HardwareCounter) counter).c_str());
+				}
+				printf("    IPC    |\n");
+				for (int phase = PHASE_SC_RUN; phase < MEASURED_PHASES_COUNT; phase++) {
+					printf(" %11s |", phase_headlines[phase].c_str());
+					for (int counter = HW_CYCLES; counter < HW_COUNTERS_COUNT; counter++) {
+						printf(" %14.1f |", std::get<1>(this->getHardwareCounterStat((MeasuredPhase) phase, (HardwareCounter) counter)));
 					}
+					double cycles = std::get<1>(this->getHardwareCounterStat((MeasuredPhase) phase, HW_CYCLES));
+					double instructions = std::get<1>(this->getHardwareCounterStat((MeasuredPhase) phase, HW_INSTRUCTIONS));
+					printf(" %9.4f |\n", instructions / cycles);
 				}
-				file_out << "SC min, SC avg, SC max, ESC min, ESC avg, ESC max" << std::endl;
 			}
 
+			// Profilo delle procedure di ESC: numero di esecuzioni e tempo medi per ciascuna procedura
+			if (IS_PROFILING_ACTIVE) {
+				printf("ESC PROFILE (AVG per testcase):\n");
+				printf("_____________|   CALLS   | TIME [us] |\n");
+				for (int procedure = PROF_RULE_0; procedure < PROFILED_PROCEDURES_COUNT; procedure++) {
+					printf(" %11s | %9.2f | %9.2f |\n",
+							procedure_headlines[procedure].c_str(),
+							std::get<1>(this->getProfileCallsStat((ProfiledProcedure) procedure)),
+							std::get<1>(this->getProfileTimeStat((ProfiledProcedure) procedure)));
+				}
+				printf("Nodes visited by Distance Relocation: %.2f (AVG), %.0f (MAX)\n",
+						std::get<1>(this->getRelocationNodesStat()),
+						std::get<2>(this->getRelocationNodesStat()));
+			}
+		}}
+
+		DEBUG_MARK_PHASE("Logging dei risultati aggregati") {
+		if (this->m_config.log_statistics) {
+
+			// Scrittura su file dei risultati del blocco di testcase
+			ofstream file_out = this->openLogFile(FILE_NAME_STATS, "SC min, SC avg, SC max, ESC min, ESC avg, ESC max");
 			file_out << this->m_config_reference->getValueString();
 
 			// Stampo i risultati
@@ -353,6 +702,59 @@ namespace translated_automata {
 			file_out << std::endl;
 			file_out.close();
 
+			// Scrittura su file delle distribuzioni: per ogni statistica, deviazione standard e percentili
+			string distribution_headline = "Testcases";
+			for (ResultStat stat : distribution_stats) {
+				distribution_headline += ", " + stat_abbreviations[stat] + " stddev";
+				for (string headline : percentile_headlines) {
+					distribution_headline += ", " + stat_abbreviations[stat] + " " + headline;
+				}
+			}
+			ofstream distribution_out = this->openLogFile(FILE_NAME_STATS_DISTRIBUTION, distribution_headline);
+			distribution_out << this->m_config_reference->getValueString() << this->getTestCaseNumber();
+			for (ResultStat stat : distribution_stats) {
+				distribution_out << ", " << std::to_string(this->getStandardDeviation(stat));
+				for (double percentile : distribution_percentiles) {
+					distribution_out << ", " << std::to_string(this->getPercentile(stat, percentile));
+				}
+			}
+			distribution_out << std::endl;
+			distribution_out.close();
+
+			// Scrittura su file degli istogrammi: una riga per ciascun intervallo di ciascuna statistica
+			ofstream histograms_out = this->openLogFile(FILE_NAME_STATS_HISTOGRAMS, "Stat, Bin, Lower bound, Upper bound, Count");
+			for (ResultStat stat : distribution_stats) {
+				vector<HistogramBin> histogram = this->getHistogram(stat);
+				for (unsigned long int bin = 0; bin < histogram.size(); bin++) {
+					histograms_out 	<< this->m_config_reference->getValueString()
+									<< stat_abbreviations[stat] << ", "
+									<< bin << ", "
+									<< std::to_string(histogram[bin].lower_bound) << ", "
+									<< std::to_string(histogram[bin].upper_bound) << ", "
+									<< std::to_string(histogram[bin].count) << std::endl;
+				}
+			}
+			histograms_out.close();
+
+			// Scrittura su file dei contatori hardware: valore medio per ciascuna fase e ciascun contatore
+			if (this->m_hardware_counters) {
+				string counters_headline = "Testcases";
+				for (int phase = PHASE_SC_RUN; phase < MEASURED_PHASES_COUNT; phase++) {
+					for (int counter = HW_CYCLES; counter < HW_COUNTERS_COUNT; counter++) {
+						counters_headline += ", " + phase_headlines[phase] + " " + PerformanceCounters::nameOf((HardwareCounter) counter);
+					}
+				}
+				ofstream counters_out = this->openLogFile(FILE_NAME_STATS_COUNTERS, counters_headline);
+				counters_out << this->m_config_reference->getValueString() << this->getTestCaseNumber();
+				for (int phase = PHASE_SC_RUN; phase < MEASURED_PHASES_COUNT; phase++) {
+					for (int counter = HW_CYCLES; counter < HW_COUNTERS_COUNT; counter++) {
+						counters_out << ", " << std::to_string(std::get<1>(this->getHardwareCounterStat((MeasuredPhase) phase, (HardwareCounter) counter)));
+					}
+				}
+				counters_out << std::endl;
+				counters_out.close();
+			}
+
 		}}
 	}
 
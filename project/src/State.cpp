@@ -14,12 +14,14 @@
 
 #include "State.hpp"
 
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
 #include <string>
 
 #include "Alphabet.hpp"
+#include "ExtensionPool.hpp"
 //#define DEBUG_MODE
 #include "Debug.hpp"
 
@@ -37,12 +39,10 @@ namespace translated_automata {
 
 	/**
 	 * Costruttore della classe State.
-	 * Inizializza come vuoti gli insiemi di transizioni entranti e uscenti.
+	 * Gli insiemi di transizioni entranti e uscenti sono inizialmente vuoti.
 	 */
 	template <class S>
 	State<S>::State () {
-		this->m_exiting_transitions = map<string, set<S*>>();
-		this->m_incoming_transitions = map<string, set<S*>>();
 		DEBUG_LOG( "Nuovo oggetto State creato correttamente" );
 	}
 
@@ -66,12 +66,46 @@ namespace translated_automata {
 
 	/**
 	 * Restituisce il nome dello stato.
+	 * Se il nome non è ancora stato calcolato, viene calcolato e memorizzato.
 	 */
 	template <class S>
 	string State<S>::getName() const {
+		if (m_name_pending) {
+			m_name = this->computeName();
+			m_name_pending = false;
+		}
 		return m_name;
 	}
 
+	/**
+	 * Metodo protetto.
+	 * Calcola il nome dello stato, per le sottoclassi che lo determinano solamente quando viene richiesto.
+	 */
+	template <class S>
+	string State<S>::computeName() const {
+		return m_name;
+	}
+
+	/**
+	 * Restituisce l'identificatore dello stato all'interno dell'automa che lo contiene, compreso fra 0 e n-1
+	 * (dove n è la dimensione dell'automa), oppure STATE_NO_ID se lo stato non appartiene ad alcun automa.
+	 * L'identificatore può essere utilizzato per indicizzare strutture ausiliarie in forma di vettore.
+	 */
+	template <class S>
+	unsigned int State<S>::getId() const {
+		return m_id;
+	}
+
+	/**
+	 * Verifica se lo stato mantiene l'indice delle transizioni entranti.
+	 * In caso contrario, i metodi relativi alle transizioni entranti (e ai genitori) non restituiscono
+	 * risultati significativi finché l'automa che contiene lo stato non ricostruisce l'indice.
+	 */
+	template <class S>
+	bool State<S>::hasIncomingIndex() const {
+		return m_incoming_indexed;
+	}
+
 	/**
 	 * Restituisce TRUE se lo stato è marcato come stato finale.
 	 */
@@ -96,37 +130,10 @@ namespace translated_automata {
 	 */
 	template <class S>
 	void State<S>::connectChild(string label, S* child)	{
-		bool flag_new_insertion = false;
-		// Verifico se la label ha già un set associato nello stato CORRENTE.
-		// In caso il set non ci sia, viene creato
-		if (this->m_exiting_transitions.count(label) == 0) {
-			this->m_exiting_transitions.insert({label, set<S*>()});
-			flag_new_insertion = true;
-		}
-
-		// Verifico se la label ha già un set associato nello stato FIGLIO
-		// In caso il set non ci sia, viene creato
-		if (child->m_incoming_transitions.count(label) == 0) {
-			child->m_incoming_transitions.insert({label, set<S*>()});
-			flag_new_insertion = true;
-		}
-
-//		// FIXME Migliorare l'implementazione
-//		bool flag_found = false;
-//		for (auto iterator = this->m_exiting_transitions[label].begin();
-//				!flag_new_insertion && iterator != this->m_exiting_transitions[label].end();
-//				iterator++) {
-//			if ((*iterator)->getName() == child->getName()) {
-//				flag_found = true;
-//			}
-//		}
-
-		// Se la label è un nuovo inserimento || Se per tale label, lo stato non è ancora presente
-//		if (flag_new_insertion || !flag_found) {
-		if (flag_new_insertion || !this->hasExitingTransition(label, child)) {
-			// Aggiungo una transizione uscente da questo stato
-			this->m_exiting_transitions[label].insert(child);
-			// Aggiungo una transizione entrante allo stato di arrivo
+		// Aggiungo una transizione uscente da questo stato (l'insieme associato alla label viene creato se non presente).
+		// Se il figlio era già presente, anche la transizione entrante esiste già.
+		if (this->m_exiting_transitions[label].insert(child) && child->m_incoming_indexed) {
+			// Aggiungo una transizione entrante allo stato di arrivo, se questo mantiene l'indice
 			child->m_incoming_transitions[label].insert(getThis());
 		}
 	}
@@ -140,13 +147,16 @@ namespace translated_automata {
 	template <class S>
 	void State<S>::disconnectChild(string label, S* child) {
 		// Ricerca del figlio da disconnettere
-		auto iterator = this->m_exiting_transitions[label].find(child);
+		TargetSet<S>& children = this->m_exiting_transitions[label];
+		auto iterator = children.find(child);
 
-		if (iterator != this->m_exiting_transitions[label].end()) {
+		if (iterator != children.end()) {
 			DEBUG_ASSERT_TRUE(this->hasExitingTransition(label, child));
-			this->m_exiting_transitions[label].erase(iterator);
+			children.erase(iterator);
 			DEBUG_ASSERT_FALSE(this->hasExitingTransition(label, child));
-			child->m_incoming_transitions[label].erase(getThis());
+			if (child->m_incoming_indexed) {
+				child->m_incoming_transitions[label].erase(getThis());
+			}
 		} else {
 			DEBUG_LOG_FAIL("NN TROVATO");
 		}
@@ -157,28 +167,33 @@ namespace translated_automata {
 	 * da questo stato.
 	 * Le transizioni vengono aggiornate anche sui nodi che
 	 * risultavano precedentemente connessi.
+	 * Nota: la disconnessione modifica gli insiemi su cui si itera, pertanto ciascun insieme viene
+	 * prima copiato (le label non vengono invece rimosse, quindi la loro posizione rimane valida).
+	 * Nota: se lo stato non mantiene le transizioni entranti, vengono rimosse solamente quelle uscenti.
 	 */
 	template <class S>
 	void State<S>::detachAllTransitions() {
 		// Rimuove le transizioni uscenti
-		for (auto pair_it = m_exiting_transitions.begin(); pair_it != m_exiting_transitions.end(); pair_it++) {
-			string label = pair_it->first;
-			for (auto child_it = pair_it->second.begin(); child_it != pair_it->second.end(); ) {
-				getThis()->disconnectChild(label, *(child_it++));
+		for (unsigned long int i = 0; i < m_exiting_transitions.size(); i++) {
+			string label = m_exiting_transitions.begin()[i].first;
+			TargetSet<S> children = m_exiting_transitions.begin()[i].second;
+			for (S* child : children) {
+				getThis()->disconnectChild(label, child);
 			}
-			DEBUG_ASSERT_TRUE(pair_it->second.empty());
+			DEBUG_ASSERT_TRUE(m_exiting_transitions.begin()[i].second.empty());
 		}
 
 		// Rimuove le transizioni entranti
-		for (auto pair_it = m_incoming_transitions.begin(); pair_it != m_incoming_transitions.end(); pair_it++) {
-			string label = pair_it->first;
-			for (auto parent_iterator = pair_it->second.begin(); parent_iterator != pair_it->second.end(); ) {
-				// Controllo che non sia una transizione ad anello
-				if (*parent_iterator != this->getThis()) {
-					(*(parent_iterator++))->disconnectChild(label, getThis());
+		for (unsigned long int i = 0; i < m_incoming_transitions.size(); i++) {
+			string label = m_incoming_transitions.begin()[i].first;
+			TargetSet<S> parents = m_incoming_transitions.begin()[i].second;
+			for (S* parent : parents) {
+				// Controllo che non sia una transizione ad anello (già rimossa con le transizioni uscenti)
+				if (parent != this->getThis()) {
+					parent->disconnectChild(label, getThis());
 				}
 			}
-			DEBUG_ASSERT_TRUE(pair_it->second.empty());
+			DEBUG_ASSERT_TRUE(m_incoming_transitions.begin()[i].second.empty());
 		}
 	}
 
@@ -199,7 +214,7 @@ namespace translated_automata {
 		// Con "auto" sto esplicitando il processo di type-inference
 		if (search != m_exiting_transitions.end()) {
 			// Restituisco i nodi alla transizione uscente
-			return m_exiting_transitions[label];
+			return set<S*>(search->second.begin(), search->second.end());
 		} else {
 			// Restituisco un insieme vuoto
 			return set<S*>();
@@ -215,7 +230,7 @@ namespace translated_automata {
 	set<S*> State<S>::getParents(string label) {
 		auto search = m_incoming_transitions.find(label);
 		if (search != m_incoming_transitions.end()) {
-			return m_incoming_transitions[label];
+			return set<S*>(search->second.begin(), search->second.end());
 		} else {
 			return set<S*>();
 		}
@@ -268,19 +283,29 @@ namespace translated_automata {
 	}
 
 	/**
-	 * Restituisce la mappa di transizioni uscenti da questo stato.
+	 * Restituisce una copia della mappa di transizioni uscenti da questo stato.
 	 */
 	template <class S>
 	map<string, set<S*>> State<S>::getExitingTransitions() {
-		return m_exiting_transitions;
+		map<string, set<S*>> transitions;
+		for (auto &pair : m_exiting_transitions) {
+			transitions[pair.first] = set<S*>(pair.second.begin(), pair.second.end());
+		}
+		return transitions;
 	}
 
 	/**
-	 * Restituisce la mappa di transizioni entranti in questo stato.
+	 * Restituisce una copia della mappa di transizioni entranti in questo stato.
+	 * Nota: richiede l'indice delle transizioni entranti.
 	 */
 	template <class S>
 	map<string, set<S*>> State<S>::getIncomingTransitions() {
-		return m_incoming_transitions;
+		DEBUG_ASSERT_TRUE(m_incoming_indexed);
+		map<string, set<S*>> transitions;
+		for (auto &pair : m_incoming_transitions) {
+			transitions[pair.first] = set<S*>(pair.second.begin(), pair.second.end());
+		}
+		return transitions;
 	}
 
 	/**
@@ -289,7 +314,7 @@ namespace translated_automata {
 	 * Restituire un indirizzo permette di usare questo metodo come lvalue in un assegnamento, ad esempio.
 	 */
 	template <class S>
-	const map<string, set<S*>>& State<S>::getExitingTransitionsRef() {
+	const TransitionMap<S>& State<S>::getExitingTransitionsRef() {
 		return m_exiting_transitions;
 	}
 
@@ -299,7 +324,8 @@ namespace translated_automata {
 	 * Restituire un indirizzo permette di usare questo metodo come lvalue in un assegnamento, ad esempio.
 	 */
 	template <class S>
-	const map<string, set<S*>>& State<S>::getIncomingTransitionsRef() {
+	const TransitionMap<S>& State<S>::getIncomingTransitionsRef() {
+		DEBUG_ASSERT_TRUE(m_incoming_indexed);
 		return m_incoming_transitions;
 	}
 
@@ -321,9 +347,11 @@ namespace translated_automata {
 
 	/**
 	 * Conta le transizioni entranti nello stato.
+	 * Nota: richiede l'indice delle transizioni entranti.
 	 */
 	template <class S>
 	int State<S>::getIncomingTransitionsCount() {
+		DEBUG_ASSERT_TRUE(m_incoming_indexed);
 		int count = 0;
 		for (auto &pair: m_incoming_transitions) {
 			count += pair.second.size();
@@ -388,9 +416,12 @@ namespace translated_automata {
 	 * passato come parametro.
 	 * Le transizioni vengono confrontate tramite puntatore; gli stati devono perciò essere
 	 * effettivamente gli stessi.
+	 * Nota: richiede l'indice delle transizioni entranti su entrambi gli stati.
 	 */
 	template <class S>
 	bool State<S>::hasSameTransitionsOf(S* other_state) {
+		DEBUG_ASSERT_TRUE(m_incoming_indexed);
+		DEBUG_ASSERT_TRUE(other_state->m_incoming_indexed);
 		// Verifico che il numero di transizioni uscenti sia uguale
 		if (this->m_exiting_transitions.size() != other_state->m_exiting_transitions.size()) {
 			return false;
@@ -399,7 +430,7 @@ namespace translated_automata {
 		// Per tutte le transizioni uscenti
 		for (auto &pair: m_exiting_transitions) {
 			string label = pair.first;
-			set<S*> other_children = other_state->m_exiting_transitions[label];
+			const TargetSet<S>& other_children = other_state->m_exiting_transitions[label];
 
 			// Verifico che il numero di figli sia uguale
 			if (pair.second.size() != other_children.size()) {
@@ -423,7 +454,7 @@ namespace translated_automata {
 		// Per tutte le transizioni entranti
 		for (auto &pair: m_incoming_transitions) {
 			string label = pair.first;
-			set<S*> other_parents = other_state->m_incoming_transitions[label];
+			const TargetSet<S>& other_parents = other_state->m_incoming_transitions[label];
 
 			// Verifico che il numero di padri sia uguale
 			if (pair.second.size() != other_parents.size()) {
@@ -458,7 +489,7 @@ namespace translated_automata {
 		// Per tutte le transizioni uscenti
 		for (auto &pair : m_exiting_transitions) {
 			string label = pair.first;
-			set<S*> other_children = other_state->m_exiting_transitions[label];
+			const TargetSet<S>& other_children = other_state->m_exiting_transitions[label];
 
 			// Verifico che il numero di figli sia uguale
 			if (pair.second.size() != other_children.size()) {
@@ -494,7 +525,7 @@ namespace translated_automata {
 		// Per tutte le transizioni entranti
 		for (auto &pair: m_incoming_transitions) {
 			string label = pair.first;
-			set<S*> other_parents = other_state->m_incoming_transitions[label];
+			const TargetSet<S>& other_parents = other_state->m_incoming_transitions[label];
 
 			// Verifico che il numero di padri sia uguale
 			if (pair.second.size() != other_parents.size()) {
@@ -688,12 +719,18 @@ namespace translated_automata {
 
 //////////////////////////////////////////////////////////////////
 
+	/**
+	 * Contatore degli stati NFA creati, utilizzato per assegnare i numeri progressivi.
+	 */
+	static std::atomic<unsigned long int> state_nfa_serial_counter(0);
+
 	/**
 	 * Costruttore della classe StateNFA.
 	 */
 	StateNFA::StateNFA (string name, bool final) : State() {
 		m_final = final;
 		m_name = name;
+		m_serial = state_nfa_serial_counter++;
 	}
 
 	/**
@@ -703,6 +740,15 @@ namespace translated_automata {
 		DEBUG_LOG( "Cancellazione dello stato NFA \"%s\"", m_name.c_str() );
 	}
 
+	/**
+	 * Restituisce il numero progressivo dello stato, univoco fra tutti gli stati NFA creati.
+	 * A differenza dell'indirizzo, che può essere riutilizzato da uno stato creato dopo l'eliminazione
+	 * di questo, il numero progressivo identifica lo stato anche rispetto agli stati già eliminati.
+	 */
+	unsigned long int StateNFA::getSerial() const {
+		return m_serial;
+	}
+
 ///////////////////////////////////////////////////////////////////
 
 	/**
@@ -722,21 +768,21 @@ namespace translated_automata {
 
 	/**
 	 * Restituisce lo stato raggiunto da una transizione con una specifica etichetta.
-	 * In pratica, fa le stesse operazioni del metodo "getChildren" ma prende solamente il
-	 * primo nodo.
+	 * A differenza del metodo "getChildren", non copia l'insieme dei figli ma accede direttamente
+	 * al primo (e unico) nodo.
 	 * Se non viene trovato alcun figlio relativo alla label passata come argomento,
 	 * viene restituito un valore nullo.
 	 */
-	StateDFA* StateDFA::getChild(string label) {
-		set<StateDFA*> children = this->getChildren(label);
-		if (children.empty()) {
+	StateDFA* StateDFA::getChild(const string& label) {
+		auto& exiting_transitions = this->getExitingTransitionsRef();
+		auto transition = exiting_transitions.find(label);
+		if (transition == exiting_transitions.end() || transition->second.empty()) {
 			return NULL;
-		} else {
-			if (children.size() > 1) {
-				DEBUG_LOG_ERROR("Il nodo DFA \"%s\" contiene più di un figlio", this->getName().c_str());
-			}
-			return *(children.begin());
 		}
+		if (transition->second.size() > 1) {
+			DEBUG_LOG_ERROR("Il nodo DFA \"%s\" contiene più di un figlio", this->getName().c_str());
+		}
+		return *(transition->second.begin());
 	}
 
 ///////////////////////////////////////////////////////////////////
@@ -829,24 +875,50 @@ namespace translated_automata {
 		return false;
 	}
 
+	/**
+	 * Contatore degli stati DFA costruiti, utilizzato per assegnare i numeri progressivi.
+	 */
+	static std::atomic<unsigned long int> constructed_state_dfa_serial_counter(0);
+
 	/**
 	 * Costruttore della classe ConstructedStateDFA.
 	 * Assegna allo stato l'estensione passata come parametro e imposta il nome dello stato.
 	 * Prima della costruzione viene chiamato il costruttore della classe padre "StateDFA" mediante
 	 * l'utilizzo di due metodi statici che operano sull'estensione per ottenere il nome dello stato
 	 * e il valore booleano rappresentante se lo stato è final o no.
+	 * L'estensione viene internata nell'ExtensionPool, quindi non viene copiata se è già utilizzata da un altro stato.
+	 * Il nome dello stato viene calcolato solamente alla prima richiesta.
 	 */
 	ConstructedStateDFA::ConstructedStateDFA(ExtensionDFA &extension)
-		: StateDFA(ConstructedStateDFA::createNameFromExtension(extension), ConstructedStateDFA::hasFinalStates(extension)) {
+		: ConstructedStateDFA(ExtensionPool::shared().intern(extension)) {}
+
+	/**
+	 * Costruttore della classe ConstructedStateDFA.
+	 * Assegna allo stato l'estensione (già internata) passata come parametro.
+	 */
+	ConstructedStateDFA::ConstructedStateDFA(const ExtensionHandle &extension)
+		: StateDFA("", ConstructedStateDFA::hasFinalStates(*extension)) {
 
 		this->m_extension = extension;
+		this->m_name_pending = true;
+		this->m_serial = constructed_state_dfa_serial_counter++;
 	}
 
 	/**
 	 * Distruttore della classe ConstructedStateDFA.
+	 * Rilascia il riferimento all'estensione, che viene eliminata se non è utilizzata da altri stati.
 	 */
 	ConstructedStateDFA::~ConstructedStateDFA() {
-		this->m_extension.clear();
+		this->m_extension.reset();
+	}
+
+	/**
+	 * Restituisce il numero progressivo dello stato, assegnato in ordine di creazione.
+	 * A differenza del nome e dell'identificatore, non varia durante la vita dello stato
+	 * (nemmeno quando l'estensione viene sostituita o lo stato viene spostato nell'automa).
+	 */
+	unsigned long int ConstructedStateDFA::getSerial() const {
+		return this->m_serial;
 	}
 
 	/**
@@ -863,12 +935,28 @@ namespace translated_automata {
 		return this->m_mark;
 	}
 
+	/**
+	 * Metodo protetto.
+	 * Calcola il nome dello stato a partire dalla sua estensione.
+	 */
+	string ConstructedStateDFA::computeName() const {
+		return createNameFromExtension(*m_extension);
+	}
+
 	/**
 	 * Verifica se lo stato ha una specifica estensione passata come parametro.
-	 * Il confronto viene effettuato mediante la stringa contenente tutti i nomi dell'estensione.
+	 * Il confronto viene effettuato sugli stati dell'estensione, senza costruirne il nome.
 	 */
 	bool ConstructedStateDFA::hasExtension(const ExtensionDFA &ext) {
-		return (getName() == createNameFromExtension(ext));
+		return (*m_extension == ext);
+	}
+
+	/**
+	 * Verifica se lo stato ha l'estensione internata passata come parametro.
+	 * Poiché estensioni uguali condividono lo stesso riferimento, il confronto avviene in tempo costante.
+	 */
+	bool ConstructedStateDFA::hasExtension(const ExtensionHandle &ext) {
+		return (m_extension == ext);
 	}
 
 	/**
@@ -876,9 +964,25 @@ namespace translated_automata {
 	 * da cui questo stato è stato creato.
 	 */
 	const ExtensionDFA& ConstructedStateDFA::getExtension() {
+		return *m_extension;
+	}
+
+	/**
+	 * Restituisce il riferimento condiviso all'estensione dello stato.
+	 * Il riferimento mantiene valida l'estensione anche dopo una sua sostituzione (o la distruzione dello stato).
+	 */
+	ExtensionHandle ConstructedStateDFA::getExtensionHandle() {
 		return m_extension;
 	}
 
+	/**
+	 * Restituisce la versione dell'estensione, ossia il numero di volte in cui è stata sostituita.
+	 * Permette di verificare se un valore calcolato a partire dall'estensione è ancora valido.
+	 */
+	unsigned long int ConstructedStateDFA::getExtensionVersion() {
+		return m_extension_version;
+	}
+
 	/**
 	 * Restituisce tutte le etichette delle transizioni uscenti dagli stati
 	 * dell'estensione.
@@ -888,7 +992,7 @@ namespace translated_automata {
 		DEBUG_ASSERT_TRUE(labels->size() == 0);
 
 		// Per ciascuno stato dell'estensione
-		for (StateNFA* member : m_extension) {
+		for (StateNFA* member : *m_extension) {
 			DEBUG_LOG("Per lo stato dell'estensione \"%s\"", member->getName().c_str());
 			// Inserisco le label delle transizioni uscenti
 			for (auto &pair: member->getExitingTransitionsRef()) {
@@ -917,7 +1021,7 @@ namespace translated_automata {
 
 		// Computazione degli stati raggiunti tramite label L
 		ExtensionDFA l_closure;
-		for (StateNFA* member : this->m_extension) {
+		for (StateNFA* member : *this->m_extension) {
 			for (StateNFA* child : member->getChildren(label)) {
 				l_closure.insert(child);
 			}
@@ -931,19 +1035,33 @@ namespace translated_automata {
 	 * Sostituisce interamente l'estensione di questo stato con un'altra.
 	 *
 	 * Nota: questo metodo causa anche il cambio del nome dello stato, basato
-	 * sugli stati dell'NFA che sono contenuti nella nuova estensione.
+	 * sugli stati dell'NFA che sono contenuti nella nuova estensione (calcolato alla prima richiesta).
+	 * Nota: la precedente estensione non viene modificata, ma solamente rilasciata.
 	 */
 	void ConstructedStateDFA::replaceExtensionWith(ExtensionDFA &new_ext) {
-		this->m_extension = new_ext;
-		this->m_name = createNameFromExtension(m_extension);
-		this->m_final = hasFinalStates(m_extension);
+		this->m_extension = ExtensionPool::shared().intern(new_ext);
+		this->m_extension_version++;
+		this->m_name_pending = true;
+		this->m_final = hasFinalStates(*m_extension);
 	}
 
 	/**
 	 * Verifica se lo stato è "vuoto", ossia se la sua estensione è vuota.
 	 */
 	bool ConstructedStateDFA::isExtensionEmpty() {
-		return m_extension.empty();
+		return m_extension->empty();
+	}
+
+	/**
+	 * Calcola il nome dello stato, se non è già stato calcolato.
+	 * Il nome dipende dai nomi degli stati dell'NFA contenuti nell'estensione: questo metodo deve essere
+	 * chiamato prima che tali stati vengano eliminati, se lo stato deve sopravvivere all'NFA.
+	 */
+	void ConstructedStateDFA::resolveName() {
+		if (m_name_pending) {
+			m_name = this->computeName();
+			m_name_pending = false;
+		}
 	}
 
 }
@@ -0,0 +1,362 @@
+/*
+ * Statistics.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione delle strutture per l'analisi statistica in streaming:
+ * - TDigest, sketch per la stima dei quantili.
+ * - StatAccumulator, che aggrega minimo, massimo, media, varianza e quantili.
+ *
+ */
+
+#include "Statistics.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Debug.hpp"
+
+#define TDIGEST_BUFFER_FACTOR 5
+
+namespace translated_automata {
+
+	/**
+	 * Costruttore.
+	 * Il parametro di compressione stabilisce il numero (approssimativo) di centroidi
+	 * mantenuti in memoria; valori maggiori garantiscono stime più precise.
+	 */
+	TDigest::TDigest(double compression) {
+		this->m_compression = compression;
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	TDigest::~TDigest() {}
+
+	/**
+	 * Metodo privato.
+	 * Restituisce il massimo quantile che può essere raggiunto da un centroide che inizia
+	 * al quantile q, secondo la funzione di scala k1(q) = δ / 2π * asin(2q - 1).
+	 * Un centroide può crescere finché la differenza di scala fra i suoi estremi non supera 1.
+	 */
+	double TDigest::computeScaleLimit(double q) {
+		double k = this->m_compression / (2 * M_PI) * asin(2 * q - 1);
+		if (k + 1 >= this->m_compression / 4) {
+			return 1;
+		}
+		return (sin((k + 1) * 2 * M_PI / this->m_compression) + 1) / 2;
+	}
+
+	/**
+	 * Metodo privato.
+	 * Unisce i valori del buffer ai centroidi esistenti, accorpando i centroidi adiacenti
+	 * finché il vincolo sulla funzione di scala lo permette.
+	 */
+	void TDigest::compress() {
+		if (this->m_buffer.empty()) {
+			return;
+		}
+
+		// Unione dei centroidi con il buffer e ordinamento per media
+		vector<Centroid> all = this->m_centroids;
+		all.insert(all.end(), this->m_buffer.begin(), this->m_buffer.end());
+		std::sort(all.begin(), all.end(), [](const Centroid& lhs, const Centroid& rhs) {
+			return lhs.mean < rhs.mean;
+		});
+		this->m_buffer.clear();
+
+		vector<Centroid> compressed;
+		compressed.reserve(all.size());
+		Centroid current = all[0];
+		double weight_so_far = 0;
+		double q_limit = this->computeScaleLimit(0);
+
+		for (unsigned long int i = 1; i < all.size(); i++) {
+			double proposed_weight = weight_so_far + current.weight + all[i].weight;
+			if (proposed_weight / this->m_total_weight <= q_limit) {
+				// Il centroide successivo viene accorpato a quello corrente
+				current.mean += (all[i].mean - current.mean) * all[i].weight / (current.weight + all[i].weight);
+				current.weight += all[i].weight;
+			} else {
+				// Il centroide corrente è completo, si passa al successivo
+				compressed.push_back(current);
+				weight_so_far += current.weight;
+				q_limit = this->computeScaleLimit(weight_so_far / this->m_total_weight);
+				current = all[i];
+			}
+		}
+		compressed.push_back(current);
+
+		this->m_centroids = compressed;
+	}
+
+	/**
+	 * Aggiunge un valore (eventualmente pesato) allo sketch.
+	 * Il valore viene inserito in un buffer, compresso solo quando il buffer è pieno.
+	 */
+	void TDigest::add(double value, double weight) {
+		if (this->m_total_weight == 0) {
+			this->m_min = value;
+			this->m_max = value;
+		} else {
+			this->m_min = std::min(this->m_min, value);
+			this->m_max = std::max(this->m_max, value);
+		}
+		this->m_total_weight += weight;
+		this->m_buffer.push_back({value, weight});
+
+		if (this->m_buffer.size() >= TDIGEST_BUFFER_FACTOR * this->m_compression) {
+			this->compress();
+		}
+	}
+
+	/**
+	 * Unisce allo sketch corrente i valori di un altro sketch.
+	 * Il risultato approssima lo sketch che si sarebbe ottenuto aggiungendo tutti i valori
+	 * ad un unico oggetto.
+	 */
+	void TDigest::merge(const TDigest& other) {
+		if (other.m_total_weight == 0) {
+			return;
+		}
+		if (this->m_total_weight == 0) {
+			this->m_min = other.m_min;
+			this->m_max = other.m_max;
+		} else {
+			this->m_min = std::min(this->m_min, other.m_min);
+			this->m_max = std::max(this->m_max, other.m_max);
+		}
+		this->m_total_weight += other.m_total_weight;
+		this->m_buffer.insert(this->m_buffer.end(), other.m_centroids.begin(), other.m_centroids.end());
+		this->m_buffer.insert(this->m_buffer.end(), other.m_buffer.begin(), other.m_buffer.end());
+		this->compress();
+	}
+
+	/**
+	 * Riporta lo sketch allo stato iniziale, rimuovendo tutti i valori.
+	 */
+	void TDigest::reset() {
+		this->m_centroids.clear();
+		this->m_buffer.clear();
+		this->m_total_weight = 0;
+		this->m_min = 0;
+		this->m_max = 0;
+	}
+
+	/**
+	 * Restituisce il peso complessivo dei valori inseriti.
+	 */
+	double TDigest::getCount() const {
+		return this->m_total_weight;
+	}
+
+	/**
+	 * Restituisce la stima del quantile q (con 0 <= q <= 1).
+	 * La stima è ottenuta interpolando linearmente fra i centri dei centroidi; agli estremi
+	 * si utilizzano il minimo e il massimo esatti.
+	 */
+	double TDigest::getQuantile(double q) {
+		this->compress();
+		if (this->m_total_weight == 0) {
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+		if (q <= 0) {
+			return this->m_min;
+		}
+		if (q >= 1) {
+			return this->m_max;
+		}
+		if (this->m_centroids.size() == 1) {
+			return this->m_centroids[0].mean;
+		}
+
+		double index = q * this->m_total_weight;
+
+		// Coda sinistra: interpolazione fra il minimo e il centro del primo centroide
+		const Centroid& first = this->m_centroids.front();
+		if (index < first.weight / 2) {
+			return this->m_min + (index / (first.weight / 2)) * (first.mean - this->m_min);
+		}
+
+		// Zona centrale: interpolazione fra i centri di due centroidi adiacenti
+		double cumulative = first.weight / 2;
+		for (unsigned long int i = 0; i + 1 < this->m_centroids.size(); i++) {
+			double delta_weight = (this->m_centroids[i].weight + this->m_centroids[i + 1].weight) / 2;
+			if (cumulative + delta_weight > index) {
+				double t = (index - cumulative) / delta_weight;
+				return this->m_centroids[i].mean + t * (this->m_centroids[i + 1].mean - this->m_centroids[i].mean);
+			}
+			cumulative += delta_weight;
+		}
+
+		// Coda destra: interpolazione fra il centro dell'ultimo centroide e il massimo
+		const Centroid& last = this->m_centroids.back();
+		double t = (index - cumulative) / (last.weight / 2);
+		return last.mean + std::min(t, 1.0) * (this->m_max - last.mean);
+	}
+
+	/**
+	 * Restituisce la stima della funzione di ripartizione nel punto x, ossia
+	 * la frazione di valori minori o uguali a x.
+	 */
+	double TDigest::getCumulativeDistribution(double x) {
+		this->compress();
+		if (this->m_total_weight == 0) {
+			return std::numeric_limits<double>::quiet_NaN();
+		}
+		if (x < this->m_min) {
+			return 0;
+		}
+		if (x >= this->m_max) {
+			return 1;
+		}
+
+		// Coda sinistra
+		const Centroid& first = this->m_centroids.front();
+		if (x < first.mean) {
+			return (first.weight / 2) * (x - this->m_min) / (first.mean - this->m_min) / this->m_total_weight;
+		}
+
+		// Zona centrale
+		double cumulative = first.weight / 2;
+		for (unsigned long int i = 0; i + 1 < this->m_centroids.size(); i++) {
+			double delta_weight = (this->m_centroids[i].weight + this->m_centroids[i + 1].weight) / 2;
+			if (x < this->m_centroids[i + 1].mean) {
+				double t = (x - this->m_centroids[i].mean) / (this->m_centroids[i + 1].mean - this->m_centroids[i].mean);
+				return (cumulative + t * delta_weight) / this->m_total_weight;
+			}
+			cumulative += delta_weight;
+		}
+
+		// Coda destra
+		const Centroid& last = this->m_centroids.back();
+		double t = (x - last.mean) / (this->m_max - last.mean);
+		return (cumulative + t * last.weight / 2) / this->m_total_weight;
+	}
+
+/////////////////////////////////////////////////////////////////////
+
+	/**
+	 * Costruttore.
+	 */
+	StatAccumulator::StatAccumulator() : m_digest() {}
+
+	/**
+	 * Distruttore.
+	 */
+	StatAccumulator::~StatAccumulator() {}
+
+	/**
+	 * Aggiunge un valore all'accumulatore, aggiornando media e varianza
+	 * secondo l'algoritmo di Welford.
+	 */
+	void StatAccumulator::add(double value) {
+		if (this->m_count == 0) {
+			this->m_min = value;
+			this->m_max = value;
+		} else {
+			this->m_min = std::min(this->m_min, value);
+			this->m_max = std::max(this->m_max, value);
+		}
+		this->m_count++;
+		double delta = value - this->m_mean;
+		this->m_mean += delta / this->m_count;
+		this->m_m2 += delta * (value - this->m_mean);
+		this->m_digest.add(value);
+	}
+
+	/**
+	 * Unisce all'accumulatore corrente i valori di un altro accumulatore.
+	 * Media e varianza vengono combinate secondo la formula di Chan et al.
+	 */
+	void StatAccumulator::merge(const StatAccumulator& other) {
+		if (other.m_count == 0) {
+			return;
+		}
+		if (this->m_count == 0) {
+			this->m_min = other.m_min;
+			this->m_max = other.m_max;
+		} else {
+			this->m_min = std::min(this->m_min, other.m_min);
+			this->m_max = std::max(this->m_max, other.m_max);
+		}
+		unsigned long int total_count = this->m_count + other.m_count;
+		double delta = other.m_mean - this->m_mean;
+		this->m_mean += delta * other.m_count / total_count;
+		this->m_m2 += other.m_m2 + delta * delta * ((double) this->m_count) * other.m_count / total_count;
+		this->m_count = total_count;
+		this->m_digest.merge(other.m_digest);
+	}
+
+	/**
+	 * Riporta l'accumulatore allo stato iniziale.
+	 */
+	void StatAccumulator::reset() {
+		this->m_count = 0;
+		this->m_mean = 0;
+		this->m_m2 = 0;
+		this->m_min = 0;
+		this->m_max = 0;
+		this->m_digest.reset();
+	}
+
+	/**
+	 * Restituisce il numero di valori accumulati.
+	 */
+	unsigned long int StatAccumulator::getCount() const {
+		return this->m_count;
+	}
+
+	/**
+	 * Restituisce il valore minimo, o NaN se non sono presenti valori.
+	 */
+	double StatAccumulator::getMin() const {
+		return (this->m_count > 0) ? this->m_min : std::numeric_limits<double>::quiet_NaN();
+	}
+
+	/**
+	 * Restituisce il valore massimo, o NaN se non sono presenti valori.
+	 */
+	double StatAccumulator::getMax() const {
+		return (this->m_count > 0) ? this->m_max : std::numeric_limits<double>::quiet_NaN();
+	}
+
+	/**
+	 * Restituisce la media dei valori, o NaN se non sono presenti valori.
+	 */
+	double StatAccumulator::getMean() const {
+		return (this->m_count > 0) ? this->m_mean : std::numeric_limits<double>::quiet_NaN();
+	}
+
+	/**
+	 * Restituisce la varianza campionaria dei valori.
+	 * Con meno di due valori la varianza è considerata nulla.
+	 */
+	double StatAccumulator::getVariance() const {
+		return (this->m_count > 1) ? (this->m_m2 / (this->m_count - 1)) : 0;
+	}
+
+	/**
+	 * Restituisce la deviazione standard campionaria dei valori.
+	 */
+	double StatAccumulator::getStandardDeviation() const {
+		return sqrt(this->getVariance());
+	}
+
+	/**
+	 * Restituisce la stima del quantile q (con 0 <= q <= 1).
+	 */
+	double StatAccumulator::getQuantile(double q) {
+		return this->m_digest.getQuantile(q);
+	}
+
+	/**
+	 * Restituisce la stima della frazione di valori minori o uguali a x.
+	 */
+	double StatAccumulator::getCumulativeDistribution(double x) {
+		return this->m_digest.getCumulativeDistribution(x);
+	}
+
+} /* namespace translated_automata */
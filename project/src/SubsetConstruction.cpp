@@ -11,8 +11,10 @@
 #include "SubsetConstruction.hpp"
 
 #include <queue>
+#include <unordered_map>
 
 #include "Debug.hpp"
+#include "ExtensionPool.hpp"
 #include "State.hpp"
 
 namespace translated_automata {
@@ -20,11 +22,14 @@ namespace translated_automata {
     /**
      * Esegue l'algoritmo "Subset Construction".
      * Nota: siamo sempre nel caso in cui NON esistono epsilon-transizioni.
+     * Gli stati già creati vengono ritrovati tramite la loro estensione internata, senza costruirne il nome.
      */
 	DFA* SubsetConstruction::run(NFA* nfa) {
 
 		// Creo l'automa a stati finiti deterministico, inizialmente vuoto
 		DFA* dfa = new DFA();
+		// Il DFA viene costruito e visitato solamente in avanti: le transizioni entranti non sono mantenute
+		dfa->setForwardOnly();
 
         // Creo lo stato iniziale per il DFA
 		ExtensionDFA initial_dfa_extension;
@@ -37,6 +42,10 @@ namespace translated_automata {
 		// Inserisco lo stato all'interno del DFA
         dfa->addState(initial_dfa_state);
 
+        // Indice degli stati del DFA per estensione (internata)
+        std::unordered_map<const ExtensionDFA*, ConstructedStateDFA*> states_by_extension;
+        states_by_extension[&initial_dfa_state->getExtension()] = initial_dfa_state;
+
         // Stack per gli stati ancora da processare (bud)
         std::queue<ConstructedStateDFA*> buds_stack;
 
@@ -57,34 +66,33 @@ namespace translated_automata {
             		continue;
             	}
 
-            	// Computo la l-closure dello stato e creo un nuovo stato DFA
-            	ExtensionDFA l_closure = current_state->computeLClosureOfExtension(l);
-            	ConstructedStateDFA* new_state = new ConstructedStateDFA(l_closure);
-            	DEBUG_LOG("Dallo stato %s, con la label %s, ho creato lo stato %s",
+            	// Computo la l-closure dello stato
+            	ExtensionHandle l_closure = ExtensionPool::shared().intern(current_state->computeLClosureOfExtension(l));
+            	ConstructedStateDFA* new_state;
+            	DEBUG_LOG("Dallo stato %s, con la label %s, ho calcolato l'estensione %s",
             			current_state->getName().c_str(),
 						l.c_str(),
-						new_state->getName().c_str());
+						ConstructedStateDFA::createNameFromExtension(*l_closure).c_str());
 
-                // Verifico se lo stato DFA creato è vuoto
-                if (new_state->isExtensionEmpty()) {
-                	// Se sì, lo elimino e procedo
+                // Verifico se l'estensione è vuota
+                if (l_closure->empty()) {
+                	// Se sì, procedo senza creare alcuno stato
                 	DEBUG_LOG("Estensione vuota, salto l'iterazione");
-                    delete new_state;
                     continue;
                 }
-                // Verifico se lo stato DFA creato è già presente nel DFA (come nome)
-                else if (dfa->hasState(new_state->getName())) {
-                	// Se sì, lo stato estratto dalla queue può essere eliminato
-                	DEBUG_LOG("Lo stato è già presente, lo elimino e recupero quello vecchio");
-                	ConstructedStateDFA* tmp_state = new_state;
-                    new_state = (ConstructedStateDFA*) dfa->getState(tmp_state->getName());
-                    delete tmp_state;
+                // Verifico se esiste già uno stato con la stessa estensione
+                else if (states_by_extension.count(l_closure.get())) {
+                	// Se sì, recupero lo stato già presente
+                	DEBUG_LOG("Lo stato è già presente, recupero quello vecchio");
+                    new_state = states_by_extension[l_closure.get()];
                 }
                 // Se si tratta di uno stato "nuovo"
                 else {
-                	// Lo aggiungo al DFA e alla queue
+                	// Lo creo e lo aggiungo al DFA e alla queue
                 	DEBUG_LOG("Lo stato è nuovo, lo aggiungo all'automa");
+                	new_state = new ConstructedStateDFA(l_closure);
                     dfa->addState(new_state);
+                    states_by_extension[l_closure.get()] = new_state;
                     buds_stack.push(new_state);
                 }
 
@@ -98,6 +106,11 @@ namespace translated_automata {
         // Questa operazione sistema le distanze in automatico
         dfa->setInitialState(initial_dfa_state);
 
+        // Calcolo dei nomi degli stati, poiché il DFA può sopravvivere all'NFA a cui fanno riferimento le estensioni
+        for (auto &pair : states_by_extension) {
+        	pair.second->resolveName();
+        }
+
         return dfa;
 	}
 }
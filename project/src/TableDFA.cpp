@@ -0,0 +1,434 @@
+/*
+ * TableDFA.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione della rappresentazione tabellare di un DFA.
+ *
+ */
+
+#include "TableDFA.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+	using std::pair;
+
+	/**
+	 * Costruttore.
+	 * Converte un DFA nella rappresentazione tabellare, con la disposizione specificata (oppure scelta
+	 * in base al riempimento della tabella). Gli stati mantengono la numerazione dell'automa: il numero
+	 * di ciascuno stato è il suo identificatore.
+	 */
+	TableDFA::TableDFA(DFA* dfa, TableDFALayout layout) : TableDFA(LabelIndex(dfa->getAlphabet())) {
+		vector<StateDFA*> states = dfa->getStatesVector();
+		this->m_states_count = states.size();
+		this->m_final.reserve(states.size());
+		this->m_names.reserve(states.size());
+
+		vector<uint32_t> offsets;
+		vector<LabelId> labels;
+		vector<uint32_t> targets;
+		offsets.reserve(states.size() + 1);
+		vector<pair<LabelId, uint32_t>> row;
+		for (StateDFA* state : states) {
+			this->m_final.push_back(state->isFinal());
+			this->m_names.push_back(state->getName());
+
+			// Le label della mappa sono ordinate per nome: la riga viene riordinata per identificatore
+			row.clear();
+			for (auto &transition : state->getExitingTransitionsRef()) {
+				LabelId label = this->m_label_index.getId(transition.first);
+				if (label >= this->m_columns || transition.second.empty()) {
+					continue;
+				}
+				if (transition.second.size() > 1) {
+					DEBUG_LOG_ERROR("Il nodo DFA \"%s\" contiene più di un figlio", state->getName().c_str());
+				}
+				StateDFA* child = *(transition.second.begin());
+				if (dfa->hasState(child)) {
+					row.push_back({ label, child->getId() });
+				}
+			}
+			std::sort(row.begin(), row.end());
+
+			offsets.push_back(labels.size());
+			for (auto &transition : row) {
+				labels.push_back(transition.first);
+				targets.push_back(transition.second);
+			}
+		}
+		offsets.push_back(labels.size());
+
+		this->build(std::move(offsets), std::move(labels), std::move(targets), layout);
+		StateDFA* initial_state = dfa->getInitialState();
+		this->m_initial_state = (dfa->hasState(initial_state)) ? initial_state->getId() : TABLE_DFA_NO_STATE;
+	}
+
+	/**
+	 * Costruttore privato.
+	 * Crea un automa vuoto sull'alfabeto specificato.
+	 */
+	TableDFA::TableDFA(const LabelIndex& label_index) : m_label_index(label_index) {
+		this->m_layout = TABLE_DFA_SPARSE;
+		this->m_states_count = 0;
+		this->m_transitions_count = 0;
+		this->m_columns = label_index.size();
+		this->m_initial_state = TABLE_DFA_NO_STATE;
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	TableDFA::~TableDFA() {}
+
+	/**
+	 * Metodo privato.
+	 * Memorizza le transizioni, fornite come righe compresse ordinate per label, nella disposizione specificata.
+	 */
+	void TableDFA::build(vector<uint32_t>&& offsets, vector<LabelId>&& labels, vector<uint32_t>&& targets, TableDFALayout layout) {
+		DEBUG_ASSERT_TRUE(offsets.size() == this->m_states_count + 1);
+		if (layout == TABLE_DFA_AUTO) {
+			layout = TableDFA::chooseLayout(this->m_states_count, labels.size(), this->m_columns);
+		}
+		this->m_layout = layout;
+
+		if (layout == TABLE_DFA_DENSE) {
+			this->m_next.assign((unsigned long int) this->m_states_count * this->m_columns, TABLE_DFA_NO_STATE);
+			for (uint32_t state = 0; state < this->m_states_count; state++) {
+				uint32_t* row = &this->m_next[(unsigned long int) state * this->m_columns];
+				for (uint32_t t = offsets[state]; t < offsets[state + 1]; t++) {
+					row[labels[t]] = targets[t];
+				}
+			}
+			this->m_transitions_count = labels.size();
+		} else {
+			this->m_row_offsets = std::move(offsets);
+			this->m_row_labels = std::move(labels);
+			this->m_row_targets = std::move(targets);
+			this->m_transitions_count = this->m_row_labels.size();
+		}
+	}
+
+	/**
+	 * Metodo statico.
+	 * Sceglie la disposizione più adatta: la tabella DENSE viene utilizzata se almeno una frazione
+	 * TABLE_DFA_DENSE_MIN_FILL delle sue celle contiene una transizione.
+	 */
+	TableDFALayout TableDFA::chooseLayout(unsigned long int states_count, unsigned long int transitions_count, unsigned int labels_count) {
+		unsigned long int cells = states_count * labels_count;
+		if (cells == 0 || transitions_count >= cells * TABLE_DFA_DENSE_MIN_FILL) {
+			return TABLE_DFA_DENSE;
+		}
+		return TABLE_DFA_SPARSE;
+	}
+
+	/**
+	 * Restituisce il numero di stati.
+	 */
+	unsigned int TableDFA::size() const {
+		return this->m_states_count;
+	}
+
+	/**
+	 * Restituisce il numero di transizioni.
+	 */
+	unsigned long int TableDFA::getTransitionsCount() const {
+		return this->m_transitions_count;
+	}
+
+	TableDFALayout TableDFA::getLayout() const {
+		return this->m_layout;
+	}
+
+	/**
+	 * Restituisce la corrispondenza fra label e identificatori utilizzata dall'automa.
+	 */
+	const LabelIndex& TableDFA::getLabelIndex() const {
+		return this->m_label_index;
+	}
+
+	/**
+	 * Restituisce il numero dello stato iniziale, oppure TABLE_DFA_NO_STATE se l'automa non ha stato iniziale.
+	 */
+	uint32_t TableDFA::getInitialState() const {
+		return this->m_initial_state;
+	}
+
+	bool TableDFA::isFinal(uint32_t state) const {
+		return this->m_final[state];
+	}
+
+	const string& TableDFA::getName(uint32_t state) const {
+		return this->m_names[state];
+	}
+
+	/**
+	 * Restituisce lo stato raggiunto dallo stato specificato tramite la label specificata, oppure
+	 * TABLE_DFA_NO_STATE se la transizione non è definita (o se la label non appartiene all'alfabeto).
+	 */
+	uint32_t TableDFA::getChild(uint32_t state, LabelId label) const {
+		if (label >= this->m_columns) {
+			return TABLE_DFA_NO_STATE;
+		}
+		if (this->m_layout == TABLE_DFA_DENSE) {
+			return this->m_next[(unsigned long int) state * this->m_columns + label];
+		}
+		auto begin = this->m_row_labels.begin() + this->m_row_offsets[state];
+		auto end = this->m_row_labels.begin() + this->m_row_offsets[state + 1];
+		auto it = std::lower_bound(begin, end, label);
+		if (it == end || *it != label) {
+			return TABLE_DFA_NO_STATE;
+		}
+		return this->m_row_targets[it - this->m_row_labels.begin()];
+	}
+
+	/**
+	 * Restituisce le transizioni uscenti dallo stato specificato, come coppie (label, stato) ordinate per label.
+	 */
+	vector<pair<LabelId, uint32_t>> TableDFA::getTransitions(uint32_t state) const {
+		vector<pair<LabelId, uint32_t>> transitions;
+		if (this->m_layout == TABLE_DFA_DENSE) {
+			const uint32_t* row = &this->m_next[(unsigned long int) state * this->m_columns];
+			for (LabelId label = 0; label < this->m_columns; label++) {
+				if (row[label] != TABLE_DFA_NO_STATE) {
+					transitions.push_back({ label, row[label] });
+				}
+			}
+		} else {
+			for (uint32_t t = this->m_row_offsets[state]; t < this->m_row_offsets[state + 1]; t++) {
+				transitions.push_back({ this->m_row_labels[t], this->m_row_targets[t] });
+			}
+		}
+		return transitions;
+	}
+
+	/**
+	 * Restituisce il DFA minimo equivalente, calcolato con il raffinamento delle partizioni di Moore.
+	 * Vengono considerati solamente gli stati raggiungibili dallo stato iniziale; le transizioni non definite
+	 * sono trattate come transizioni verso uno stato pozzo implicito. Gli stati equivalenti al pozzo (da cui
+	 * non è raggiungibile alcuno stato finale) vengono rimossi, così che il risultato sia un DFA parziale minimo.
+	 *
+	 * Gli stati del risultato sono numerati in ordine di visita BFS (con le label in ordine di identificatore)
+	 * e prendono il nome del primo stato visitato della propria classe: il risultato dipende quindi solamente
+	 * dal linguaggio riconosciuto e dai nomi degli stati.
+	 */
+	TableDFA TableDFA::minimize() const {
+		TableDFA result(this->m_label_index);
+		if (this->m_initial_state == TABLE_DFA_NO_STATE) {
+			result.build(vector<uint32_t>(1, 0), vector<LabelId>(), vector<uint32_t>(), this->m_layout);
+			return result;
+		}
+		unsigned int columns = this->m_columns;
+
+		// Stati raggiungibili, in ordine di visita; il pozzo occupa l'ultima posizione
+		vector<uint32_t> reached;
+		vector<uint32_t> local(this->m_states_count, TABLE_DFA_NO_STATE);
+		local[this->m_initial_state] = 0;
+		reached.push_back(this->m_initial_state);
+		for (unsigned int i = 0; i < reached.size(); i++) {
+			for (auto &transition : this->getTransitions(reached[i])) {
+				if (local[transition.second] == TABLE_DFA_NO_STATE) {
+					local[transition.second] = reached.size();
+					reached.push_back(transition.second);
+				}
+			}
+		}
+		uint32_t nodes_count = reached.size() + 1;
+		uint32_t sink = reached.size();
+
+		// Transizioni locali: next[nodo * |Σ| + label]
+		vector<uint32_t> next((unsigned long int) nodes_count * columns, sink);
+		for (uint32_t node = 0; node < sink; node++) {
+			for (auto &transition : this->getTransitions(reached[node])) {
+				next[(unsigned long int) node * columns + transition.first] = local[transition.second];
+			}
+		}
+
+		// Partizione iniziale: stati finali e non finali (compreso il pozzo)
+		vector<uint32_t> classes(nodes_count, 0);
+		uint32_t classes_count = 1;
+		for (uint32_t node = 0; node < sink; node++) {
+			if (this->m_final[reached[node]]) {
+				classes[node] = 1;
+				classes_count = 2;
+			}
+		}
+
+		// Raffinamento: due nodi restano nella stessa classe se hanno la stessa classe e, per ogni label,
+		// figli nella stessa classe. Il numero di classi non diminuisce mai, quindi ci si ferma quando non cresce.
+		vector<uint32_t> signatures((unsigned long int) nodes_count * (columns + 1));
+		vector<uint32_t> order(nodes_count);
+		vector<uint32_t> new_classes(nodes_count);
+		while (true) {
+			for (uint32_t node = 0; node < nodes_count; node++) {
+				uint32_t* signature = &signatures[(unsigned long int) node * (columns + 1)];
+				signature[0] = classes[node];
+				for (LabelId label = 0; label < columns; label++) {
+					signature[label + 1] = classes[next[(unsigned long int) node * columns + label]];
+				}
+			}
+			auto compare = [&signatures, columns](uint32_t lhs, uint32_t rhs) {
+				const uint32_t* lhs_signature = &signatures[(unsigned long int) lhs * (columns + 1)];
+				const uint32_t* rhs_signature = &signatures[(unsigned long int) rhs * (columns + 1)];
+				return std::lexicographical_compare(lhs_signature, lhs_signature + columns + 1, rhs_signature, rhs_signature + columns + 1);
+			};
+			std::iota(order.begin(), order.end(), 0);
+			std::sort(order.begin(), order.end(), compare);
+
+			uint32_t refined_count = 0;
+			for (uint32_t i = 0; i < nodes_count; i++) {
+				if (i > 0 && compare(order[i - 1], order[i])) {
+					refined_count++;
+				}
+				new_classes[order[i]] = refined_count;
+			}
+			refined_count++;
+			classes.swap(new_classes);
+			if (refined_count == classes_count) {
+				break;
+			}
+			classes_count = refined_count;
+		}
+
+		// Numerazione delle classi in ordine di visita, escludendo la classe del pozzo
+		// (tranne quando coincide con la classe dello stato iniziale, ossia il linguaggio è vuoto)
+		uint32_t sink_class = classes[sink];
+		vector<uint32_t> class_numbers(classes_count, TABLE_DFA_NO_STATE);
+		vector<uint32_t> representatives;
+		for (uint32_t node = 0; node < sink; node++) {
+			if (class_numbers[classes[node]] == TABLE_DFA_NO_STATE && (classes[node] != sink_class || node == 0)) {
+				class_numbers[classes[node]] = representatives.size();
+				representatives.push_back(node);
+			}
+		}
+
+		vector<uint32_t> offsets;
+		vector<LabelId> labels;
+		vector<uint32_t> targets;
+		offsets.reserve(representatives.size() + 1);
+		for (uint32_t node : representatives) {
+			offsets.push_back(labels.size());
+			for (LabelId label = 0; label < columns; label++) {
+				uint32_t child_class = classes[next[(unsigned long int) node * columns + label]];
+				if (child_class != sink_class) {
+					labels.push_back(label);
+					targets.push_back(class_numbers[child_class]);
+				}
+			}
+			result.m_final.push_back(this->m_final[reached[node]]);
+			result.m_names.push_back(this->m_names[reached[node]]);
+		}
+		offsets.push_back(labels.size());
+
+		result.m_states_count = representatives.size();
+		result.build(std::move(offsets), std::move(labels), std::move(targets), this->m_layout);
+		result.m_initial_state = 0;
+		return result;
+	}
+
+	/**
+	 * Metodo statico.
+	 * Verifica se i due DFA riconoscono lo stesso linguaggio, tramite l'algoritmo di Hopcroft-Karp:
+	 * a partire dalla coppia degli stati iniziali, le coppie di stati raggiunte con la stessa label vengono
+	 * unite con una struttura union-find, e l'equivalenza fallisce se una classe contiene stati finali e non finali.
+	 * Le label sono confrontate per nome, quindi i due automi possono avere alfabeti diversi; le transizioni
+	 * non definite portano ad uno stato pozzo implicito (uno per ciascun automa).
+	 */
+	bool TableDFA::equivalent(const TableDFA& first, const TableDFA& second) {
+		uint32_t first_sink = first.size();
+		uint32_t second_offset = first.size() + 1;
+		uint32_t second_sink = second.size();
+		uint32_t nodes_count = second_offset + second.size() + 1;
+
+		// Coppie di identificatori per ciascuna label dell'unione degli alfabeti
+		// Nota: l'identificatore sconosciuto di un alfabeto non ha transizioni definite
+		vector<pair<LabelId, LabelId>> labels;
+		const LabelIndex& first_index = first.getLabelIndex();
+		const LabelIndex& second_index = second.getLabelIndex();
+		for (LabelId label = 0; label < first_index.size(); label++) {
+			labels.push_back({ label, second_index.getId(first_index.getLabel(label)) });
+		}
+		for (LabelId label = 0; label < second_index.size(); label++) {
+			if (first_index.getId(second_index.getLabel(label)) == first_index.getUnknownId()) {
+				labels.push_back({ first_index.getUnknownId(), label });
+			}
+		}
+
+		vector<uint32_t> parents(nodes_count);
+		std::iota(parents.begin(), parents.end(), 0);
+		auto find = [&parents](uint32_t node) {
+			while (parents[node] != node) {
+				parents[node] = parents[parents[node]];
+				node = parents[node];
+			}
+			return node;
+		};
+		auto first_node = [first_sink](uint32_t state) {
+			return (state == TABLE_DFA_NO_STATE) ? first_sink : state;
+		};
+		auto second_node = [second_sink](uint32_t state) {
+			return (state == TABLE_DFA_NO_STATE) ? second_sink : state;
+		};
+
+		vector<pair<uint32_t, uint32_t>> stack;
+		uint32_t first_initial = first_node(first.getInitialState());
+		uint32_t second_initial = second_node(second.getInitialState());
+		parents[find(first_initial)] = find(second_offset + second_initial);
+		stack.push_back({ first_initial, second_initial });
+		while (!stack.empty()) {
+			uint32_t first_state = stack.back().first;
+			uint32_t second_state = stack.back().second;
+			stack.pop_back();
+
+			bool first_final = (first_state != first_sink) && first.isFinal(first_state);
+			bool second_final = (second_state != second_sink) && second.isFinal(second_state);
+			if (first_final != second_final) {
+				return false;
+			}
+
+			for (auto &label : labels) {
+				uint32_t first_child = (first_state == first_sink) ? first_sink : first_node(first.getChild(first_state, label.first));
+				uint32_t second_child = (second_state == second_sink) ? second_sink : second_node(second.getChild(second_state, label.second));
+				uint32_t first_root = find(first_child);
+				uint32_t second_root = find(second_offset + second_child);
+				if (first_root != second_root) {
+					parents[first_root] = second_root;
+					stack.push_back({ first_child, second_child });
+				}
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Converte l'automa in un DFA, con stati omonimi a quelli dell'automa tabellare.
+	 */
+	DFA* TableDFA::toDFA() const {
+		DFA* dfa = new DFA();
+		vector<StateDFA*> states;
+		states.reserve(this->size());
+		for (uint32_t i = 0; i < this->size(); i++) {
+			StateDFA* state = new StateDFA(this->getName(i), this->isFinal(i));
+			states.push_back(state);
+			dfa->addState(state);
+		}
+
+		for (uint32_t i = 0; i < this->size(); i++) {
+			for (auto &transition : this->getTransitions(i)) {
+				states[i]->connectChild(this->m_label_index.getLabel(transition.first), states[transition.second]);
+			}
+		}
+
+		if (this->m_initial_state != TABLE_DFA_NO_STATE) {
+			dfa->setInitialState(states[this->m_initial_state]);
+		}
+		return dfa;
+	}
+
+} /* namespace translated_automata */
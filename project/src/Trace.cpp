@@ -0,0 +1,150 @@
+/*
+ * Trace.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione del buffer circolare di eventi utilizzato per il tracciamento
+ * strutturato degli algoritmi.
+ *
+ * Formato del file di traccia (little-endian, come in memoria):
+ * - magic TRACE_FILE_MAGIC (8 byte) e versione (uint32)
+ * - numero di label (uint32), seguito da ciascuna label come (lunghezza uint32, caratteri)
+ * - numero totale di eventi registrati (uint64) e numero di eventi salvati (uint64)
+ * - eventi salvati, in ordine cronologico, come record TraceEvent
+ *
+ */
+
+#include "Trace.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Metodo statico.
+	 * Restituisce il nome della tipologia di evento.
+	 */
+	string TraceBuffer::nameOf(TraceEventType type) {
+		switch (type) {
+		case TRACE_BUD_POPPED :				return "BUD_POPPED";
+		case TRACE_BUD_ADDED :				return "BUD_ADDED";
+		case TRACE_RULE_FIRED :				return "RULE_FIRED";
+		case TRACE_STATE_CREATED :			return "STATE_CREATED";
+		case TRACE_STATE_REMOVED :			return "STATE_REMOVED";
+		case TRACE_EXTENSION_UPDATED :		return "EXTENSION_UPDATED";
+		case TRACE_DISTANCE_RELOCATED :		return "DISTANCE_RELOCATED";
+		default :							return "UNKNOWN";
+		}
+	}
+
+	/**
+	 * Metodo statico.
+	 * Restituisce il buffer privato del thread corrente.
+	 */
+	TraceBuffer& TraceBuffer::local() {
+		thread_local TraceBuffer buffer;
+		return buffer;
+	}
+
+	/**
+	 * Costruttore.
+	 * Lo spazio per gli eventi viene allocato solamente alla prima registrazione.
+	 * La label vuota (EPSILON) occupa sempre l'indice TRACE_NO_LABEL.
+	 */
+	TraceBuffer::TraceBuffer() {
+		this->m_start = std::chrono::steady_clock::now();
+		this->internLabel("");
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	TraceBuffer::~TraceBuffer() {}
+
+	/**
+	 * Restituisce l'indice della label all'interno della tabella, aggiungendola se non presente.
+	 */
+	TraceLabel TraceBuffer::internLabel(const string& label) {
+		auto it = this->m_label_ids.find(label);
+		if (it != this->m_label_ids.end()) {
+			return it->second;
+		}
+		TraceLabel id = this->m_labels.size();
+		this->m_labels.push_back(label);
+		this->m_label_ids[label] = id;
+		return id;
+	}
+
+	/**
+	 * Registra un evento nel buffer.
+	 * Se il buffer è pieno, viene sovrascritto l'evento più vecchio.
+	 */
+	void TraceBuffer::record(TraceEventType type, uint8_t level, uint32_t state_id, TraceLabel label, int64_t value) {
+		if (this->m_events.empty()) {
+			this->m_events.resize(TRACE_BUFFER_CAPACITY);
+		}
+		TraceEvent& event = this->m_events[this->m_recorded & (TRACE_BUFFER_CAPACITY - 1)];
+		event.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->m_start).count();
+		event.state = state_id;
+		event.value = value;
+		event.label = label;
+		event.type = type;
+		event.level = level;
+		event.padding = 0;
+		this->m_recorded++;
+	}
+
+	/**
+	 * Salva su file il contenuto del buffer, secondo il formato descritto in testa a questo file.
+	 * Restituisce TRUE se il salvataggio è avvenuto correttamente.
+	 */
+	bool TraceBuffer::dump(string file_name) {
+		std::ofstream file_out(file_name, std::ios::binary);
+		if (!file_out) {
+			DEBUG_LOG_ERROR("Impossibile aprire il file di traccia %s", file_name.c_str());
+			return false;
+		}
+
+		// Intestazione
+		uint32_t version = TRACE_FILE_VERSION;
+		file_out.write(TRACE_FILE_MAGIC, strlen(TRACE_FILE_MAGIC));
+		file_out.write((const char*) &version, sizeof(version));
+
+		// Tabella delle label
+		uint32_t labels_count = this->m_labels.size();
+		file_out.write((const char*) &labels_count, sizeof(labels_count));
+		for (string& label : this->m_labels) {
+			uint32_t length = label.size();
+			file_out.write((const char*) &length, sizeof(length));
+			file_out.write(label.data(), length);
+		}
+
+		// Eventi, a partire dal più vecchio ancora presente nel buffer
+		uint64_t stored = (this->m_recorded < TRACE_BUFFER_CAPACITY) ? this->m_recorded : TRACE_BUFFER_CAPACITY;
+		file_out.write((const char*) &this->m_recorded, sizeof(this->m_recorded));
+		file_out.write((const char*) &stored, sizeof(stored));
+		for (uint64_t i = this->m_recorded - stored; i < this->m_recorded; i++) {
+			file_out.write((const char*) &this->m_events[i & (TRACE_BUFFER_CAPACITY - 1)], sizeof(TraceEvent));
+		}
+
+		return (bool) file_out;
+	}
+
+	/**
+	 * Svuota il buffer, mantenendo la tabella delle label.
+	 */
+	void TraceBuffer::clear() {
+		this->m_recorded = 0;
+	}
+
+	/**
+	 * Restituisce il numero totale di eventi registrati (compresi quelli sovrascritti).
+	 */
+	uint64_t TraceBuffer::getRecordedCount() {
+		return this->m_recorded;
+	}
+
+} /* namespace translated_automata */
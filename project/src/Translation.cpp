@@ -72,12 +72,14 @@ namespace translated_automata {
 	 * Se la stringa è associata ad una stringa specifica all'interno della traduzione,
 	 * questa funzione restituisce la stringa tradotta.
 	 * Altrimenti viene restituita la stringa originaria.
+	 * Per tradurre molte label (o interi automi) conviene utilizzare una CompiledTranslation.
 	 */
-	string Translation::translate(string label) {
-		// Verifico se la label originale è presente nella traduzione
-		if (this->m_translation_map.count(label)) {
+	string Translation::translate(const string& label) {
+		// Verifico se la label originale è presente nella traduzione (con un'unica ricerca)
+		auto search = this->m_translation_map.find(label);
+		if (search != this->m_translation_map.end()) {
 			// Nel caso sia presente, la "traduco"
-			return this->m_translation_map[label];
+			return search->second;
 		} else {
 			// Altrimenti, se la label NON è presente, viene lasciata inalterata
 			return label;
@@ -106,35 +108,96 @@ namespace translated_automata {
 	NFA* Translation::translate(DFA* dfa) {
 		// Istanzio un automa NFA, che verrà restituito in output al termine
 		NFA* translated_nfa = new NFA();
-		// Istanzio un dizionario per associare agli stati originali quelli nuovi.
-		std::map<StateDFA*, StateNFA*> states_map = map<StateDFA*, StateNFA*>();
+		// L'NFA tradotto è destinato alla Subset Construction, che non utilizza le transizioni entranti
+		translated_nfa->setForwardOnly();
+		// Istanzio un vettore per associare agli stati originali quelli nuovi, indicizzato per identificatore.
+		vector<StateDFA*> states = dfa->getStatesVector();
+		vector<StateNFA*> states_map(states.size());
 
 		// Creo le copie degli stati, per il momento senza transizioni
-		for (StateDFA* state : dfa->getStatesVector()) {
+		for (StateDFA* state : states) {
 			StateNFA* new_state = new StateNFA(state->getName(), state->isFinal());
-			states_map[state] = new_state;
+			states_map[state->getId()] = new_state;
 			translated_nfa->addState(new_state);
 		}
 
 		// Creo e collego le transizioni (tradotte!)
-		for (auto &states_pair : states_map) {
+		for (StateDFA* state : states) {
+			StateNFA* new_state = states_map[state->getId()];
 
 			// Per ciascuna transizione uscente dallo stato DFA originale
-			for (auto &trans_pair : states_pair.first->getExitingTransitionsRef()) {
+			for (auto &trans_pair : state->getExitingTransitionsRef()) {
+				// La label viene tradotta una sola volta per tutti i figli
+				string translated_label = this->translate(trans_pair.first);
 				for (StateDFA* child : trans_pair.second) {
 
 					// Creo la transizione corrispondente nello stato NFA associato
-					states_pair.second->connectChild(this->translate(trans_pair.first), states_map[child]);
-					// Nota: questo crea anche le transizioni entranti nei figli, in automatico.
+					new_state->connectChild(translated_label, states_map[child->getId()]);
+					// Nota: le transizioni entranti nei figli non vengono create, poiché l'NFA è costruito in avanti.
 				}
 			}
 		}
 		// Impostazione dello stato iniziale
-		translated_nfa->setInitialState(states_map[dfa->getInitialState()]);
+		if (dfa->getInitialState() != NULL) {
+			translated_nfa->setInitialState(states_map[dfa->getInitialState()->getId()]);
+		}
 
 		return translated_nfa;
 	}
 
+	/**
+	 * Restituisce la composizione di questa traduzione con quella passata come parametro, ossia
+	 * la traduzione (this ∘ first) che equivale ad applicare prima "first" e poi questa traduzione.
+	 * In questo modo una catena di traduzioni può essere applicata ad un automa in un unico passaggio,
+	 * senza generare gli automi intermedi.
+	 * Le label tradotte da "first" in EPSILON rimangono EPSILON.
+	 */
+	Translation* Translation::compose(Translation* first) {
+		map<string, string> composed_map;
+		// Il dominio delle associazioni non identiche è contenuto nell'unione dei due domini
+		for (auto &pair : first->m_translation_map) {
+			composed_map[pair.first] = this->translate(pair.second);
+		}
+		for (auto &pair : this->m_translation_map) {
+			if (first->m_translation_map.count(pair.first) == 0) {
+				composed_map[pair.first] = pair.second;
+			}
+		}
+		// Il costruttore scarta le associazioni divenute identiche
+		return new Translation(composed_map);
+	}
+
+	/**
+	 * Restituisce la controimmagine di una label rispetto all'alfabeto passato come parametro,
+	 * ossia tutte le label dell'alfabeto che vengono tradotte nella label specificata.
+	 */
+	Alphabet Translation::preimage(const string& label, const Alphabet& alpha) {
+		Alphabet labels;
+		for (const string& source : alpha) {
+			if (this->translate(source) == label) {
+				labels.push_back(source);
+			}
+		}
+		return labels;
+	}
+
+	/**
+	 * Restituisce la traduzione inversa, definita sull'alfabeto tradotto.
+	 * L'inversa esiste solamente se la traduzione è iniettiva sull'alfabeto e non produce EPSILON;
+	 * in caso contrario viene lanciata un'eccezione.
+	 */
+	Translation* Translation::inverse(const Alphabet& alpha) {
+		map<string, string> inverse_map;
+		for (const string& source : alpha) {
+			string target = this->translate(source);
+			if (target == EPSILON || inverse_map.count(target) > 0) {
+				throw "Impossibile invertire una traduzione non iniettiva o che produce epsilon-transizioni";
+			}
+			inverse_map[target] = source;
+		}
+		return new Translation(inverse_map);
+	}
+
 	/**
 	 * Restituisce una descrizione testuale della traduzione, come lista
 	 * delle associazioni.
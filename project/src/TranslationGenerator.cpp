@@ -23,9 +23,10 @@ namespace translated_automata {
 
 	/** Costruttore */
 	TranslationGenerator::TranslationGenerator(Configurations* configurations) {
-		this->m_mixing_factor = configurations->valueOf<double>(TranslationMixingFactor);
-		this->m_offset = configurations->valueOf<double>(TranslationOffset);
-		this->m_epsilon_percentage = configurations->valueOf<double>(EpsilonPercentage);
+		const ConfigurationsSnapshot& config = configurations->getSnapshot();
+		this->m_mixing_factor = config.translation_mixing_factor;
+		this->m_offset = config.translation_offset;
+		this->m_epsilon_percentage = config.epsilon_percentage;
 	}
 
 	/** Distruttore */
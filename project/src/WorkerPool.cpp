@@ -0,0 +1,119 @@
+/*
+ * WorkerPool.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione della classe "WorkerPool", che esegue gruppi di compiti in parallelo
+ * su un insieme di thread creati una sola volta.
+ *
+ */
+
+#include "WorkerPool.hpp"
+
+#include "Debug.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Costruttore.
+	 * Avvia il numero indicato di worker, che restano in attesa del primo gruppo di compiti.
+	 * Con zero worker, ogni gruppo viene eseguito interamente dal thread chiamante.
+	 */
+	WorkerPool::WorkerPool(unsigned int workers_count) {
+		for (unsigned int i = 0; i < workers_count; i++) {
+			this->m_workers.emplace_back(&WorkerPool::runWorker, this);
+		}
+	}
+
+	/**
+	 * Distruttore.
+	 * Segnala la terminazione ai worker e attende che ciascuno di essi termini.
+	 */
+	WorkerPool::~WorkerPool() {
+		{
+			std::lock_guard<std::mutex> lock(this->m_mutex);
+			this->m_stopping = true;
+		}
+		this->m_tasks_available.notify_all();
+		for (std::thread& worker : this->m_workers) {
+			worker.join();
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Ciclo eseguito da ciascun worker: attende un compito disponibile, lo esegue senza
+	 * detenere il lock e ripete, fino alla terminazione del pool.
+	 */
+	void WorkerPool::runWorker() {
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		while (true) {
+			this->m_tasks_available.wait(lock, [this] {
+				return this->m_stopping || this->m_next_task < this->m_tasks_count;
+			});
+			if (this->m_stopping) {
+				return;
+			}
+			this->takeTask(lock);
+		}
+	}
+
+	/**
+	 * Metodo privato.
+	 * Assegna al thread corrente il prossimo compito del gruppo, se presente, e lo esegue.
+	 * Il lock deve essere detenuto alla chiamata; viene rilasciato durante l'esecuzione del compito
+	 * e riacquisito prima di restituire il controllo.
+	 * Restituisce FALSE se non ci sono più compiti da assegnare.
+	 */
+	bool WorkerPool::takeTask(std::unique_lock<std::mutex>& lock) {
+		if (this->m_next_task >= this->m_tasks_count) {
+			return false;
+		}
+		unsigned long int index = this->m_next_task++;
+		lock.unlock();
+		this->m_task(index);
+		lock.lock();
+		if (--this->m_pending_tasks == 0) {
+			this->m_tasks_completed.notify_all();
+		}
+		return true;
+	}
+
+	/**
+	 * Restituisce il numero di worker del pool (escluso il thread chiamante).
+	 */
+	unsigned int WorkerPool::getWorkersCount() {
+		return this->m_workers.size();
+	}
+
+	/**
+	 * Esegue i compiti di indice 0, 1, ..., N-1 in parallelo fra i worker e il thread chiamante,
+	 * restituendo il controllo solo dopo che sono tutti terminati.
+	 * L'ordine di esecuzione non è specificato: ciascun compito deve accedere solo a dati
+	 * in sola lettura o riservati al proprio indice.
+	 * Il metodo non è rientrante: non può essere chiamato da un compito o da più thread contemporaneamente.
+	 */
+	void WorkerPool::run(unsigned long int tasks_count, std::function<void(unsigned long int)> task) {
+		if (tasks_count == 0) {
+			return;
+		}
+		std::unique_lock<std::mutex> lock(this->m_mutex);
+		DEBUG_ASSERT_TRUE( this->m_pending_tasks == 0 );
+		this->m_task = std::move(task);
+		this->m_tasks_count = tasks_count;
+		this->m_next_task = 0;
+		this->m_pending_tasks = tasks_count;
+		this->m_tasks_available.notify_all();
+
+		// Il thread chiamante partecipa all'esecuzione dei compiti
+		while (this->takeTask(lock));
+		this->m_tasks_completed.wait(lock, [this] {
+			return this->m_pending_tasks == 0;
+		});
+
+		this->m_task = nullptr;
+		this->m_tasks_count = 0;
+		this->m_next_task = 0;
+	}
+
+} /* namespace translated_automata */
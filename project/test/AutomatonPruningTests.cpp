@@ -0,0 +1,108 @@
+/*
+ * AutomatonPruningTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della procedura "Automaton Pruning" di ESC, eseguita durante la traduzione completa
+ * (runAutomatonTranslation) quando un bud genera un'estensione vuota: devono essere rimossi
+ * tutti e soli gli stati che non sono più raggiungibili.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include <algorithm>
+
+#include "Configurations.hpp"
+#include "EmbeddedSubsetConstruction.hpp"
+#include "Translation.hpp"
+
+#define PRUNING_TEST_CASES 		5000	// Numero di DFA casuali tradotti
+
+namespace translated_automata {
+
+	/**
+	 * Traduce il DFA con ESC (traduzione completa) e verifica che il risultato coincida
+	 * con la Subset Construction dell'NFA tradotto.
+	 */
+	static bool isTranslatedLikeSubsetConstruction(EmbeddedSubsetConstruction& esc, DFA* dfa, Translation* translation) {
+		esc.runAutomatonTranslation(dfa, translation);
+		esc.runBudProcessing();
+		DFA* result = esc.getResult();
+
+		NFA* nfa = translation->translate(dfa);
+		bool equal = isSubsetConstructionOf(result, nfa);
+		delete nfa;
+		delete result;
+		return equal;
+	}
+
+	/**
+	 * Caso minimo in cui, durante il ciclo (2) dell'Automaton Pruning, uno stato ha come unico genitore
+	 * con distanza inferiore un altro candidato, che risulta raggiungibile solo quando viene esaminato
+	 * successivamente. Lo stato deve comunque essere ricontrollato fra i possibili entry points;
+	 * in caso contrario viene rimosso, e il DFA risultante perde degli stati raggiungibili.
+	 *
+	 * 	q0 --a--> q2,  q0 --c,d--> q1,  q0 --e--> q0,  q1 --c--> q1,  q1 --d,e--> q0,  q2 --b--> q2
+	 *
+	 * La traduzione rende epsilon-transizioni le label "a", "d" ed "e".
+	 */
+	TEST(PruningKeepsStatesWithLaterReachableCandidateParents) {
+		Translation translation = Translation({ { "a", EPSILON }, { "b", "c" }, { "c", "d" }, { "d", EPSILON }, { "e", EPSILON } });
+		Configurations configurations = Configurations();
+		configurations.load();
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+
+		// Gli stati sono ordinati per indirizzo in tutte le strutture dell'automa: il caso viene ripetuto
+		// per ogni ordine di allocazione, così che l'ordine di esame dei candidati non dipenda dall'allocatore
+		vector<unsigned int> allocation_order = { 0, 1, 2 };
+		do {
+			vector<StateDFA*> states(3);
+			for (unsigned int i : allocation_order) {
+				states[i] = new StateDFA("q" + std::to_string(i), i == 2);
+			}
+			DFA* dfa = new DFA();
+			for (StateDFA* state : states) {
+				dfa->addState(state);
+			}
+			dfa->setInitialState(states[0]);
+			dfa->connectStates(states[0], states[2], "a");
+			dfa->connectStates(states[0], states[1], "c");
+			dfa->connectStates(states[0], states[1], "d");
+			dfa->connectStates(states[0], states[0], "e");
+			dfa->connectStates(states[1], states[1], "c");
+			dfa->connectStates(states[1], states[0], "d");
+			dfa->connectStates(states[1], states[0], "e");
+			dfa->connectStates(states[2], states[2], "b");
+
+			ASSERT_TRUE( isTranslatedLikeSubsetConstruction(esc, dfa, &translation) );
+			delete dfa;
+		} while (std::next_permutation(allocation_order.begin(), allocation_order.end()));
+	}
+
+	/**
+	 * Traduzioni casuali di DFA casuali, in cui alcune label diventano epsilon-transizioni (e quindi
+	 * generano estensioni vuote e l'Automaton Pruning), producono lo stesso risultato della Subset Construction.
+	 */
+	TEST(TranslationWithPruningMatchesSubsetConstruction) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+
+		for (unsigned int seed = 0; seed < PRUNING_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(8), alphabet);
+
+			map<string, string> translation_map;
+			for (string label : alphabet) {
+				translation_map[label] = random.chance(30) ? EPSILON : alphabet[random.next(alphabet.size())];
+			}
+			Translation translation = Translation(translation_map);
+			ASSERT_TRUE( isTranslatedLikeSubsetConstruction(esc, dfa, &translation) );
+			delete dfa;
+		}
+	}
+
+} /* namespace translated_automata */
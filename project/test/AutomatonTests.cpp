@@ -0,0 +1,226 @@
+/*
+ * AutomatonTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test degli identificatori densi assegnati dall'automa ai propri stati: gli identificatori
+ * devono restare compresi fra 0 e n-1 dopo ogni rimozione, e ciascuno stato deve trovarsi
+ * nella posizione corrispondente al proprio identificatore.
+ * Inoltre, l'indice delle transizioni entranti costruito in blocco su un automa "in avanti" deve
+ * coincidere con quello mantenuto incrementalmente.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "Automaton.hpp"
+
+#define INCOMING_INDEX_TEST_CASES 	300		// Numero di NFA casuali
+
+namespace translated_automata {
+
+	/**
+	 * Verifica che gli identificatori degli stati dell'automa siano 0, 1, ..., n-1 e corrispondano
+	 * alle posizioni degli stati.
+	 */
+	static bool hasDenseIds(DFA* dfa) {
+		vector<StateDFA*> states = dfa->getStatesVector();
+		if (states.size() != (unsigned long int) dfa->size()) {
+			return false;
+		}
+		for (unsigned int id = 0; id < states.size(); id++) {
+			if (states[id]->getId() != id || dfa->getStateById(id) != states[id] || !dfa->hasState(states[id])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * La rimozione di uno stato assegna il suo identificatore all'ultimo stato, lasciando invariati
+	 * gli identificatori degli altri; la rimozione di uno stato non appartenente all'automa non ha effetto.
+	 */
+	TEST(RemoveStateMovesLastStateIntoFreedId) {
+		DFA* dfa = new DFA();
+		vector<StateDFA*> states;
+		for (unsigned int i = 0; i < 5; i++) {
+			states.push_back(new StateDFA("q" + std::to_string(i)));
+			dfa->addState(states.back());
+			ASSERT_EQUAL( i, states.back()->getId() );
+		}
+		dfa->setInitialState(states[0]);
+		dfa->connectStates(states[0], states[1], "a");
+		dfa->connectStates(states[1], states[4], "a");
+
+		// Un secondo inserimento dello stesso stato non ha effetto
+		dfa->addState(states[2]);
+		ASSERT_EQUAL( 5, dfa->size() );
+
+		ASSERT_TRUE( dfa->removeState(states[1]) );
+		ASSERT_EQUAL( STATE_NO_ID, states[1]->getId() );
+		ASSERT_FALSE( dfa->hasState(states[1]) );
+		ASSERT_EQUAL( 1, states[4]->getId() );
+		ASSERT_EQUAL( 0, states[0]->getId() );
+		ASSERT_EQUAL( 2, states[2]->getId() );
+		ASSERT_EQUAL( 3, states[3]->getId() );
+		ASSERT_TRUE( hasDenseIds(dfa) );
+		ASSERT_TRUE( states[0]->getChild("a") == NULL );
+
+		// Lo stato rimosso non appartiene più all'automa: una seconda rimozione non ha effetto
+		StateDFA* outsider = new StateDFA("outsider");
+		outsider->connectChild("b", states[3]);
+		ASSERT_FALSE( dfa->removeState(states[1]) );
+		ASSERT_FALSE( dfa->removeState(outsider) );
+		ASSERT_TRUE( outsider->getChild("b") == states[3] );
+		ASSERT_EQUAL( 4, dfa->size() );
+		outsider->detachAllTransitions();
+		delete outsider;
+		delete states[1];
+
+		// Rimozione dell'ultimo stato
+		ASSERT_TRUE( dfa->removeState(states[3]) );
+		ASSERT_TRUE( hasDenseIds(dfa) );
+		delete states[3];
+
+		delete dfa;
+	}
+
+	/**
+	 * La rimozione degli stati irraggiungibili compatta gli identificatori mantenendo l'ordine relativo
+	 * degli stati rimanenti.
+	 */
+	TEST(RemoveUnreachableStatesCompactsIdsInOrder) {
+		DFA* dfa = new DFA();
+		vector<StateDFA*> states;
+		for (unsigned int i = 0; i < 6; i++) {
+			states.push_back(new StateDFA("q" + std::to_string(i)));
+			dfa->addState(states.back());
+		}
+		dfa->setInitialState(states[0]);
+		dfa->connectStates(states[0], states[2], "a");
+		dfa->connectStates(states[2], states[5], "a");
+		dfa->connectStates(states[1], states[3], "a");
+
+		set<StateDFA*> unreachable = dfa->removeUnreachableStates();
+		ASSERT_EQUAL( 3, unreachable.size() );
+		ASSERT_TRUE( hasDenseIds(dfa) );
+		vector<StateDFA*> expected_order = { states[0], states[2], states[5] };
+		ASSERT_TRUE( dfa->getStatesVector() == expected_order );
+		for (StateDFA* state : unreachable) {
+			ASSERT_EQUAL( STATE_NO_ID, state->getId() );
+			state->detachAllTransitions();
+			delete state;
+		}
+
+		delete dfa;
+	}
+
+	/**
+	 * Restituisce le transizioni entranti dello stato, con i genitori rappresentati dal nome, in modo
+	 * da poter confrontare stati omonimi di automi diversi.
+	 */
+	static map<string, set<string>> getIncomingTransitionsByName(StateNFA* state) {
+		map<string, set<string>> transitions;
+		for (auto &pair : state->getIncomingTransitions()) {
+			for (StateNFA* parent : pair.second) {
+				transitions[pair.first].insert(parent->getName());
+			}
+		}
+		return transitions;
+	}
+
+	/**
+	 * Copia l'NFA in un automa "in avanti", con stati omonimi e con gli stessi identificatori.
+	 */
+	static NFA* buildForwardOnlyCopy(NFA* nfa) {
+		NFA* copy = new NFA();
+		copy->setForwardOnly();
+		for (StateNFA* state : nfa->getStatesVector()) {
+			copy->addState(new StateNFA(state->getName(), state->isFinal()));
+		}
+		for (StateNFA* state : nfa->getStatesVector()) {
+			for (auto &pair : state->getExitingTransitionsRef()) {
+				for (StateNFA* child : pair.second) {
+					copy->connectStates(copy->getStateById(state->getId()), copy->getStateById(child->getId()), pair.first);
+				}
+			}
+		}
+		copy->setInitialState(copy->getStateById(nfa->getInitialState()->getId()));
+		return copy;
+	}
+
+	/**
+	 * L'indice delle transizioni entranti costruito in blocco coincide con quello mantenuto ad ogni
+	 * nuova transizione, e resta aggiornato dalle modifiche successive alla costruzione.
+	 */
+	TEST(BuiltIncomingIndexMatchesIncrementalIndex) {
+		for (unsigned int seed = 0; seed < INCOMING_INDEX_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			NFA* nfa = buildRandomNFA(random, 3 + random.next(10), alphabet, 20);
+			NFA* copy = buildForwardOnlyCopy(nfa);
+
+			ASSERT_TRUE( nfa->hasIncomingIndex() );
+			ASSERT_FALSE( copy->hasIncomingIndex() );
+			for (StateNFA* state : copy->getStatesVector()) {
+				ASSERT_FALSE( state->hasIncomingIndex() );
+				ASSERT_TRUE( state->getIncomingTransitionsRef().empty() );
+			}
+
+			copy->buildIncomingIndex();
+			ASSERT_TRUE( copy->hasIncomingIndex() );
+			for (StateNFA* state : nfa->getStatesVector()) {
+				StateNFA* copied_state = copy->getStateById(state->getId());
+				ASSERT_TRUE( copied_state->hasIncomingIndex() );
+				ASSERT_TRUE( getIncomingTransitionsByName(state) == getIncomingTransitionsByName(copied_state) );
+			}
+
+			// Dopo la costruzione, le nuove transizioni e le rimozioni aggiornano l'indice
+			StateNFA* parent = nfa->getStateById(random.next(nfa->size()));
+			StateNFA* child = nfa->getStateById(random.next(nfa->size()));
+			nfa->connectStates(parent, child, alphabet[0]);
+			copy->connectStates(copy->getStateById(parent->getId()), copy->getStateById(child->getId()), alphabet[0]);
+			StateNFA* removed = nfa->getStateById(random.next(nfa->size()));
+			if (removed != nfa->getInitialState()) {
+				StateNFA* copied_removed = copy->getStateById(removed->getId());
+				ASSERT_TRUE( nfa->removeState(removed) );
+				ASSERT_TRUE( copy->removeState(copied_removed) );
+				delete removed;
+				delete copied_removed;
+			}
+			for (StateNFA* state : nfa->getStatesVector()) {
+				ASSERT_TRUE( getIncomingTransitionsByName(state) == getIncomingTransitionsByName(copy->getStateById(state->getId())) );
+			}
+
+			delete copy;
+			delete nfa;
+		}
+	}
+
+	/**
+	 * La rimozione di uno stato da un automa "in avanti" costruisce l'indice delle transizioni entranti,
+	 * necessario a disconnettere i genitori dello stato rimosso.
+	 */
+	TEST(RemoveStateBuildsIncomingIndex) {
+		NFA* nfa = new NFA();
+		nfa->setForwardOnly();
+		StateNFA* initial_state = new StateNFA("q0");
+		StateNFA* removed_state = new StateNFA("q1", true);
+		nfa->addState(initial_state);
+		nfa->addState(removed_state);
+		nfa->setInitialState(initial_state);
+		nfa->connectStates(initial_state, removed_state, "a");
+		nfa->connectStates(removed_state, removed_state, "b");
+
+		ASSERT_TRUE( nfa->removeState(removed_state) );
+		ASSERT_TRUE( nfa->hasIncomingIndex() );
+		ASSERT_TRUE( initial_state->getExitingTransitionsRef().at("a").empty() );
+		ASSERT_EQUAL( 0, removed_state->getIncomingTransitionsCount() );
+		ASSERT_EQUAL( 0, removed_state->getExitingTransitionsCount() );
+		delete removed_state;
+
+		delete nfa;
+	}
+
+} /* namespace translated_automata */
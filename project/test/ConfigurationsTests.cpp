@@ -0,0 +1,183 @@
+/*
+ * ConfigurationsTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test dell'istantanea tipizzata delle configurazioni (ConfigurationsSnapshot): per ogni caso di test,
+ * i campi dell'istantanea devono coincidere con i valori restituiti dalle configurazioni, anche quando
+ * l'istantanea è stata richiesta prima del passaggio al caso successivo, e la stringa dei parametri
+ * di test deve essere aggiornata insieme all'istantanea.
+ * Inoltre, test del caricamento delle configurazioni tramite assegnamenti "Parametro=Valore": liste,
+ * intervalli additivi e moltiplicativi, e rifiuto degli assegnamenti non validi.
+ *
+ */
+
+#include "Test.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Configurations.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Verifica che i campi dell'istantanea coincidano con i valori correnti delle configurazioni.
+	 */
+	static bool matchesConfigurations(const ConfigurationsSnapshot& snapshot, Configurations& configurations) {
+		return snapshot.testcases == configurations.valueOf<int>(Testcases)
+				&& snapshot.problem_type == configurations.valueOf<int>(ProblemType)
+				&& snapshot.alphabet_cardinality == (unsigned int) configurations.valueOf<int>(AlphabetCardinality)
+				&& snapshot.translation_mixing_factor == configurations.valueOf<double>(TranslationMixingFactor)
+				&& snapshot.epsilon_percentage == configurations.valueOf<double>(EpsilonPercentage)
+				&& snapshot.automaton_structure == configurations.valueOf<int>(AutomatonStructure)
+				&& snapshot.automaton_size == (unsigned int) configurations.valueOf<int>(AutomatonSize)
+				&& snapshot.automaton_final_probability == configurations.valueOf<double>(AutomatonFinalProbability)
+				&& snapshot.automaton_max_distance == configurations.valueOf<int>(AutomatonMaxDistance)
+				&& snapshot.automaton_safe_zone_distance == configurations.valueOf<int>(AutomatonSafeZoneDistance)
+				&& snapshot.active_automaton_pruning == configurations.valueOf<bool>(ActiveAutomatonPruning)
+				&& snapshot.active_wavefront_processing == configurations.valueOf<bool>(ActiveWavefrontProcessing)
+				&& snapshot.active_result_cache == configurations.valueOf<bool>(ActiveResultCache)
+				&& snapshot.result_cache_capacity == configurations.valueOf<int>(ResultCacheCapacity)
+				&& snapshot.print_statistics == configurations.valueOf<bool>(PrintStatistics)
+				&& snapshot.draw_esc_solution == configurations.valueOf<bool>(DrawESCSOlution);
+	}
+
+	/**
+	 * L'istantanea segue tutti i casi di test: il riferimento restituito resta valido e viene aggiornato
+	 * al primo accesso successivo al cambio di caso, così come la stringa dei parametri di test.
+	 */
+	TEST(SnapshotFollowsEveryTestCase) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		const ConfigurationsSnapshot& snapshot = configurations.getSnapshot();
+
+		unsigned int test_cases = 0;
+		vector<string> value_strings;
+		do {
+			ASSERT_TRUE( &configurations.getSnapshot() == &snapshot );
+			ASSERT_TRUE( matchesConfigurations(snapshot, configurations) );
+			value_strings.push_back(configurations.getValueString());
+			test_cases++;
+		} while (configurations.nextTestCase());
+
+		// I casi di test sono tutte le combinazioni dei parametri multi-valore, ciascuna con la propria stringa
+		ASSERT_TRUE( test_cases > 1 );
+		std::sort(value_strings.begin(), value_strings.end());
+		ASSERT_TRUE( std::adjacent_find(value_strings.begin(), value_strings.end()) == value_strings.end() );
+
+		// Al termine delle combinazioni, i parametri tornano ai primi valori
+		ASSERT_TRUE( matchesConfigurations(configurations.getSnapshot(), configurations) );
+	}
+
+	/**
+	 * Una copia dell'istantanea non viene modificata dal passaggio al caso di test successivo.
+	 */
+	TEST(SnapshotCopyIsIndependentOfLaterTestCases) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		ConfigurationsSnapshot first_case = configurations.getSnapshot();
+		string first_value_string = configurations.getValueString();
+
+		ASSERT_TRUE( configurations.nextTestCase() );
+		const ConfigurationsSnapshot& second_case = configurations.getSnapshot();
+		ASSERT_TRUE( matchesConfigurations(second_case, configurations) );
+		ASSERT_TRUE( first_case.automaton_size != second_case.automaton_size
+				|| first_case.automaton_max_distance != second_case.automaton_max_distance );
+		ASSERT_TRUE( first_value_string != configurations.getValueString() );
+	}
+
+	/**
+	 * Carica il solo assegnamento passato come parametro e restituisce, in ordine, tutti i valori
+	 * assunti dal parametro nei casi di test successivi.
+	 */
+	template <class T>
+	static vector<T> collectAssignedValues(const string& assignment, const SettingID& id) {
+		Configurations configurations = Configurations();
+		configurations.loadAssignment(assignment);
+		vector<T> values;
+		do {
+			values.push_back(configurations.valueOf<T>(id));
+		} while (configurations.nextTestCase());
+		return values;
+	}
+
+	/**
+	 * Verifica che il caricamento dell'assegnamento venga rifiutato con un'eccezione.
+	 */
+	static bool isRejected(const string& assignment) {
+		Configurations configurations = Configurations();
+		try {
+			configurations.loadAssignment(assignment);
+		} catch (const char*) {
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * Gli intervalli additivi e moltiplicativi producono tutti i valori compresi fra gli estremi,
+	 * eventualmente concatenati ad altri elementi della lista; il nome del parametro non distingue
+	 * fra maiuscole e minuscole, e gli spazi attorno a nome e valore vengono ignorati.
+	 */
+	TEST(AssignmentExpandsListsAndRanges) {
+		ASSERT_TRUE( (collectAssignedValues<int>("AutomatonSize=1000..10000:x2", AutomatonSize)
+				== vector<int>{1000, 2000, 4000, 8000}) );
+		ASSERT_TRUE( (collectAssignedValues<int>("AutomatonSize=1000..8000:*2", AutomatonSize)
+				== vector<int>{1000, 2000, 4000, 8000}) );
+		ASSERT_TRUE( (collectAssignedValues<int>("automatonsize = 10..20:+5", AutomatonSize)
+				== vector<int>{10, 15, 20}) );
+		ASSERT_TRUE( (collectAssignedValues<int>("AutomatonSize=3..5,7,100..300:100", AutomatonSize)
+				== vector<int>{3, 4, 5, 7, 100, 200, 300}) );
+		ASSERT_TRUE( (collectAssignedValues<int>("AutomatonSize=42", AutomatonSize) == vector<int>{42}) );
+		ASSERT_TRUE( (collectAssignedValues<double>("EpsilonPercentage=0,0.25,0.5", EpsilonPercentage)
+				== vector<double>{0, 0.25, 0.5}) );
+
+		// Gli elementi degli intervalli reali vengono calcolati dall'estremo iniziale, includendo quello finale
+		vector<double> range = collectAssignedValues<double>("EpsilonPercentage=0..1:0.1", EpsilonPercentage);
+		ASSERT_EQUAL( 11, range.size() );
+		for (unsigned int i = 0; i < range.size(); i++) {
+			ASSERT_TRUE( std::abs(range[i] - i * 0.1) < 1e-9 );
+		}
+
+		ASSERT_TRUE( (collectAssignedValues<bool>("ActiveAutomatonPruning=off", ActiveAutomatonPruning)
+				== vector<bool>{false}) );
+		ASSERT_TRUE( (collectAssignedValues<bool>("ACTIVEAUTOMATONPRUNING=Yes", ActiveAutomatonPruning)
+				== vector<bool>{true}) );
+	}
+
+	/**
+	 * Un assegnamento successivo sostituisce il valore caricato in precedenza, anche dai valori di default.
+	 */
+	TEST(AssignmentOverridesLoadedValue) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		configurations.loadAssignment("AutomatonSize=50");
+		configurations.loadAssignment("AutomatonMaxDistance=7");
+		ASSERT_EQUAL( 50, configurations.getSnapshot().automaton_size );
+		ASSERT_EQUAL( 7, configurations.getSnapshot().automaton_max_distance );
+		ASSERT_FALSE( configurations.nextTestCase() );
+	}
+
+	/**
+	 * Gli assegnamenti non validi vengono rifiutati: parametro sconosciuto, separatore mancante,
+	 * valore non interpretabile, valori multipli per un booleano e intervalli vuoti o infiniti.
+	 */
+	TEST(AssignmentRejectsInvalidValues) {
+		ASSERT_TRUE( isRejected("UnknownSetting=1") );
+		ASSERT_TRUE( isRejected("AutomatonSize") );
+		ASSERT_TRUE( isRejected("AutomatonSize=") );
+		ASSERT_TRUE( isRejected("AutomatonSize=ten") );
+		ASSERT_TRUE( isRejected("AutomatonSize=1.5") );
+		ASSERT_TRUE( isRejected("ActiveAutomatonPruning=maybe") );
+		ASSERT_TRUE( isRejected("ActiveAutomatonPruning=true,false") );
+		ASSERT_TRUE( isRejected("AutomatonSize=5..1") );
+		ASSERT_TRUE( isRejected("AutomatonSize=1..10:0") );
+		ASSERT_TRUE( isRejected("AutomatonSize=1..10:-1") );
+		ASSERT_TRUE( isRejected("AutomatonSize=1..10:x1") );
+		ASSERT_TRUE( isRejected("AutomatonSize=0..10:x2") );
+		ASSERT_TRUE( isRejected("EpsilonPercentage=0..1:0") );
+		ASSERT_FALSE( isRejected("AutomatonSize=1..10:x2") );
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,166 @@
+/*
+ * DenseAutomatonTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test delle rappresentazioni dense: il DenseNFA costruito su un NFA casuale e il DenseDFA costruito
+ * sul DFA prodotto dalla Subset Construction devono accettare le stesse parole, anche quando queste
+ * contengono label sconosciute o la label EPSILON, sia singolarmente sia in modalità batch e stream.
+ * Inoltre, tutti i kernel della modalità batch del DenseDFA devono produrre gli stessi risultati.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include <sstream>
+
+#include "DenseAutomaton.hpp"
+#include "SubsetConstruction.hpp"
+
+#define DENSE_TEST_CASES 			200		// Numero di NFA casuali
+#define DENSE_TEST_WORDS 			300		// Numero di parole valutate per ciascun NFA
+#define DENSE_TEST_MAX_LENGTH 		12		// Lunghezza massima delle parole
+
+namespace translated_automata {
+
+	/**
+	 * Genera parole casuali sulle label dell'alfabeto, comprese (raramente) una label sconosciuta
+	 * e la label EPSILON.
+	 */
+	static vector<vector<string>> buildRandomWords(TestRandom& random, const Alphabet& alphabet) {
+		vector<vector<string>> words(DENSE_TEST_WORDS);
+		for (vector<string>& word : words) {
+			unsigned int length = random.next(DENSE_TEST_MAX_LENGTH + 1);
+			for (unsigned int i = 0; i < length; i++) {
+				if (random.chance(2)) {
+					word.push_back("unknown");
+				} else if (random.chance(10)) {
+					word.push_back(EPSILON);
+				} else {
+					word.push_back(alphabet[random.next(alphabet.size())]);
+				}
+			}
+		}
+		return words;
+	}
+
+	/**
+	 * Converte le parole negli identificatori dell'indice, mantenendo la label EPSILON.
+	 * L'NFA e il DFA possono avere alfabeti diversi, e quindi identificatori diversi per la stessa label.
+	 */
+	static vector<vector<LabelId>> encodeWords(const vector<vector<string>>& words, const LabelIndex& index) {
+		vector<vector<LabelId>> encoded_words;
+		for (const vector<string>& word : words) {
+			vector<LabelId> encoded_word;
+			for (const string& label : word) {
+				encoded_word.push_back(index.getId(label));
+			}
+			encoded_words.push_back(encoded_word);
+		}
+		return encoded_words;
+	}
+
+	/**
+	 * Il DenseNFA e il DenseDFA accettano le stesse parole, con tutte le modalità di riconoscimento.
+	 */
+	TEST(DenseNFAMatchesDenseDFA) {
+		SubsetConstruction sc = SubsetConstruction();
+		for (unsigned int seed = 0; seed < DENSE_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(3));
+			NFA* nfa = buildRandomNFA(random, 4 + random.next(8), alphabet, 20);
+			DFA* dfa = sc.run(nfa);
+			DenseNFA dense_nfa = DenseNFA(nfa);
+			DenseDFA dense_dfa = DenseDFA(dfa);
+
+			vector<vector<string>> words = buildRandomWords(random, alphabet);
+			vector<vector<LabelId>> nfa_words = encodeWords(words, dense_nfa.getLabelIndex());
+			vector<vector<LabelId>> dfa_words = encodeWords(words, dense_dfa.getLabelIndex());
+			vector<uint8_t> nfa_results = dense_nfa.acceptsBatch(nfa_words, 1);
+			vector<uint8_t> dfa_results = dense_dfa.acceptsBatch(dfa_words, 1);
+			ASSERT_TRUE( nfa_results == dense_nfa.acceptsBatch(nfa_words, 4) );
+			ASSERT_TRUE( dfa_results == dense_dfa.acceptsBatch(dfa_words, 4) );
+			for (unsigned int w = 0; w < words.size(); w++) {
+				bool expected = dense_dfa.isFinal(dense_dfa.run(dense_dfa.getInitialState(), dfa_words[w].data(), dfa_words[w].size()));
+				ASSERT_EQUAL( expected, dense_nfa.accepts(nfa_words[w]) );
+				ASSERT_EQUAL( expected, dense_dfa.accepts(dfa_words[w]) );
+				ASSERT_EQUAL( expected, (bool) nfa_results[w] );
+				ASSERT_EQUAL( expected, (bool) dfa_results[w] );
+
+				std::istringstream nfa_stream(string((const char*) nfa_words[w].data(), nfa_words[w].size() * sizeof(LabelId)));
+				std::istringstream dfa_stream(string((const char*) dfa_words[w].data(), dfa_words[w].size() * sizeof(LabelId)));
+				ASSERT_EQUAL( expected, dense_nfa.accepts(nfa_stream) );
+				ASSERT_EQUAL( expected, dense_dfa.accepts(dfa_stream) );
+			}
+
+			delete dfa;
+			delete nfa;
+		}
+	}
+
+	/**
+	 * I kernel scalare, AVX2 e AVX-512 (se supportati dal processore) producono gli stessi risultati del
+	 * riconoscimento delle singole parole, anche con parole di lunghezza diversa nello stesso gruppo.
+	 * Un kernel non supportato viene sostituito dal migliore fra quelli supportati.
+	 */
+	TEST(DenseDFAKernelsAgree) {
+		SubsetConstruction sc = SubsetConstruction();
+		for (unsigned int seed = 0; seed < DENSE_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(3));
+			NFA* nfa = buildRandomNFA(random, 4 + random.next(8), alphabet, 20);
+			DFA* dfa = sc.run(nfa);
+			DenseDFA dense_dfa = DenseDFA(dfa);
+			vector<vector<LabelId>> words = encodeWords(buildRandomWords(random, alphabet), dense_dfa.getLabelIndex());
+
+			vector<uint8_t> expected_results;
+			for (const vector<LabelId>& word : words) {
+				expected_results.push_back(dense_dfa.accepts(word));
+			}
+			for (DenseDFAKernel kernel : { DFA_KERNEL_SCALAR, DFA_KERNEL_AVX2, DFA_KERNEL_AVX512 }) {
+				dense_dfa.setKernel(kernel);
+				ASSERT_TRUE( dense_dfa.getKernel() <= kernel );
+				ASSERT_TRUE( dense_dfa.getKernel() <= DenseDFA::detectKernel() );
+				ASSERT_TRUE( expected_results == dense_dfa.acceptsBatch(words, 1) );
+			}
+
+			delete dfa;
+			delete nfa;
+		}
+	}
+
+	/**
+	 * La label EPSILON non modifica lo stato corrente, mentre una label sconosciuta porta il DFA
+	 * nello stato pozzo e svuota l'insieme degli stati correnti dell'NFA.
+	 */
+	TEST(DenseAutomataHandleEpsilonAndUnknownLabels) {
+		Alphabet alphabet = buildTestAlphabet(2);
+		DFA* dfa = new DFA();
+		StateDFA* initial_state = new StateDFA("q0", true);
+		dfa->addState(initial_state);
+		dfa->setInitialState(initial_state);
+		dfa->connectStates(initial_state, initial_state, alphabet[0]);
+		NFA* nfa = new NFA();
+		StateNFA* initial_state_nfa = new StateNFA("q0", true);
+		nfa->addState(initial_state_nfa);
+		nfa->setInitialState(initial_state_nfa);
+		nfa->connectStates(initial_state_nfa, initial_state_nfa, alphabet[0]);
+
+		DenseDFA dense_dfa = DenseDFA(dfa);
+		DenseNFA dense_nfa = DenseNFA(nfa);
+		const LabelIndex& index = dense_dfa.getLabelIndex();
+		vector<LabelId> epsilons = { index.getEpsilonId(), index.getId(alphabet[0]), index.getId(EPSILON) };
+		vector<LabelId> unknown = { index.getId(alphabet[0]), index.getId("unknown") };
+		ASSERT_EQUAL( index.getEpsilonId(), index.getId(EPSILON) );
+		ASSERT_EQUAL( index.getUnknownId(), index.getId("unknown") );
+		ASSERT_TRUE( dense_dfa.accepts(epsilons) );
+		ASSERT_TRUE( dense_nfa.accepts(epsilons) );
+		ASSERT_FALSE( dense_dfa.accepts(unknown) );
+		ASSERT_FALSE( dense_nfa.accepts(unknown) );
+
+		delete dfa;
+		delete nfa;
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,195 @@
+/*
+ * EditingSessionTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test delle modifiche incrementali al risultato di un problema di determinizzazione
+ * (addTransition, removeTransition, setFinal): dopo ciascuna modifica il DFA mantenuto da ESC
+ * deve coincidere con la Subset Construction dell'NFA modificato.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "Configurations.hpp"
+#include "EmbeddedSubsetConstruction.hpp"
+#include "Translation.hpp"
+
+#define EDITING_TEST_CASES 		300		// Numero di NFA casuali su cui viene applicata una sequenza di modifiche
+#define EDITING_TEST_STEPS 		20		// Numero di modifiche applicate a ciascun NFA
+
+namespace translated_automata {
+
+	/**
+	 * Restituisce un'istanza di ESC configurata con i valori di default, salvo l'automaton pruning.
+	 */
+	static Configurations buildEditingConfigurations(bool automaton_pruning) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		configurations.loadAssignment(string("ActiveAutomatonPruning=") + (automaton_pruning ? "true" : "false"));
+		return configurations;
+	}
+
+	/**
+	 * Applica una modifica casuale all'NFA tramite la sessione di modifica di ESC:
+	 * aggiunta di una transizione, rimozione di una transizione esistente oppure modifica di uno stato finale.
+	 * Le transizioni aggiunte sono epsilon-transizioni con la percentuale di probabilità indicata.
+	 */
+	static void applyRandomEdit(TestRandom& random, EmbeddedSubsetConstruction& esc, NFA* nfa, const Alphabet& alphabet, unsigned int epsilon_percentage) {
+		vector<StateNFA*> states = nfa->getStatesVector();
+		StateNFA* from = states[random.next(states.size())];
+
+		switch (random.next(5)) {
+		case 0 :
+		case 1 : {
+			StateNFA* to = states[random.next(states.size())];
+			string label = random.chance(epsilon_percentage) ? EPSILON : alphabet[random.next(alphabet.size())];
+			bool added = !from->hasExitingTransition(label, to);
+			ASSERT_EQUAL( added, esc.addTransition(from, label, to) );
+			break;
+		}
+
+		case 2 :
+		case 3 : {
+			vector<pair<string, StateNFA*>> transitions;
+			for (auto &pair : from->getExitingTransitions()) {
+				for (StateNFA* child : pair.second) {
+					transitions.push_back(std::make_pair(pair.first, child));
+				}
+			}
+			if (!transitions.empty()) {
+				pair<string, StateNFA*> removed = transitions[random.next(transitions.size())];
+				ASSERT_TRUE( esc.removeTransition(from, removed.first, removed.second) );
+			}
+			break;
+		}
+
+		default :
+			ASSERT_TRUE( esc.setFinal(from, !from->isFinal()) );
+			break;
+		}
+	}
+
+	/**
+	 * Applica sequenze di modifiche casuali a NFA casuali, verificando dopo ogni modifica
+	 * che il risultato coincida con la Subset Construction dell'NFA modificato.
+	 */
+	static void checkRandomEditingSessions(bool automaton_pruning, unsigned int epsilon_percentage) {
+		Configurations configurations = buildEditingConfigurations(automaton_pruning);
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+
+		for (unsigned int seed = 0; seed < EDITING_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(3));
+			NFA* nfa = buildRandomNFA(random, 3 + random.next(5), alphabet, epsilon_percentage);
+			esc.runAutomatonCheckup(nfa);
+			esc.runBudProcessing();
+			DFA* result = esc.getResult();
+			ASSERT_TRUE( isSubsetConstructionOf(result, nfa) );
+
+			for (unsigned int step = 0; step < EDITING_TEST_STEPS; step++) {
+				applyRandomEdit(random, esc, nfa, alphabet, epsilon_percentage);
+				ASSERT_TRUE( esc.getResult() == result );
+				ASSERT_TRUE( isSubsetConstructionOf(result, nfa) );
+			}
+
+			esc.releaseResult();
+			delete result;
+			delete nfa;
+		}
+	}
+
+	TEST(EditingSessionMatchesSubsetConstruction) {
+		checkRandomEditingSessions(true, 0);
+	}
+
+	TEST(EditingSessionMatchesSubsetConstructionWithoutPruning) {
+		checkRandomEditingSessions(false, 0);
+	}
+
+	TEST(EditingSessionMatchesSubsetConstructionWithEpsilonTransitions) {
+		checkRandomEditingSessions(true, 20);
+	}
+
+	/**
+	 * Sequenza di modifiche segnalata in revisione: dopo la rimozione di "q2 a q0" lo stato {q0}
+	 * del risultato perdeva la transizione uscente con label "a".
+	 */
+	TEST(EditingSessionRemovalKeepsReachableTransitions) {
+		for (bool automaton_pruning : { true, false }) {
+			Configurations configurations = buildEditingConfigurations(automaton_pruning);
+			EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+
+			NFA* nfa = new NFA();
+			StateNFA* q0 = new StateNFA("q0", false);
+			StateNFA* q1 = new StateNFA("q1", true);
+			StateNFA* q2 = new StateNFA("q2", false);
+			nfa->addState(q0);
+			nfa->addState(q1);
+			nfa->addState(q2);
+			nfa->setInitialState(q0);
+			nfa->connectStates(q0, q0, EPSILON);
+			nfa->connectStates(q0, q0, "a");
+			nfa->connectStates(q0, q1, "a");
+			nfa->connectStates(q0, q2, "b");
+			nfa->connectStates(q1, q2, "a");
+			nfa->connectStates(q1, q1, "b");
+			nfa->connectStates(q1, q1, "d");
+			nfa->connectStates(q2, q0, "a");
+			nfa->connectStates(q2, q1, "d");
+
+			esc.runAutomatonCheckup(nfa);
+			esc.runBudProcessing();
+			ASSERT_TRUE( esc.addTransition(q1, "b", q2) );
+			ASSERT_FALSE( esc.addTransition(q0, "b", q2) );		// Già presente
+			ASSERT_TRUE( esc.addTransition(q0, "b", q1) );
+			ASSERT_TRUE( esc.addTransition(q1, "d", q2) );
+			ASSERT_TRUE( esc.removeTransition(q2, "a", q0) );
+			ASSERT_TRUE( isSubsetConstructionOf(esc.getResult(), nfa) );
+			ASSERT_TRUE( esc.getResult()->getInitialState()->hasExitingTransition("a") );
+
+			DFA* result = esc.getResult();
+			esc.releaseResult();
+			delete result;
+			delete nfa;
+		}
+	}
+
+	/**
+	 * Le modifiche sono rifiutate al di fuori di una sessione: dopo un problema di traduzione
+	 * e dopo il rilascio del risultato (l'NFA e il risultato possono essere già stati eliminati).
+	 */
+	TEST(EditingSessionRejectsEditsOutsideSession) {
+		Configurations configurations = buildEditingConfigurations(true);
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+		TestRandom random = TestRandom(0);
+		Alphabet alphabet = buildTestAlphabet(3);
+
+		DFA* dfa = buildRandomDFA(random, 5, alphabet);
+		Translation translation = Translation(map<string, string>({ { "a", "b" } }));
+		esc.runAutomatonTranslation(dfa, &translation);
+		esc.runBudProcessing();
+		StateNFA* state = new StateNFA("s", false);
+		ASSERT_FALSE( esc.addTransition(state, "a", state) );
+		ASSERT_FALSE( esc.setFinal(state, true) );
+		DFA* translated = esc.getResult();
+		esc.releaseResult();
+		delete translated;
+		delete dfa;
+
+		NFA* nfa = buildRandomNFA(random, 5, alphabet, 0);
+		esc.runAutomatonCheckup(nfa);
+		esc.runBudProcessing();
+		DFA* result = esc.getResult();
+		esc.releaseResult();
+		ASSERT_TRUE( esc.getResult() == NULL );
+		ASSERT_FALSE( esc.addTransition(state, "a", state) );
+		ASSERT_FALSE( esc.removeTransition(state, "a", state) );
+		ASSERT_FALSE( esc.setFinal(state, true) );
+		delete result;
+		delete nfa;
+		delete state;
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,143 @@
+/*
+ * ExtensionPoolTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test dell'insieme condiviso delle estensioni (ExtensionPool): le estensioni uguali devono essere
+ * condivise finché restano in uso, e i DFA risultanti mantenuti in memoria oltre la vita del proprio
+ * NFA non devono influenzare le estensioni dei problemi successivi, anche quando gli indirizzi degli
+ * stati NFA eliminati vengono riutilizzati.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "Configurations.hpp"
+#include "EmbeddedSubsetConstruction.hpp"
+#include "ExtensionPool.hpp"
+#include "Translation.hpp"
+
+#define EXTENSION_POOL_TEST_CASES 		500		// Numero di problemi risolti mantenendo tutti i risultati
+
+namespace translated_automata {
+
+	/**
+	 * Estensioni uguali vengono internate nella stessa copia, mentre estensioni diverse restano distinte;
+	 * quando l'ultimo riferimento viene rilasciato, l'estensione viene rimossa dal pool.
+	 */
+	TEST(ExtensionPoolSharesEqualExtensionsUntilReleased) {
+		StateNFA* first_state = new StateNFA("s0", false);
+		StateNFA* second_state = new StateNFA("s1", true);
+		unsigned long int initial_size = ExtensionPool::shared().size();
+		{
+			ExtensionDFA extension = { first_state, second_state };
+			ExtensionHandle handle = ExtensionPool::shared().intern(extension);
+			ExtensionHandle same_handle = ExtensionPool::shared().intern(ExtensionDFA { second_state, first_state });
+			ExtensionHandle other_handle = ExtensionPool::shared().intern(ExtensionDFA { first_state });
+			ASSERT_TRUE( handle.get() == same_handle.get() );
+			ASSERT_TRUE( handle.get() != other_handle.get() );
+			ASSERT_TRUE( *handle == extension );
+			ASSERT_EQUAL( initial_size + 2, ExtensionPool::shared().size() );
+
+			// Il rilascio di uno solo dei riferimenti condivisi mantiene l'estensione nel pool
+			handle.reset();
+			ASSERT_EQUAL( initial_size + 2, ExtensionPool::shared().size() );
+			ASSERT_TRUE( ExtensionPool::shared().intern(extension).get() == same_handle.get() );
+		}
+		ASSERT_EQUAL( initial_size, ExtensionPool::shared().size() );
+		delete first_state;
+		delete second_state;
+	}
+
+	/**
+	 * Un'estensione ancora in uso, riferita a stati eliminati, non deve essere restituita
+	 * per gli stati creati successivamente (che possono occupare gli stessi indirizzi).
+	 */
+	TEST(ExtensionPoolDoesNotReuseExtensionsOfDeletedStates) {
+		vector<ExtensionHandle> retained;
+		set<const ExtensionDFA*> retained_extensions;
+		for (unsigned int i = 0; i < EXTENSION_POOL_TEST_CASES; i++) {
+			// Lo stato eliminato al passo precedente lascia libero il proprio indirizzo
+			StateNFA* state = new StateNFA("s" + std::to_string(i), false);
+			ExtensionHandle handle = ExtensionPool::shared().intern(ExtensionDFA { state });
+			ASSERT_FALSE( retained_extensions.count(handle.get()) );
+			ASSERT_EQUAL( 1, handle->count(state) );
+			retained.push_back(handle);
+			retained_extensions.insert(handle.get());
+			delete state;
+		}
+	}
+
+	/**
+	 * Risolve una serie di problemi di traduzione con la stessa istanza di ESC, mantenendo tutti i risultati:
+	 * l'NFA di ciascun problema viene eliminato all'inizio del problema successivo, mentre le estensioni
+	 * dei risultati rimangono nel pool. Ogni risultato deve coincidere con la Subset Construction.
+	 */
+	TEST(RetainedTranslationResultsDoNotAffectLaterProblems) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+		vector<DFA*> results;
+
+		for (unsigned int seed = 0; seed < EXTENSION_POOL_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(6), alphabet);
+			map<string, string> translation_map;
+			for (string label : alphabet) {
+				translation_map[label] = random.chance(20) ? EPSILON : alphabet[random.next(alphabet.size())];
+			}
+			Translation translation = Translation(translation_map);
+
+			esc.runAutomatonTranslation(dfa, &translation);
+			esc.runBudProcessing();
+			results.push_back(esc.getResult());
+
+			NFA* nfa = translation.translate(dfa);
+			ASSERT_TRUE( isSubsetConstructionOf(results.back(), nfa) );
+			delete nfa;
+			delete dfa;
+		}
+
+		for (DFA* result : results) {
+			delete result;
+		}
+	}
+
+	/**
+	 * Come il test precedente, per i problemi di determinizzazione: ciascun NFA viene eliminato
+	 * subito dopo la risoluzione, mentre il DFA risultante viene mantenuto.
+	 */
+	TEST(RetainedDeterminizationResultsDoNotAffectLaterProblems) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+		vector<DFA*> results;
+
+		for (unsigned int seed = 0; seed < EXTENSION_POOL_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(6), alphabet);
+			map<string, string> translation_map;
+			for (string label : alphabet) {
+				translation_map[label] = random.chance(20) ? EPSILON : alphabet[random.next(alphabet.size())];
+			}
+			Translation translation = Translation(translation_map);
+			NFA* nfa = translation.translate(dfa);
+			delete dfa;
+
+			esc.runAutomatonCheckup(nfa);
+			esc.runBudProcessing();
+			results.push_back(esc.getResult());
+
+			ASSERT_TRUE( isSubsetConstructionOf(results.back(), nfa) );
+			delete nfa;
+		}
+
+		for (DFA* result : results) {
+			delete result;
+		}
+	}
+
+} /* namespace translated_automata */
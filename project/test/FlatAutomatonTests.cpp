@@ -0,0 +1,83 @@
+/*
+ * FlatAutomatonTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della rappresentazione CSR (FlatAutomaton) e della traduzione compilata (CompiledTranslation):
+ * la conversione di un automa in formato CSR e di nuovo in NFA non deve alterarlo, e la traduzione
+ * compilata deve produrre lo stesso automa della traduzione originale.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "CompiledTranslation.hpp"
+#include "FlatAutomaton.hpp"
+#include "SubsetConstruction.hpp"
+
+#define FLAT_TEST_CASES 			500		// Numero di automi casuali
+
+namespace translated_automata {
+
+	/**
+	 * Costruisce una traduzione casuale dell'alfabeto, in cui alcune label vengono tradotte in EPSILON.
+	 */
+	static Translation buildRandomTranslation(TestRandom& random, const Alphabet& alphabet) {
+		map<string, string> translation_map;
+		for (string label : alphabet) {
+			translation_map[label] = random.chance(20) ? EPSILON : alphabet[random.next(alphabet.size())];
+		}
+		return Translation(translation_map);
+	}
+
+	/**
+	 * Un NFA convertito in formato CSR e riconvertito coincide con l'originale, comprese le epsilon-transizioni.
+	 */
+	TEST(FlatAutomatonRoundTripPreservesNFA) {
+		for (unsigned int seed = 0; seed < FLAT_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			NFA* nfa = buildRandomNFA(random, 3 + random.next(8), alphabet, 20);
+
+			FlatAutomaton flat_nfa = FlatAutomaton(nfa);
+			ASSERT_EQUAL( nfa->size(), flat_nfa.size() );
+			NFA* round_trip = flat_nfa.toNFA();
+			ASSERT_TRUE( *round_trip == *nfa );
+
+			delete round_trip;
+			delete nfa;
+		}
+	}
+
+	/**
+	 * La traduzione compilata di un DFA in formato CSR, riconvertita in NFA, ha la stessa Subset Construction
+	 * della traduzione originale; la struttura dell'automa tradotto è condivisa con quella dell'originale.
+	 */
+	TEST(CompiledTranslationMatchesTranslation) {
+		SubsetConstruction sc = SubsetConstruction();
+		for (unsigned int seed = 0; seed < FLAT_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(8), alphabet);
+			Translation translation = buildRandomTranslation(random, alphabet);
+
+			FlatAutomaton flat_dfa = FlatAutomaton(dfa);
+			CompiledTranslation compiled_translation = CompiledTranslation(&translation, flat_dfa.getLabelIndex());
+			FlatAutomaton flat_nfa = compiled_translation.translate(flat_dfa);
+			ASSERT_TRUE( flat_nfa.getOffsets() == flat_dfa.getOffsets() );
+			ASSERT_TRUE( flat_nfa.getTargets() == flat_dfa.getTargets() );
+
+			NFA* compiled_nfa = flat_nfa.toNFA();
+			DFA* compiled_result = sc.run(compiled_nfa);
+			NFA* expected_nfa = translation.translate(dfa);
+			ASSERT_TRUE( isSubsetConstructionOf(compiled_result, expected_nfa) );
+
+			delete expected_nfa;
+			delete compiled_result;
+			delete compiled_nfa;
+			delete dfa;
+		}
+	}
+
+} /* namespace translated_automata */
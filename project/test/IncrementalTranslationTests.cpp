@@ -0,0 +1,88 @@
+/*
+ * IncrementalTranslationTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della ri-traduzione incrementale di ESC (runIncrementalTranslation): dopo ciascuna traduzione
+ * applicata in sequenza, il risultato deve coincidere con la Subset Construction dell'NFA tradotto.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "Configurations.hpp"
+#include "EmbeddedSubsetConstruction.hpp"
+#include "Translation.hpp"
+
+#define INCREMENTAL_TEST_CASES 		2000	// Numero di DFA casuali su cui viene verificata ciascuna sequenza
+#define INCREMENTAL_TEST_STEPS 		3		// Numero di traduzioni incrementali applicate in sequenza
+
+namespace translated_automata {
+
+	/**
+	 * Applica in sequenza a DFA casuali delle traduzioni che differiscono dalla precedente per una sola label;
+	 * l'ultima traduzione della sequenza è uguale alla precedente (nessuna label modificata).
+	 * Dopo ogni passo verifica che il risultato coincida con la Subset Construction dell'NFA tradotto.
+	 * Se "epsilon_percentage" è positivo, le label possono essere tradotte anche in EPSILON: in tal caso
+	 * ESC esegue la traduzione completa, e il risultato è un nuovo automa.
+	 */
+	static void checkChainedIncrementalTranslations(bool automaton_pruning, unsigned int epsilon_percentage) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		configurations.loadAssignment(string("ActiveAutomatonPruning=") + (automaton_pruning ? "true" : "false"));
+		EmbeddedSubsetConstruction esc = EmbeddedSubsetConstruction(&configurations);
+
+		for (unsigned int seed = 0; seed < INCREMENTAL_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(6), alphabet);
+
+			map<string, string> translation_map;
+			for (string label : alphabet) {
+				translation_map[label] = alphabet[random.next(alphabet.size())];
+			}
+			vector<Translation*> translations = { new Translation(translation_map) };
+			esc.runAutomatonTranslation(dfa, translations.back());
+			esc.runBudProcessing();
+
+			for (unsigned int step = 0; step < INCREMENTAL_TEST_STEPS; step++) {
+				if (step + 1 < INCREMENTAL_TEST_STEPS) {
+					string label = alphabet[random.next(alphabet.size())];
+					translation_map[label] = random.chance(epsilon_percentage) ? EPSILON : alphabet[random.next(alphabet.size())];
+				}
+				translations.push_back(new Translation(translation_map));
+
+				DFA* previous_result = esc.getResult();
+				esc.runIncrementalTranslation(translations.back());
+				esc.runBudProcessing();
+				if (esc.getResult() != previous_result) {
+					delete previous_result;
+				}
+
+				NFA* nfa = translations.back()->translate(dfa);
+				ASSERT_TRUE( isSubsetConstructionOf(esc.getResult(), nfa) );
+				delete nfa;
+			}
+
+			delete esc.getResult();
+			for (Translation* translation : translations) {
+				delete translation;
+			}
+			delete dfa;
+		}
+	}
+
+	TEST(IncrementalTranslationMatchesSubsetConstruction) {
+		checkChainedIncrementalTranslations(true, 0);
+	}
+
+	TEST(IncrementalTranslationMatchesSubsetConstructionWithoutPruning) {
+		checkChainedIncrementalTranslations(false, 0);
+	}
+
+	TEST(IncrementalTranslationFallsBackWithEpsilonLabels) {
+		checkChainedIncrementalTranslations(true, 30);
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,116 @@
+/*
+ * LazyDFATests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test del DFA "lazy": il riconoscimento di parole casuali deve coincidere con quello del DFA
+ * prodotto dalla Subset Construction, sia quando la cache deve rimuovere degli stati per rispettare
+ * il limite di memoria, sia quando nessuno stato può essere mantenuto in cache e il riconoscimento
+ * prosegue tramite simulazione diretta dell'NFA.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "LazyDFA.hpp"
+#include "SubsetConstruction.hpp"
+
+#define LAZY_DFA_TEST_CASES 		200		// Numero di NFA casuali
+#define LAZY_DFA_TEST_WORDS 		50		// Numero di parole riconosciute per ciascun NFA
+#define LAZY_DFA_TEST_MAX_LENGTH 	12		// Lunghezza massima delle parole
+#define LAZY_DFA_SMALL_BUDGET 		4096	// Limite di memoria (in byte) che contiene solo pochi stati
+
+namespace translated_automata {
+
+	/**
+	 * Riconosce la parola con il DFA prodotto dalla Subset Construction.
+	 */
+	static bool acceptsWithDFA(DFA* dfa, const vector<string>& word) {
+		StateDFA* current = dfa->getInitialState();
+		for (const string& label : word) {
+			if (current == NULL) {
+				return false;
+			}
+			current = current->getChild(label);
+		}
+		return current != NULL && current->isFinal();
+	}
+
+	/**
+	 * Verifica che il DFA lazy con il limite di memoria indicato riconosca le stesse parole casuali
+	 * della Subset Construction, per numerosi NFA casuali. Le statistiche del DFA lazy vengono sommate
+	 * nei parametri passati per riferimento.
+	 */
+	static bool acceptsLikeSubsetConstruction(unsigned long int budget, unsigned long int& evictions, unsigned long int& fallbacks) {
+		SubsetConstruction sc = SubsetConstruction();
+		for (unsigned int seed = 0; seed < LAZY_DFA_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(3));
+			NFA* nfa = buildRandomNFA(random, 4 + random.next(8), alphabet, 20);
+			DFA* dfa = sc.run(nfa);
+
+			LazyDFA lazy_dfa(nfa, budget);
+			bool equal = true;
+			for (unsigned int w = 0; w < LAZY_DFA_TEST_WORDS && equal; w++) {
+				vector<string> word;
+				unsigned int length = random.next(LAZY_DFA_TEST_MAX_LENGTH + 1);
+				for (unsigned int i = 0; i < length; i++) {
+					word.push_back(alphabet[random.next(alphabet.size())]);
+				}
+				equal = (lazy_dfa.accepts(word) == acceptsWithDFA(dfa, word))
+						&& lazy_dfa.getUsedBytes() <= lazy_dfa.getBudget();
+			}
+			evictions += lazy_dfa.getEvictionsCount();
+			fallbacks += lazy_dfa.getFallbacksCount();
+
+			delete dfa;
+			delete nfa;
+			if (!equal) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Con il limite di memoria predefinito, nessuno stato viene rimosso dalla cache.
+	 */
+	TEST(LazyDFAMatchesSubsetConstruction) {
+		unsigned long int evictions = 0, fallbacks = 0;
+		ASSERT_TRUE( acceptsLikeSubsetConstruction(DEFAULT_LAZY_DFA_BUDGET, evictions, fallbacks) );
+		ASSERT_EQUAL( 0, evictions );
+		ASSERT_EQUAL( 0, fallbacks );
+	}
+
+	/**
+	 * Con un limite di memoria ridotto, gli stati rimossi dalla cache vengono ricostruiti
+	 * quando vengono nuovamente raggiunti, senza alterare il riconoscimento.
+	 */
+	TEST(LazyDFAEvictsStatesWithinBudget) {
+		unsigned long int evictions = 0, fallbacks = 0;
+		ASSERT_TRUE( acceptsLikeSubsetConstruction(LAZY_DFA_SMALL_BUDGET, evictions, fallbacks) );
+		ASSERT_TRUE( evictions > 0 );
+	}
+
+	/**
+	 * Se nemmeno lo stato iniziale può essere mantenuto in cache, ogni parola viene riconosciuta
+	 * tramite simulazione diretta dell'NFA e la cache resta vuota.
+	 */
+	TEST(LazyDFAFallsBackToSimulationWhenStateExceedsBudget) {
+		unsigned long int evictions = 0, fallbacks = 0;
+		ASSERT_TRUE( acceptsLikeSubsetConstruction(1, evictions, fallbacks) );
+		ASSERT_TRUE( fallbacks > 0 );
+		ASSERT_EQUAL( 0, evictions );
+
+		TestRandom random = TestRandom(0);
+		Alphabet alphabet = buildTestAlphabet(2);
+		NFA* nfa = buildRandomNFA(random, 4, alphabet, 0);
+		LazyDFA lazy_dfa(nfa, 1);
+		ASSERT_TRUE( lazy_dfa.isSimulationActive() );
+		ASSERT_EQUAL( 0, lazy_dfa.getCachedStatesCount() );
+		ASSERT_EQUAL( 0, lazy_dfa.getUsedBytes() );
+		delete nfa;
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,125 @@
+/*
+ * PerformanceCountersTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della misurazione dei contatori hardware (PerformanceCounters) e della loro aggregazione
+ * in ResultCollector. Poiché la disponibilità dei contatori dipende dal sistema (e dai permessi),
+ * i test verificano che i contatori non disponibili producano misurazioni vuote, e che quelli
+ * disponibili producano valori plausibili.
+ *
+ */
+
+#include "Test.hpp"
+
+#include <cmath>
+
+#include "Configurations.hpp"
+#include "PerformanceCounters.hpp"
+#include "ResultCollector.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Esegue un blocco di calcolo non eliminabile dal compilatore, da misurare con i contatori.
+	 */
+	static unsigned long int runMeasuredWork() {
+		volatile unsigned long int accumulator = 0;
+		for (unsigned long int i = 0; i < 1000000; i++) {
+			accumulator = accumulator + i * i;
+		}
+		return accumulator;
+	}
+
+	/**
+	 * Con le misurazioni disabilitate nessun contatore viene aperto, e le misurazioni sono vuote.
+	 */
+	TEST(DisabledPerformanceCountersProduceEmptySamples) {
+		PerformanceCounters counters = PerformanceCounters(false);
+		ASSERT_FALSE( counters.isAvailable() );
+
+		counters.start();
+		runMeasuredWork();
+		CounterSample sample = counters.stop();
+		ASSERT_EQUAL( 0, sample.valid_mask );
+		for (int counter = HW_CYCLES; counter < HW_COUNTERS_COUNT; counter++) {
+			ASSERT_FALSE( sample.isValid((HardwareCounter) counter) );
+			ASSERT_EQUAL( 0, sample.values[counter] );
+		}
+	}
+
+	/**
+	 * Con le misurazioni abilitate, i contatori effettivamente aperti riportano un numero di istruzioni
+	 * e di cicli non nullo per un blocco di calcolo; se nessun contatore è disponibile sul sistema,
+	 * le misurazioni restano vuote.
+	 */
+	TEST(EnabledPerformanceCountersMeasureOnlyAvailableCounters) {
+		PerformanceCounters counters = PerformanceCounters(true);
+
+		counters.start();
+		runMeasuredWork();
+		CounterSample sample = counters.stop();
+		if (!counters.isAvailable()) {
+			ASSERT_EQUAL( 0, sample.valid_mask );
+			return;
+		}
+		for (HardwareCounter counter : { HW_CYCLES, HW_INSTRUCTIONS }) {
+			if (sample.isValid(counter)) {
+				ASSERT_TRUE( sample.values[counter] > 0 );
+			}
+		}
+	}
+
+	/**
+	 * Senza contatori hardware attivi nelle configurazioni, il collettore non riporta alcuna statistica
+	 * sui contatori (valori NaN), anche dopo l'aggiunta e la combinazione di risultati.
+	 */
+	TEST(ResultCollectorIgnoresCountersWhenDisabled) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		ResultCollector collector = ResultCollector(&configurations);
+		ResultCollector other = ResultCollector(&configurations);
+
+		Result* result = new Result();
+		result->original_problem = new DeterminizationProblem(new NFA());
+		result->sc_solution = new DFA();
+		result->esc_solution = new DFA();
+		result->hw_counters[PHASE_SC_RUN].values[HW_CYCLES] = 1000;
+		result->hw_counters[PHASE_SC_RUN].valid_mask = (1U << HW_CYCLES);
+		other.addResult(result);
+		collector.mergeWith(other);
+
+		ASSERT_EQUAL( 1, collector.getTestCaseNumber() );
+		ASSERT_TRUE( std::isnan(std::get<1>(collector.getHardwareCounterStat(PHASE_SC_RUN, HW_CYCLES))) );
+	}
+
+	/**
+	 * Con i contatori hardware attivati tramite assegnamento, il collettore aggrega solo i contatori
+	 * misurati nei risultati, anche quando questi provengono dalla combinazione con un altro collettore.
+	 */
+	TEST(ResultCollectorAggregatesCountersWhenEnabled) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		configurations.loadAssignment("ActiveHardwareCounters=true");
+		ResultCollector collector = ResultCollector(&configurations);
+		ResultCollector other = ResultCollector(&configurations);
+
+		for (unsigned long int cycles : { 1000, 3000 }) {
+			Result* result = new Result();
+			result->original_problem = new DeterminizationProblem(new NFA());
+			result->sc_solution = new DFA();
+			result->esc_solution = new DFA();
+			result->hw_counters[PHASE_SC_RUN].values[HW_CYCLES] = cycles;
+			result->hw_counters[PHASE_SC_RUN].valid_mask = (1U << HW_CYCLES);
+			other.addResult(result);
+		}
+		collector.mergeWith(other);
+
+		ASSERT_EQUAL( 2, collector.getTestCaseNumber() );
+		ASSERT_EQUAL( 1000, std::get<0>(collector.getHardwareCounterStat(PHASE_SC_RUN, HW_CYCLES)) );
+		ASSERT_EQUAL( 2000, std::get<1>(collector.getHardwareCounterStat(PHASE_SC_RUN, HW_CYCLES)) );
+		ASSERT_EQUAL( 3000, std::get<2>(collector.getHardwareCounterStat(PHASE_SC_RUN, HW_CYCLES)) );
+		ASSERT_TRUE( std::isnan(std::get<1>(collector.getHardwareCounterStat(PHASE_SC_RUN, HW_INSTRUCTIONS))) );
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,119 @@
+/*
+ * ResultCacheTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della cache delle soluzioni SC (ResultCache): le soluzioni recuperate dalla cache devono
+ * coincidere con la Subset Construction, e i problemi risolti tramite la cache non devono contribuire
+ * alle statistiche sul tempo di SC raccolte da ResultCollector.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "Configurations.hpp"
+#include "ProblemSolver.hpp"
+#include "ResultCache.hpp"
+#include "ResultCollector.hpp"
+#include "SubsetConstruction.hpp"
+#include "Translation.hpp"
+
+#define RESULT_CACHE_TEST_CASES 		200		// Numero di problemi di traduzione memorizzati e ricercati nella cache
+#define RESULT_CACHE_CAPACITY 			(64 * 1024 * 1024)
+
+namespace translated_automata {
+
+	/**
+	 * Costruisce la traduzione casuale del problema corrispondente al generatore.
+	 */
+	static Translation* buildTestTranslation(TestRandom& random, const Alphabet& alphabet) {
+		map<string, string> translation_map;
+		for (string label : alphabet) {
+			translation_map[label] = random.chance(20) ? EPSILON : alphabet[random.next(alphabet.size())];
+		}
+		return new Translation(translation_map);
+	}
+
+	/**
+	 * La soluzione recuperata dalla cache per lo stesso problema coincide (stati, per nome, e transizioni)
+	 * con la soluzione della Subset Construction memorizzata.
+	 */
+	TEST(ResultCacheRebuildsSubsetConstructionSolutions) {
+		ResultCache cache = ResultCache(RESULT_CACHE_CAPACITY, false, "");
+		SubsetConstruction sc = SubsetConstruction();
+
+		for (unsigned int seed = 0; seed < RESULT_CACHE_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(8), alphabet);
+			Translation* translation = buildTestTranslation(random, alphabet);
+			ResultFingerprint fingerprint = ResultCache::computeFingerprint(dfa, translation);
+
+			NFA* nfa = translation->translate(dfa);
+			DFA* solution = sc.run(nfa);
+			DFA* cached = cache.lookup(fingerprint);
+			if (cached == NULL) {
+				cache.store(fingerprint, solution);
+				cached = cache.lookup(fingerprint);
+			}
+			ASSERT_TRUE( cached != NULL );
+			ASSERT_TRUE( *cached == *solution );
+
+			delete cached;
+			delete solution;
+			delete nfa;
+			delete translation;
+			delete dfa;
+		}
+	}
+
+	/**
+	 * I risultati con la soluzione SC recuperata dalla cache vengono conteggiati a parte, e il tempo
+	 * della risoluzione originale non contribuisce alle statistiche SC_TIME e EMP_GAIN.
+	 */
+	TEST(ResultCollectorExcludesCachedSolutionsFromSCTime) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		ResultCollector collector = ResultCollector(&configurations);
+
+		for (unsigned int i = 0; i < 10; i++) {
+			Result* result = new Result();
+			result->original_problem = new DeterminizationProblem(new NFA());
+			result->sc_solution = new DFA();
+			result->esc_solution = new DFA();
+			result->sc_cached = (i % 2 == 1);
+			result->sc_elapsed_time = result->sc_cached ? 1000000 : 100;
+			result->esc_elapsed_time = 10;
+			collector.addResult(result);
+		}
+
+		ASSERT_EQUAL( 10, collector.getTestCaseNumber() );
+		ASSERT_EQUAL( 5, collector.getSCCachedNumber() );
+		ASSERT_EQUAL( 100, std::get<2>(collector.getStat(SC_TIME)) );
+		ASSERT_EQUAL( 10, std::get<2>(collector.getStat(ESC_TIME)) );
+	}
+
+	/**
+	 * Risolvendo due volte lo stesso problema, il secondo risultato viene conteggiato fra le soluzioni
+	 * recuperate dalla cache, senza riportare come misure il tempo della risoluzione originale.
+	 */
+	TEST(ProblemSolverCountsCachedSolutionsSeparately) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		configurations.loadAssignment("ActiveResultCache=true");
+		ProblemSolver solver = ProblemSolver(&configurations);
+
+		for (unsigned int repetition = 0; repetition < 2; repetition++) {
+			TestRandom random = TestRandom(0);
+			Alphabet alphabet = buildTestAlphabet(3);
+			DFA* dfa = buildRandomDFA(random, 8, alphabet);
+			solver.solve(new TranslationProblem(dfa, buildTestTranslation(random, alphabet)));
+		}
+
+		ResultCollector* collector = solver.getResultCollector();
+		ASSERT_EQUAL( 2, collector->getTestCaseNumber() );
+		ASSERT_EQUAL( 1, collector->getSCCachedNumber() );
+	}
+
+} /* namespace translated_automata */
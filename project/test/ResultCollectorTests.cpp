@@ -0,0 +1,102 @@
+/*
+ * ResultCollectorTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test delle statistiche aggregate da ResultCollector: percentili, deviazione standard e istogrammi
+ * calcolati "in streaming", e combinazione di due collettori tramite "mergeWith".
+ *
+ */
+
+#include "Test.hpp"
+
+#include <cmath>
+
+#include "Configurations.hpp"
+#include "ResultCollector.hpp"
+
+#define COLLECTOR_TEST_RESULTS 		1000		// Numero di risultati aggiunti (con tempi SC 0, 1, ..., N-1)
+#define COLLECTOR_TEST_STRIDE 		379			// Passo (primo con N) con cui i tempi vengono assegnati in ordine sparso
+
+namespace translated_automata {
+
+	/**
+	 * Costruisce l'i-esimo risultato di test: il tempo di SC è una permutazione degli interi 0, 1, ..., N-1,
+	 * mentre il tempo di ESC è costante. Le soluzioni sono automi vuoti (la dimensione non è oggetto del test).
+	 */
+	static Result* buildTestResult(unsigned int i) {
+		Result* result = new Result();
+		result->original_problem = new DeterminizationProblem(new NFA());
+		result->sc_solution = new DFA();
+		result->esc_solution = new DFA();
+		result->sc_elapsed_time = (i * COLLECTOR_TEST_STRIDE) % COLLECTOR_TEST_RESULTS;
+		result->esc_elapsed_time = 10;
+		return result;
+	}
+
+	/**
+	 * I percentili e l'istogramma dei tempi di SC corrispondono (a meno della tolleranza dello sketch)
+	 * a quelli della distribuzione uniforme dei valori aggiunti.
+	 */
+	TEST(ResultCollectorReportsPercentilesAndHistograms) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		ResultCollector collector = ResultCollector(&configurations);
+		for (unsigned int i = 0; i < COLLECTOR_TEST_RESULTS; i++) {
+			collector.addResult(buildTestResult(i));
+		}
+
+		ASSERT_EQUAL( COLLECTOR_TEST_RESULTS, collector.getTestCaseNumber() );
+		for (double percentile : { 0.1, 0.5, 0.9, 0.99 }) {
+			ASSERT_TRUE( std::fabs(percentile * COLLECTOR_TEST_RESULTS - collector.getPercentile(SC_TIME, percentile)) <= COLLECTOR_TEST_RESULTS * 0.01 );
+		}
+
+		vector<HistogramBin> histogram = collector.getHistogram(SC_TIME, 10);
+		ASSERT_EQUAL( 10, histogram.size() );
+		ASSERT_EQUAL( 0, histogram.front().lower_bound );
+		ASSERT_EQUAL( COLLECTOR_TEST_RESULTS - 1, histogram.back().upper_bound );
+		double total_count = 0;
+		for (unsigned int bin = 0; bin < histogram.size(); bin++) {
+			if (bin > 0) {
+				ASSERT_EQUAL( histogram[bin - 1].upper_bound, histogram[bin].lower_bound );
+			}
+			ASSERT_TRUE( std::fabs(histogram[bin].count - COLLECTOR_TEST_RESULTS / 10) <= COLLECTOR_TEST_RESULTS * 0.02 );
+			total_count += histogram[bin].count;
+		}
+		ASSERT_TRUE( std::fabs(total_count - COLLECTOR_TEST_RESULTS) < 1e-6 );
+
+		// Statistica costante: un unico intervallo contenente tutti i valori
+		vector<HistogramBin> constant_histogram = collector.getHistogram(ESC_TIME, 10);
+		ASSERT_EQUAL( 1, constant_histogram.size() );
+		ASSERT_EQUAL( COLLECTOR_TEST_RESULTS, constant_histogram[0].count );
+		ASSERT_EQUAL( 0, collector.getStandardDeviation(ESC_TIME) );
+	}
+
+	/**
+	 * Due collettori che hanno raccolto metà dei risultati ciascuno, una volta combinati, riportano
+	 * le stesse statistiche del collettore che li ha raccolti tutti; il collettore assorbito viene svuotato.
+	 */
+	TEST(ResultCollectorMergeMatchesSingleCollector) {
+		Configurations configurations = Configurations();
+		configurations.load();
+		ResultCollector whole = ResultCollector(&configurations);
+		ResultCollector first_half = ResultCollector(&configurations);
+		ResultCollector second_half = ResultCollector(&configurations);
+		for (unsigned int i = 0; i < COLLECTOR_TEST_RESULTS; i++) {
+			whole.addResult(buildTestResult(i));
+			(i % 2 == 0 ? first_half : second_half).addResult(buildTestResult(i));
+		}
+		first_half.mergeWith(second_half);
+
+		ASSERT_EQUAL( 0, second_half.getTestCaseNumber() );
+		ASSERT_EQUAL( whole.getTestCaseNumber(), first_half.getTestCaseNumber() );
+		for (ResultStat stat : { SC_TIME, ESC_TIME }) {
+			ASSERT_EQUAL( std::get<0>(whole.getStat(stat)), std::get<0>(first_half.getStat(stat)) );
+			ASSERT_TRUE( std::fabs(std::get<1>(whole.getStat(stat)) - std::get<1>(first_half.getStat(stat))) < 1e-6 );
+			ASSERT_EQUAL( std::get<2>(whole.getStat(stat)), std::get<2>(first_half.getStat(stat)) );
+			ASSERT_TRUE( std::fabs(whole.getStandardDeviation(stat) - first_half.getStandardDeviation(stat)) < 1e-6 );
+			ASSERT_TRUE( std::fabs(whole.getPercentile(stat, 0.5) - first_half.getPercentile(stat, 0.5)) <= COLLECTOR_TEST_RESULTS * 0.01 );
+		}
+	}
+
+} /* namespace translated_automata */
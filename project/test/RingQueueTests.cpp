@@ -0,0 +1,156 @@
+/*
+ * RingQueueTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della coda FIFO su buffer circolare (RingQueue) utilizzata dalla procedura "Distance Relocation",
+ * e dell'ordinamento dei bud all'interno della lista di bud, compreso il riposizionamento dei bud
+ * degli stati modificati.
+ *
+ */
+
+#include "Test.hpp"
+
+#include "Bud.hpp"
+#include "RingQueue.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Gli elementi vengono estratti nell'ordine di inserimento, anche quando gli indici
+	 * superano la fine del buffer e quando il buffer viene raddoppiato con la coda non allineata.
+	 */
+	TEST(RingQueuePreservesFifoOrderAcrossGrowth) {
+		RingQueue<unsigned int> queue = RingQueue<unsigned int>(3);
+		ASSERT_EQUAL( 4, queue.capacity() );
+		ASSERT_TRUE( queue.empty() );
+
+		unsigned int next_pushed = 0;
+		unsigned int next_popped = 0;
+		for (unsigned int round = 0; round < 50; round++) {
+			// Ad ogni giro la coda cresce di un elemento: il buffer viene raddoppiato con la testa in posizione arbitraria
+			for (unsigned int i = 0; i < 3; i++) {
+				queue.push(next_pushed++);
+			}
+			for (unsigned int i = 0; i < 2; i++) {
+				ASSERT_EQUAL( next_popped++, queue.pop() );
+			}
+			ASSERT_EQUAL( next_pushed - next_popped, queue.size() );
+		}
+		ASSERT_EQUAL( 64, queue.capacity() );
+		while (!queue.empty()) {
+			ASSERT_EQUAL( next_popped++, queue.pop() );
+		}
+		ASSERT_EQUAL( next_pushed, next_popped );
+	}
+
+	/**
+	 * Lo svuotamento della coda mantiene lo spazio allocato, e la coda può essere riutilizzata.
+	 */
+	TEST(RingQueueClearKeepsCapacity) {
+		RingQueue<unsigned int> queue = RingQueue<unsigned int>();
+		for (unsigned int i = 0; i < 1000; i++) {
+			queue.push(i);
+		}
+		unsigned long int capacity = queue.capacity();
+		queue.clear();
+		ASSERT_TRUE( queue.empty() );
+		ASSERT_EQUAL( capacity, queue.capacity() );
+
+		queue.push(7);
+		queue.push(8);
+		ASSERT_EQUAL( 7, queue.pop() );
+		ASSERT_EQUAL( 8, queue.pop() );
+		ASSERT_TRUE( queue.empty() );
+	}
+
+	/**
+	 * Dopo la modifica della distanza di alcuni stati, il riposizionamento dei soli bud di quegli stati
+	 * ripristina l'ordinamento della lista (per distanza crescente), senza perdere né duplicare bud.
+	 */
+	TEST(BudsListRepositionsBudsOfRelocatedStates) {
+		vector<StateNFA*> nfa_states;
+		vector<ConstructedStateDFA*> dfa_states;
+		BudsList buds = BudsList();
+		for (unsigned int i = 0; i < 6; i++) {
+			nfa_states.push_back(new StateNFA("s" + std::to_string(i), false));
+			ExtensionDFA extension = { nfa_states.back() };
+			dfa_states.push_back(new ConstructedStateDFA(extension));
+			dfa_states.back()->setDistance(i);
+			ASSERT_TRUE( buds.insert(dfa_states.back(), "a") );
+			ASSERT_TRUE( buds.insert(dfa_states.back(), "b") );
+		}
+		ASSERT_FALSE( buds.insert(dfa_states[0], "a") );
+
+		// Gli ultimi due stati diventano i più vicini allo stato iniziale
+		dfa_states[4]->setDistance(0);
+		dfa_states[5]->setDistance(0);
+		vector<ConstructedStateDFA*> relocated_states = { dfa_states[5], dfa_states[4] };
+		buds.repositionBudsOfStates(relocated_states);
+
+		vector<ConstructedStateDFA*> expected_order = { dfa_states[0], dfa_states[4], dfa_states[5], dfa_states[1], dfa_states[2], dfa_states[3] };
+		for (ConstructedStateDFA* expected_state : expected_order) {
+			for (string expected_label : { "a", "b" }) {
+				ASSERT_FALSE( buds.empty() );
+				Bud* bud = buds.pop();
+				ASSERT_TRUE( bud->getState() == expected_state );
+				ASSERT_EQUAL( expected_label, bud->getLabel() );
+			}
+		}
+		ASSERT_TRUE( buds.empty() );
+
+		for (ConstructedStateDFA* state : dfa_states) {
+			delete state;
+		}
+		for (StateNFA* state : nfa_states) {
+			delete state;
+		}
+	}
+
+	/**
+	 * A parità di distanza, i bud sono ordinati per numero progressivo dello stato (ossia in ordine di
+	 * creazione) e poi per label, indipendentemente dai nomi: la sostituzione dell'estensione di uno stato
+	 * non modifica la posizione dei suoi bud, e stati con la stessa estensione mantengono bud distinti.
+	 */
+	TEST(BudsListOrdersBudsBySerialIndependentlyOfExtensions) {
+		vector<StateNFA*> nfa_states;
+		vector<ConstructedStateDFA*> dfa_states;
+		BudsList buds = BudsList();
+		// I nomi degli stati seguono l'ordine inverso rispetto a quello di creazione
+		for (string name : { "z", "y", "x" }) {
+			nfa_states.push_back(new StateNFA(name, false));
+			ExtensionDFA extension = { nfa_states.back() };
+			dfa_states.push_back(new ConstructedStateDFA(extension));
+			dfa_states.back()->setDistance(1);
+		}
+		for (ConstructedStateDFA* state : dfa_states) {
+			ASSERT_TRUE( dfa_states[0]->getSerial() <= state->getSerial() );
+			ASSERT_TRUE( buds.insert(state, "b") );
+			ASSERT_TRUE( buds.insert(state, "a") );
+		}
+
+		// Il primo stato assume l'estensione dell'ultimo, senza riposizionamento dei bud
+		ExtensionDFA last_extension = { nfa_states[2] };
+		dfa_states[0]->replaceExtensionWith(last_extension);
+		ASSERT_TRUE( dfa_states[0]->hasExtension(dfa_states[2]->getExtensionHandle()) );
+		ASSERT_FALSE( buds.insert(dfa_states[0], "a") );
+
+		for (ConstructedStateDFA* expected_state : dfa_states) {
+			for (string expected_label : { "a", "b" }) {
+				ASSERT_FALSE( buds.empty() );
+				Bud* bud = buds.pop();
+				ASSERT_TRUE( bud->getState() == expected_state );
+				ASSERT_EQUAL( expected_label, bud->getLabel() );
+			}
+		}
+		ASSERT_TRUE( buds.empty() );
+
+		for (ConstructedStateDFA* state : dfa_states) {
+			delete state;
+		}
+		for (StateNFA* state : nfa_states) {
+			delete state;
+		}
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,145 @@
+/*
+ * StatisticsTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test degli accumulatori statistici "in streaming" (TDigest, StatAccumulator): stima dei quantili
+ * e della distribuzione cumulativa, statistiche esatte (minimo, massimo, media, varianza) e
+ * combinazione di accumulatori costruiti su insiemi di valori differenti.
+ *
+ */
+
+#include "Test.hpp"
+
+#include <cmath>
+
+#include "Statistics.hpp"
+
+#define STATISTICS_TEST_VALUES 		10000		// Numero di valori accumulati (gli interi 0, 1, ..., N-1)
+#define STATISTICS_TEST_STRIDE 		7919		// Passo (primo con N) con cui i valori vengono accumulati in ordine sparso
+
+namespace translated_automata {
+
+	/**
+	 * Restituisce l'i-esimo valore della sequenza di test: una permutazione degli interi 0, 1, ..., N-1,
+	 * così che i valori non vengano accumulati in ordine crescente.
+	 */
+	static double getTestValue(unsigned int i) {
+		return (double) ((i * STATISTICS_TEST_STRIDE) % STATISTICS_TEST_VALUES);
+	}
+
+	/**
+	 * Verifica che il valore ottenuto differisca da quello atteso al più della tolleranza indicata.
+	 */
+	static bool isClose(double expected, double actual, double tolerance) {
+		return std::fabs(expected - actual) <= tolerance;
+	}
+
+	/**
+	 * I quantili stimati di una distribuzione uniforme si discostano da quelli esatti meno dell'1%
+	 * dell'intervallo (sulle code, dove i centroidi sono più piccoli, meno dello 0.2%).
+	 * Gli estremi coincidono con il minimo e il massimo esatti.
+	 */
+	TEST(TDigestEstimatesQuantilesOfUniformValues) {
+		TDigest digest = TDigest();
+		for (unsigned int i = 0; i < STATISTICS_TEST_VALUES; i++) {
+			digest.add(getTestValue(i));
+		}
+
+		ASSERT_EQUAL( STATISTICS_TEST_VALUES, digest.getCount() );
+		ASSERT_EQUAL( 0, digest.getQuantile(0) );
+		ASSERT_EQUAL( STATISTICS_TEST_VALUES - 1, digest.getQuantile(1) );
+		for (double q : { 0.25, 0.5, 0.75, 0.9 }) {
+			ASSERT_TRUE( isClose(q * STATISTICS_TEST_VALUES, digest.getQuantile(q), STATISTICS_TEST_VALUES * 0.01) );
+		}
+		for (double q : { 0.001, 0.01, 0.99, 0.999 }) {
+			ASSERT_TRUE( isClose(q * STATISTICS_TEST_VALUES, digest.getQuantile(q), STATISTICS_TEST_VALUES * 0.002) );
+		}
+	}
+
+	/**
+	 * La distribuzione cumulativa stimata è coerente con i quantili: nulla prima del minimo,
+	 * unitaria dal massimo in poi, e prossima al valore esatto all'interno dell'intervallo.
+	 */
+	TEST(TDigestEstimatesCumulativeDistribution) {
+		TDigest digest = TDigest();
+		for (unsigned int i = 0; i < STATISTICS_TEST_VALUES; i++) {
+			digest.add(getTestValue(i));
+		}
+
+		ASSERT_EQUAL( 0, digest.getCumulativeDistribution(-1) );
+		ASSERT_EQUAL( 1, digest.getCumulativeDistribution(STATISTICS_TEST_VALUES - 1) );
+		for (double q : { 0.1, 0.5, 0.9 }) {
+			ASSERT_TRUE( isClose(q, digest.getCumulativeDistribution(q * STATISTICS_TEST_VALUES), 0.01) );
+		}
+	}
+
+	/**
+	 * Un t-digest vuoto non ha quantili; un t-digest con un solo valore restituisce sempre quel valore.
+	 */
+	TEST(TDigestHandlesEmptyAndSingleValueDigests) {
+		TDigest digest = TDigest();
+		ASSERT_TRUE( std::isnan(digest.getQuantile(0.5)) );
+		ASSERT_TRUE( std::isnan(digest.getCumulativeDistribution(0)) );
+
+		digest.add(42);
+		for (double q : { 0.0, 0.5, 1.0 }) {
+			ASSERT_EQUAL( 42, digest.getQuantile(q) );
+		}
+	}
+
+	/**
+	 * La combinazione di due t-digest costruiti su metà dei valori produce le stesse stime
+	 * (a meno della tolleranza) del t-digest costruito sull'intera sequenza.
+	 */
+	TEST(TDigestMergeMatchesSingleDigest) {
+		TDigest whole = TDigest();
+		TDigest first_half = TDigest();
+		TDigest second_half = TDigest();
+		for (unsigned int i = 0; i < STATISTICS_TEST_VALUES; i++) {
+			whole.add(getTestValue(i));
+			(i % 2 == 0 ? first_half : second_half).add(getTestValue(i));
+		}
+		first_half.merge(second_half);
+
+		ASSERT_EQUAL( whole.getCount(), first_half.getCount() );
+		ASSERT_EQUAL( whole.getQuantile(0), first_half.getQuantile(0) );
+		ASSERT_EQUAL( whole.getQuantile(1), first_half.getQuantile(1) );
+		for (double q : { 0.01, 0.25, 0.5, 0.75, 0.99 }) {
+			ASSERT_TRUE( isClose(whole.getQuantile(q), first_half.getQuantile(q), STATISTICS_TEST_VALUES * 0.01) );
+		}
+	}
+
+	/**
+	 * Minimo, massimo, media e varianza campionaria sono esatti, anche dopo la combinazione
+	 * di due accumulatori (e con un accumulatore vuoto).
+	 */
+	TEST(StatAccumulatorComputesExactMoments) {
+		StatAccumulator whole = StatAccumulator();
+		StatAccumulator first_half = StatAccumulator();
+		StatAccumulator second_half = StatAccumulator();
+		for (unsigned int i = 0; i < STATISTICS_TEST_VALUES; i++) {
+			whole.add(getTestValue(i));
+			(i < STATISTICS_TEST_VALUES / 3 ? first_half : second_half).add(getTestValue(i));
+		}
+		first_half.merge(second_half);
+		first_half.merge(StatAccumulator());
+
+		// Varianza campionaria degli interi 0, 1, ..., N-1: N(N+1)/12
+		double expected_mean = (STATISTICS_TEST_VALUES - 1) / 2.0;
+		double expected_variance = STATISTICS_TEST_VALUES * (STATISTICS_TEST_VALUES + 1.0) / 12;
+		for (StatAccumulator* accumulator : { &whole, &first_half }) {
+			ASSERT_EQUAL( STATISTICS_TEST_VALUES, accumulator->getCount() );
+			ASSERT_EQUAL( 0, accumulator->getMin() );
+			ASSERT_EQUAL( STATISTICS_TEST_VALUES - 1, accumulator->getMax() );
+			ASSERT_TRUE( isClose(expected_mean, accumulator->getMean(), 1e-6) );
+			ASSERT_TRUE( isClose(expected_variance, accumulator->getVariance(), 1e-3) );
+			ASSERT_TRUE( isClose(sqrt(expected_variance), accumulator->getStandardDeviation(), 1e-6) );
+		}
+
+		whole.reset();
+		ASSERT_EQUAL( 0, whole.getCount() );
+		ASSERT_EQUAL( 0, whole.getVariance() );
+	}
+
+} /* namespace translated_automata */
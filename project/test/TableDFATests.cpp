@@ -0,0 +1,158 @@
+/*
+ * TableDFATests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della rappresentazione tabellare dei DFA (TableDFA): entrambe le disposizioni devono riconoscere
+ * le stesse parole del DFA originale, la minimizzazione deve preservare il linguaggio producendo un automa
+ * non ulteriormente riducibile, e la verifica di equivalenza deve distinguere linguaggi diversi.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include "SubsetConstruction.hpp"
+#include "TableDFA.hpp"
+
+#define TABLE_DFA_TEST_CASES 		300		// Numero di automi casuali
+#define TABLE_DFA_TEST_WORDS 		100		// Numero di parole riconosciute per ciascun automa
+#define TABLE_DFA_TEST_MAX_LENGTH 	10		// Lunghezza massima delle parole
+
+namespace translated_automata {
+
+	/**
+	 * Genera una parola casuale sulle label dell'alfabeto.
+	 */
+	static vector<string> buildRandomWord(TestRandom& random, const Alphabet& alphabet) {
+		vector<string> word;
+		unsigned int length = random.next(TABLE_DFA_TEST_MAX_LENGTH + 1);
+		for (unsigned int i = 0; i < length; i++) {
+			word.push_back(alphabet[random.next(alphabet.size())]);
+		}
+		return word;
+	}
+
+	/**
+	 * Riconosce la parola con il DFA originale.
+	 */
+	static bool acceptsWithDFA(DFA* dfa, const vector<string>& word) {
+		StateDFA* current = dfa->getInitialState();
+		for (const string& label : word) {
+			if (current == NULL) {
+				return false;
+			}
+			current = current->getChild(label);
+		}
+		return current != NULL && current->isFinal();
+	}
+
+	/**
+	 * Riconosce la parola con l'automa tabellare.
+	 */
+	static bool acceptsWithTable(const TableDFA& table, const vector<string>& word) {
+		uint32_t current = table.getInitialState();
+		for (const string& label : word) {
+			if (current == TABLE_DFA_NO_STATE) {
+				return false;
+			}
+			current = table.getChild(current, table.getLabelIndex().getId(label));
+		}
+		return current != TABLE_DFA_NO_STATE && table.isFinal(current);
+	}
+
+	/**
+	 * Le disposizioni DENSE e SPARSE riconoscono le stesse parole del DFA originale, e lo stesso vale
+	 * per l'automa minimizzato.
+	 */
+	TEST(TableDFALayoutsMatchDFA) {
+		for (unsigned int seed = 0; seed < TABLE_DFA_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(10), alphabet);
+
+			TableDFA dense = TableDFA(dfa, TABLE_DFA_DENSE);
+			TableDFA sparse = TableDFA(dfa, TABLE_DFA_SPARSE);
+			TableDFA minimized = dense.minimize();
+			ASSERT_EQUAL( TABLE_DFA_DENSE, dense.getLayout() );
+			ASSERT_EQUAL( TABLE_DFA_SPARSE, sparse.getLayout() );
+			ASSERT_EQUAL( dfa->size(), dense.size() );
+			ASSERT_EQUAL( dense.getTransitionsCount(), sparse.getTransitionsCount() );
+			for (uint32_t state = 0; state < dense.size(); state++) {
+				ASSERT_TRUE( dense.getTransitions(state) == sparse.getTransitions(state) );
+			}
+
+			for (unsigned int w = 0; w < TABLE_DFA_TEST_WORDS; w++) {
+				vector<string> word = buildRandomWord(random, alphabet);
+				bool expected = acceptsWithDFA(dfa, word);
+				ASSERT_EQUAL( expected, acceptsWithTable(dense, word) );
+				ASSERT_EQUAL( expected, acceptsWithTable(sparse, word) );
+				ASSERT_EQUAL( expected, acceptsWithTable(minimized, word) );
+			}
+
+			delete dfa;
+		}
+	}
+
+	/**
+	 * Il DFA minimizzato è equivalente all'originale, non ha più stati di quest'ultimo e non viene
+	 * ulteriormente ridotto da una seconda minimizzazione; il risultato non dipende dalla disposizione.
+	 */
+	TEST(MinimizedTableDFAIsEquivalentAndMinimal) {
+		SubsetConstruction sc = SubsetConstruction();
+		for (unsigned int seed = 0; seed < TABLE_DFA_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(3));
+			NFA* nfa = buildRandomNFA(random, 3 + random.next(8), alphabet, 20);
+			DFA* dfa = sc.run(nfa);
+
+			TableDFA table = TableDFA(dfa);
+			TableDFA minimized = table.minimize();
+			TableDFA minimized_sparse = TableDFA(dfa, TABLE_DFA_SPARSE).minimize();
+			ASSERT_TRUE( minimized.size() <= table.size() );
+			ASSERT_EQUAL( minimized.size(), minimized.minimize().size() );
+			ASSERT_EQUAL( minimized.size(), minimized_sparse.size() );
+			ASSERT_TRUE( TableDFA::equivalent(table, minimized) );
+			ASSERT_TRUE( TableDFA::equivalent(minimized_sparse, table) );
+
+			// La conversione in DFA non altera il linguaggio
+			DFA* round_trip = minimized.toDFA();
+			ASSERT_TRUE( TableDFA::equivalent(TableDFA(round_trip), table) );
+
+			delete round_trip;
+			delete dfa;
+			delete nfa;
+		}
+	}
+
+	/**
+	 * Modificare la finalità dello stato iniziale cambia l'appartenenza della parola vuota al linguaggio,
+	 * e quindi rende i due automi non equivalenti; una label aggiuntiva priva di transizioni, invece,
+	 * non altera il linguaggio.
+	 */
+	TEST(EquivalentDistinguishesDifferentLanguages) {
+		for (unsigned int seed = 0; seed < TABLE_DFA_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(2 + random.next(4));
+			DFA* dfa = buildRandomDFA(random, 3 + random.next(10), alphabet);
+			TableDFA original = TableDFA(dfa);
+
+			StateDFA* initial_state = dfa->getInitialState();
+			initial_state->setFinal(!initial_state->isFinal());
+			TableDFA flipped = TableDFA(dfa);
+			ASSERT_FALSE( TableDFA::equivalent(original, flipped) );
+			ASSERT_FALSE( TableDFA::equivalent(flipped.minimize(), original.minimize()) );
+			initial_state->setFinal(!initial_state->isFinal());
+
+			StateDFA* isolated_state = new StateDFA("isolated");
+			isolated_state->connectChild("extra", isolated_state);
+			dfa->addState(isolated_state);
+			TableDFA extended = TableDFA(dfa);
+			ASSERT_TRUE( TableDFA::equivalent(original, extended) );
+			ASSERT_TRUE( TableDFA::equivalent(extended, original) );
+
+			delete dfa;
+		}
+	}
+
+} /* namespace translated_automata */
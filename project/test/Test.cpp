@@ -0,0 +1,118 @@
+/*
+ * Test.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione del framework dei test e del main che li esegue.
+ *
+ * 	Usage: "bin/test [filtro]"
+ * 		filtro		Esegue solamente i test il cui nome contiene la stringa indicata
+ *
+ * Il programma termina con codice di uscita non nullo se almeno un test fallisce.
+ *
+ */
+
+#include "Test.hpp"
+
+#include <cstdio>
+#include <exception>
+#include <iostream>
+
+namespace translated_automata {
+
+	/**
+	 * Costruttore.
+	 */
+	Test::Test(const string& name, std::function<void()> function) {
+		this->m_name = name;
+		this->m_function = function;
+	}
+
+	/**
+	 * Distruttore.
+	 */
+	Test::~Test() {}
+
+	const string& Test::getName() const {
+		return this->m_name;
+	}
+
+	/**
+	 * Esegue il test. In caso di fallimento viene lanciata un'eccezione.
+	 */
+	void Test::run() {
+		this->m_function();
+	}
+
+	/**
+	 * Metodo statico.
+	 * Registra un nuovo test e lo restituisce.
+	 */
+	Test* Test::registerTest(const string& name, std::function<void()> function) {
+		Test* test = new Test(name, function);
+		Test::getRegisteredTests().push_back(test);
+		return test;
+	}
+
+	/**
+	 * Metodo statico.
+	 * Restituisce la lista dei test registrati, nell'ordine di registrazione.
+	 * Nota: la lista è creata al primo utilizzo, poiché la registrazione avviene durante l'inizializzazione
+	 * degli oggetti statici, in un ordine non definito fra i diversi file.
+	 */
+	vector<Test*>& Test::getRegisteredTests() {
+		static vector<Test*> tests;
+		return tests;
+	}
+
+	/**
+	 * Metodo statico.
+	 * Interrompe il test corrente segnalando la verifica non soddisfatta.
+	 */
+	void Test::fail(const char* file, int line, const string& condition) {
+		throw TestFailure { string(file) + "(" + std::to_string(line) + ") : " + condition };
+	}
+
+} /* namespace translated_automata */
+
+using namespace translated_automata;
+
+int main(int argc, char** argv) {
+	string filter = "";
+	if (argc > 2 || (argc == 2 && argv[1][0] == '-')) {
+		std::cerr << "Usage: " << argv[0] << " [filtro]" << std::endl;
+		return 1;
+	} else if (argc == 2) {
+		filter = argv[1];
+	}
+
+	unsigned int executed = 0;
+	unsigned int failed = 0;
+	for (Test* test : Test::getRegisteredTests()) {
+		if (test->getName().find(filter) == string::npos) {
+			continue;
+		}
+		executed++;
+		string error = "";
+		try {
+			test->run();
+		} catch (const TestFailure& failure) {
+			error = failure.message;
+		} catch (const char* exception) {
+			error = string("Eccezione: ") + exception;
+		} catch (const std::exception& exception) {
+			error = string("Eccezione: ") + exception.what();
+		}
+
+		if (error.empty()) {
+			printf("[  OK  ] %s\n", test->getName().c_str());
+		} else {
+			failed++;
+			printf("[ FAIL ] %s\n\t%s\n", test->getName().c_str(), error.c_str());
+		}
+		fflush(stdout);
+	}
+
+	printf("%u test eseguiti, %u falliti\n", executed, failed);
+	return (failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * Test.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Framework minimale per i test di regressione degli algoritmi e delle strutture dati del progetto.
+ * Un test è una funzione senza parametri, registrata tramite la macro TEST: le verifiche vengono effettuate
+ * con le macro ASSERT_*, che al primo fallimento interrompono il test riportando file, riga e condizione.
+ * Anche le eccezioni lanciate dal codice del progetto (stringhe "const char*") fanno fallire il test.
+ *
+ * 	Usage:
+ * 		TEST(NomeDelTest) {
+ * 			... preparazione ...
+ * 			ASSERT_TRUE( condizione );
+ * 			ASSERT_EQUAL( valore_atteso, valore_ottenuto );
+ * 		}
+ *
+ */
+
+#ifndef TEST_TEST_HPP_
+#define TEST_TEST_HPP_
+
+#include <functional>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/** Registrazione di un test, da utilizzare a livello di file */
+#define _TEST_CONCAT( x, y )	x ## y
+#define TEST_CONCAT( x, y )		_TEST_CONCAT( x, y )
+#define TEST( name ) \
+	static void name(); \
+	static translated_automata::Test* TEST_CONCAT(test_, __LINE__) = \
+			translated_automata::Test::registerTest(#name, name); \
+	static void name()
+
+/** Verifiche all'interno di un test */
+#define ASSERT_TRUE( condition ) \
+	do { if (!(condition)) translated_automata::Test::fail(__FILE__, __LINE__, "ASSERT_TRUE( " #condition " )"); } while (0)
+#define ASSERT_FALSE( condition ) \
+	do { if (condition) translated_automata::Test::fail(__FILE__, __LINE__, "ASSERT_FALSE( " #condition " )"); } while (0)
+#define ASSERT_EQUAL( expected, actual ) \
+	do { if (!((expected) == (actual))) translated_automata::Test::fail(__FILE__, __LINE__, "ASSERT_EQUAL( " #expected ", " #actual " )"); } while (0)
+
+namespace translated_automata {
+
+	/**
+	 * Fallimento di una verifica, con la posizione e la descrizione della condizione non soddisfatta.
+	 */
+	struct TestFailure {
+		string message;
+	};
+
+	/**
+	 * Test registrato.
+	 */
+	class Test {
+
+	private:
+		string m_name;
+		std::function<void()> m_function;
+
+	public:
+		Test(const string& name, std::function<void()> function);
+		~Test();
+
+		const string& getName() const;
+		void run();
+
+		static Test* registerTest(const string& name, std::function<void()> function);
+		static vector<Test*>& getRegisteredTests();
+		[[noreturn]] static void fail(const char* file, int line, const string& condition);
+
+	};
+
+} /* namespace translated_automata */
+
+#endif /* TEST_TEST_HPP_ */
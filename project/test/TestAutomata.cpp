@@ -0,0 +1,109 @@
+/*
+ * TestAutomata.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Implementazione delle funzioni di supporto ai test sugli automi.
+ *
+ */
+
+#include "TestAutomata.hpp"
+
+#include "SubsetConstruction.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Restituisce l'alfabeto delle prime "size" lettere minuscole.
+	 */
+	Alphabet buildTestAlphabet(unsigned int size) {
+		Alphabet alphabet;
+		for (unsigned int i = 0; i < size; i++) {
+			alphabet.push_back(string(1, 'a' + i));
+		}
+		return alphabet;
+	}
+
+	/**
+	 * Costruisce un DFA casuale con "size" stati q0, q1, ..., tutti raggiungibili dallo stato iniziale q0.
+	 * Ogni stato (escluso q0) viene raggiunto da uno stato precedente; le altre transizioni sono aggiunte
+	 * casualmente, senza mai associare due figli alla stessa label.
+	 */
+	DFA* buildRandomDFA(TestRandom& random, unsigned int size, const Alphabet& alphabet) {
+		DFA* dfa = new DFA();
+		vector<StateDFA*> states;
+		for (unsigned int i = 0; i < size; i++) {
+			StateDFA* state = new StateDFA("q" + std::to_string(i), random.chance(25));
+			dfa->addState(state);
+			states.push_back(state);
+		}
+		dfa->setInitialState(states[0]);
+
+		// Transizioni che rendono raggiungibili tutti gli stati
+		for (unsigned int i = 1; i < size; i++) {
+			StateDFA* parent = states[random.next(i)];
+			string label = alphabet[random.next(alphabet.size())];
+			while (parent->hasExitingTransition(label)) {
+				parent = states[random.next(i)];
+				label = alphabet[random.next(alphabet.size())];
+			}
+			dfa->connectStates(parent, states[i], label);
+		}
+
+		// Transizioni aggiuntive
+		for (StateDFA* state : states) {
+			for (string label : alphabet) {
+				if (!state->hasExitingTransition(label) && random.chance(40)) {
+					dfa->connectStates(state, states[random.next(size)], label);
+				}
+			}
+		}
+		return dfa;
+	}
+
+	/**
+	 * Costruisce un NFA casuale con "size" stati q0, q1, ..., tutti raggiungibili dallo stato iniziale q0.
+	 * Ogni stato (escluso q0) viene raggiunto da uno stato precedente; le altre transizioni sono aggiunte
+	 * casualmente, anche più di una per label. Se "epsilon_percentage" è positivo, ciascuna transizione
+	 * aggiuntiva può essere una epsilon-transizione con la percentuale di probabilità indicata.
+	 */
+	NFA* buildRandomNFA(TestRandom& random, unsigned int size, const Alphabet& alphabet, unsigned int epsilon_percentage) {
+		NFA* nfa = new NFA();
+		vector<StateNFA*> states;
+		for (unsigned int i = 0; i < size; i++) {
+			StateNFA* state = new StateNFA("q" + std::to_string(i), random.chance(25));
+			nfa->addState(state);
+			states.push_back(state);
+		}
+		nfa->setInitialState(states[0]);
+
+		// Transizioni che rendono raggiungibili tutti gli stati
+		for (unsigned int i = 1; i < size; i++) {
+			nfa->connectStates(states[random.next(i)], states[i], alphabet[random.next(alphabet.size())]);
+		}
+
+		// Transizioni aggiuntive
+		for (StateNFA* state : states) {
+			for (string label : alphabet) {
+				while (random.chance(30)) {
+					string transition_label = random.chance(epsilon_percentage) ? EPSILON : label;
+					nfa->connectStates(state, states[random.next(size)], transition_label);
+				}
+			}
+		}
+		return nfa;
+	}
+
+	/**
+	 * Verifica che il DFA passato come parametro coincida con il risultato della Subset Construction
+	 * applicata all'NFA (stessi stati, per nome, e stesse transizioni).
+	 */
+	bool isSubsetConstructionOf(DFA* result, NFA* nfa) {
+		SubsetConstruction sc = SubsetConstruction();
+		DFA* expected = sc.run(nfa);
+		bool equal = (*expected == *result);
+		delete expected;
+		return equal;
+	}
+
+} /* namespace translated_automata */
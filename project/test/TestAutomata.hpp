@@ -0,0 +1,52 @@
+/*
+ * TestAutomata.hpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Costruzione degli automi utilizzati nei test e confronto dei risultati con la Subset Construction.
+ * Gli automi casuali sono generati con un generatore pseudo-casuale locale e deterministico,
+ * così che ciascun seme individui sempre lo stesso automa (e un eventuale fallimento sia riproducibile).
+ *
+ */
+
+#ifndef TEST_TESTAUTOMATA_HPP_
+#define TEST_TESTAUTOMATA_HPP_
+
+#include <random>
+
+#include "Alphabet.hpp"
+#include "Automaton.hpp"
+
+namespace translated_automata {
+
+	/**
+	 * Generatore pseudo-casuale dei test.
+	 */
+	class TestRandom {
+
+	private:
+		std::mt19937 m_engine;
+
+	public:
+		TestRandom(unsigned int seed) : m_engine(seed) {};
+
+		/** Restituisce un intero in [0, bound) */
+		unsigned int next(unsigned int bound) {
+			return this->m_engine() % bound;
+		}
+
+		/** Restituisce TRUE con la percentuale di probabilità indicata */
+		bool chance(unsigned int percentage) {
+			return this->next(100) < percentage;
+		}
+
+	};
+
+	Alphabet buildTestAlphabet(unsigned int size);
+	DFA* buildRandomDFA(TestRandom& random, unsigned int size, const Alphabet& alphabet);
+	NFA* buildRandomNFA(TestRandom& random, unsigned int size, const Alphabet& alphabet, unsigned int epsilon_percentage);
+	bool isSubsetConstructionOf(DFA* result, NFA* nfa);
+
+} /* namespace translated_automata */
+
+#endif /* TEST_TESTAUTOMATA_HPP_ */
@@ -0,0 +1,156 @@
+/*
+ * TransitionMapTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test dei contenitori "piatti" delle transizioni: il contenuto e l'ordine di iterazione devono
+ * coincidere con quelli dei contenitori della STL che sostituiscono, sia finché gli elementi sono
+ * memorizzati internamente sia dopo il passaggio alla memoria dinamica, anche a seguito di rimozioni.
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include <map>
+#include <set>
+
+#include "TransitionMap.hpp"
+
+#define TRANSITION_MAP_TEST_CASES 	500		// Numero di sequenze casuali di operazioni
+#define TRANSITION_MAP_TEST_STEPS 	40		// Numero di operazioni per ciascuna sequenza
+
+namespace translated_automata {
+
+	/**
+	 * Verifica che l'insieme abbia lo stesso contenuto, nello stesso ordine, dell'insieme della STL.
+	 */
+	template <class S>
+	static bool hasSameStates(const TargetSet<S>& targets, const std::set<S*>& expected) {
+		return targets.size() == expected.size() && std::equal(targets.begin(), targets.end(), expected.begin());
+	}
+
+	/**
+	 * Un TargetSet che supera la capacità interna passa alla memoria dinamica mantenendo l'ordine,
+	 * e torna a quella interna solo dopo essere stato svuotato.
+	 */
+	TEST(TargetSetSpillsToHeapAndErases) {
+		vector<StateNFA*> states;
+		for (unsigned int i = 0; i < 8; i++) {
+			states.push_back(new StateNFA("s" + std::to_string(i)));
+		}
+
+		for (unsigned int seed = 0; seed < TRANSITION_MAP_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			TargetSet<StateNFA> targets;
+			std::set<StateNFA*> expected;
+			for (unsigned int step = 0; step < TRANSITION_MAP_TEST_STEPS; step++) {
+				StateNFA* state = states[random.next(states.size())];
+				if (random.chance(60)) {
+					ASSERT_EQUAL( expected.insert(state).second, targets.insert(state) );
+				} else {
+					ASSERT_EQUAL( expected.erase(state), targets.erase(state) );
+				}
+				ASSERT_TRUE( hasSameStates(targets, expected) );
+				ASSERT_EQUAL( expected.count(state), targets.count(state) );
+			}
+
+			// Svuotamento tramite rimozione per posizione
+			while (!targets.empty()) {
+				expected.erase(*targets.begin());
+				targets.erase(targets.begin());
+				ASSERT_TRUE( hasSameStates(targets, expected) );
+			}
+			ASSERT_TRUE( targets.insert(states[0]) );
+			ASSERT_EQUAL( 1, targets.size() );
+		}
+
+		for (StateNFA* state : states) {
+			delete state;
+		}
+	}
+
+	/**
+	 * Una SmallVector di elementi non banali (stringhe) conserva il contenuto durante il passaggio
+	 * alla memoria dinamica, le rimozioni e lo svuotamento.
+	 */
+	TEST(SmallVectorMovesElementsWhenSpilling) {
+		SmallVector<string, 2> vector;
+		std::vector<string> expected;
+		for (unsigned int i = 0; i < 5; i++) {
+			string element = "element" + std::to_string(i);
+			expected.insert(expected.begin(), element);
+			vector.insert(vector.begin(), std::move(element));
+			ASSERT_TRUE( std::equal(vector.begin(), vector.end(), expected.begin(), expected.end()) );
+		}
+		vector.erase(vector.begin() + 2);
+		expected.erase(expected.begin() + 2);
+		ASSERT_TRUE( std::equal(vector.begin(), vector.end(), expected.begin(), expected.end()) );
+
+		vector.clear();
+		ASSERT_TRUE( vector.empty() );
+		vector.insert(vector.end(), "inline");
+		ASSERT_EQUAL( 1, vector.size() );
+		ASSERT_EQUAL( "inline", *vector.begin() );
+	}
+
+	/**
+	 * Una TransitionMap si comporta come la mappa std::map<string, std::set<S*>> che sostituisce:
+	 * stesso ordine delle label, stessi insiemi, e l'operatore [] inserisce un insieme vuoto.
+	 */
+	TEST(TransitionMapMatchesStdMap) {
+		Alphabet alphabet = buildTestAlphabet(6);
+		vector<StateNFA*> states;
+		for (unsigned int i = 0; i < 4; i++) {
+			states.push_back(new StateNFA("s" + std::to_string(i)));
+		}
+
+		for (unsigned int seed = 0; seed < TRANSITION_MAP_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			TransitionMap<StateNFA> transitions;
+			std::map<string, std::set<StateNFA*>> expected;
+			for (unsigned int step = 0; step < TRANSITION_MAP_TEST_STEPS; step++) {
+				string label = alphabet[random.next(alphabet.size())];
+				StateNFA* state = states[random.next(states.size())];
+				if (random.chance(70)) {
+					transitions[label].insert(state);
+					expected[label].insert(state);
+				} else if (transitions.count(label)) {
+					transitions[label].erase(state);
+					expected[label].erase(state);
+				}
+
+				ASSERT_EQUAL( expected.size(), transitions.size() );
+				auto expected_it = expected.begin();
+				for (auto &pair : transitions) {
+					ASSERT_EQUAL( expected_it->first, pair.first );
+					ASSERT_TRUE( hasSameStates(pair.second, expected_it->second) );
+					expected_it++;
+				}
+				ASSERT_EQUAL( expected.count(label), transitions.count(label) );
+				if (expected.count(label)) {
+					ASSERT_TRUE( hasSameStates(transitions.at(label), expected.at(label)) );
+				}
+			}
+
+			bool thrown = false;
+			try {
+				transitions.at("missing");
+			} catch (const char*) {
+				thrown = true;
+			}
+			ASSERT_TRUE( thrown );
+			ASSERT_TRUE( transitions.find("missing") == transitions.end() );
+			ASSERT_TRUE( transitions["missing"].empty() );
+			ASSERT_EQUAL( 1, transitions.count("missing") );
+
+			transitions.clear();
+			ASSERT_TRUE( transitions.empty() );
+		}
+
+		for (StateNFA* state : states) {
+			delete state;
+		}
+	}
+
+} /* namespace translated_automata */
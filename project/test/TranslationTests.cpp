@@ -0,0 +1,164 @@
+/*
+ * TranslationTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test della composizione, della controimmagine e dell'inversa delle traduzioni, sia nella forma
+ * originale (Translation) sia nella forma compilata (CompiledTranslation).
+ *
+ */
+
+#include "Test.hpp"
+#include "TestAutomata.hpp"
+
+#include <algorithm>
+
+#include "CompiledTranslation.hpp"
+#include "Translation.hpp"
+
+#define TRANSLATION_TEST_CASES 		2000	// Numero di coppie (alfabeto, traduzione) casuali
+
+namespace translated_automata {
+
+	/**
+	 * Costruisce una traduzione casuale dell'alfabeto, in cui alcune label vengono tradotte in EPSILON.
+	 */
+	static map<string, string> buildRandomTranslationMap(TestRandom& random, const Alphabet& alphabet, unsigned int epsilon_percentage) {
+		map<string, string> translation_map;
+		for (string label : alphabet) {
+			translation_map[label] = random.chance(epsilon_percentage) ? EPSILON : alphabet[random.next(alphabet.size())];
+		}
+		return translation_map;
+	}
+
+	/**
+	 * Costruisce una permutazione casuale dell'alfabeto, che è quindi invertibile.
+	 */
+	static map<string, string> buildRandomPermutationMap(TestRandom& random, const Alphabet& alphabet) {
+		Alphabet permuted_alphabet = alphabet;
+		for (unsigned int i = permuted_alphabet.size() - 1; i > 0; i--) {
+			std::swap(permuted_alphabet[i], permuted_alphabet[random.next(i + 1)]);
+		}
+		map<string, string> translation_map;
+		for (unsigned int i = 0; i < alphabet.size(); i++) {
+			translation_map[alphabet[i]] = permuted_alphabet[i];
+		}
+		return translation_map;
+	}
+
+	/**
+	 * La composizione equivale ad applicare le due traduzioni in sequenza, con entrambe le rappresentazioni.
+	 */
+	TEST(ComposedTranslationMatchesSequentialTranslations) {
+		for (unsigned int seed = 0; seed < TRANSLATION_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(1 + random.next(8));
+			Translation first = Translation(buildRandomTranslationMap(random, alphabet, 15));
+			Translation second = Translation(buildRandomTranslationMap(random, alphabet, 15));
+
+			Translation* composed = second.compose(&first);
+			LabelIndex source_index = LabelIndex(alphabet);
+			CompiledTranslation compiled_first = CompiledTranslation(&first, source_index);
+			CompiledTranslation compiled_second = CompiledTranslation(&second, compiled_first.getTargetLabelIndex());
+			CompiledTranslation compiled_composed = compiled_second.compose(compiled_first);
+			const LabelIndex& target_index = compiled_composed.getTargetLabelIndex();
+
+			for (const string& label : alphabet) {
+				string expected = second.translate(first.translate(label));
+				ASSERT_EQUAL( expected, composed->translate(label) );
+				ASSERT_EQUAL( expected, target_index.getLabel(compiled_composed.translate(source_index.getId(label))) );
+			}
+			ASSERT_EQUAL( target_index.getUnknownId(), compiled_composed.translate(source_index.getUnknownId()) );
+			ASSERT_EQUAL( target_index.getEpsilonId(), compiled_composed.translate(source_index.getEpsilonId()) );
+			delete composed;
+		}
+	}
+
+	/**
+	 * Le controimmagini contengono tutte e sole le label tradotte nella label indicata.
+	 */
+	TEST(PreimagesAreConsistentWithTranslate) {
+		for (unsigned int seed = 0; seed < TRANSLATION_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(1 + random.next(8));
+			Translation translation = Translation(buildRandomTranslationMap(random, alphabet, 15));
+			LabelIndex source_index = LabelIndex(alphabet);
+			CompiledTranslation compiled = CompiledTranslation(&translation, source_index);
+			const LabelIndex& target_index = compiled.getTargetLabelIndex();
+
+			unsigned long int preimages_size = 0;
+			for (LabelId target = 0; target <= target_index.getEpsilonId(); target++) {
+				vector<LabelId> preimage = compiled.preimage(target);
+				preimages_size += preimage.size();
+				for (LabelId source : preimage) {
+					ASSERT_EQUAL( target, compiled.translate(source) );
+				}
+			}
+			// Ogni identificatore originale, compresi quelli riservati, appartiene ad una sola controimmagine
+			ASSERT_EQUAL( source_index.getEpsilonId() + 1, preimages_size );
+
+			for (const string& target : alphabet) {
+				Alphabet preimage = translation.preimage(target, alphabet);
+				for (const string& source : alphabet) {
+					bool in_preimage = std::find(preimage.begin(), preimage.end(), source) != preimage.end();
+					ASSERT_EQUAL( translation.translate(source) == target, in_preimage );
+				}
+			}
+		}
+	}
+
+	/**
+	 * L'inversa di una permutazione, composta con la permutazione stessa, è l'identità.
+	 */
+	TEST(InverseOfPermutationRoundTrips) {
+		for (unsigned int seed = 0; seed < TRANSLATION_TEST_CASES; seed++) {
+			TestRandom random = TestRandom(seed);
+			Alphabet alphabet = buildTestAlphabet(1 + random.next(8));
+			Translation translation = Translation(buildRandomPermutationMap(random, alphabet));
+
+			Translation* inverse = translation.inverse(alphabet);
+			LabelIndex source_index = LabelIndex(alphabet);
+			CompiledTranslation compiled = CompiledTranslation(&translation, source_index);
+			CompiledTranslation compiled_inverse = compiled.inverse();
+			for (const string& label : alphabet) {
+				ASSERT_EQUAL( label, inverse->translate(translation.translate(label)) );
+				LabelId id = source_index.getId(label);
+				ASSERT_EQUAL( id, compiled_inverse.translate(compiled.translate(id)) );
+			}
+			delete inverse;
+		}
+	}
+
+	/**
+	 * Una traduzione non iniettiva, o che produce EPSILON, non è invertibile: viene lanciata un'eccezione.
+	 */
+	TEST(InverseOfNonInjectiveTranslationThrows) {
+		Alphabet alphabet = buildTestAlphabet(3);
+		LabelIndex source_index = LabelIndex(alphabet);
+		vector<map<string, string>> translation_maps = {
+			{ { alphabet[0], alphabet[1] } },		// Due label tradotte nella stessa label
+			{ { alphabet[2], EPSILON } },			// Una label tradotta in EPSILON
+		};
+
+		for (map<string, string>& translation_map : translation_maps) {
+			Translation translation = Translation(translation_map);
+			bool thrown = false;
+			try {
+				delete translation.inverse(alphabet);
+			} catch (const char*) {
+				thrown = true;
+			}
+			ASSERT_TRUE( thrown );
+
+			CompiledTranslation compiled = CompiledTranslation(&translation, source_index);
+			thrown = false;
+			try {
+				compiled.inverse();
+			} catch (const char*) {
+				thrown = true;
+			}
+			ASSERT_TRUE( thrown );
+		}
+	}
+
+} /* namespace translated_automata */
@@ -0,0 +1,59 @@
+/*
+ * WorkerPoolTests.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Test del pool di thread (WorkerPool) utilizzato dal wavefront processing di ESC:
+ * ogni compito di un gruppo viene eseguito esattamente una volta, e lo stesso pool
+ * può essere riutilizzato per più gruppi successivi.
+ *
+ */
+
+#include "Test.hpp"
+
+#include <atomic>
+
+#include "WorkerPool.hpp"
+
+#define WORKER_POOL_TEST_WORKERS 	3			// Numero di worker del pool (oltre al thread chiamante)
+#define WORKER_POOL_TEST_ROUNDS 	100			// Numero di gruppi di compiti eseguiti con lo stesso pool
+
+namespace translated_automata {
+
+	/**
+	 * Ogni gruppo di compiti, di dimensione variabile, viene eseguito per intero prima che "run"
+	 * restituisca il controllo, e ciascun compito viene eseguito una e una sola volta.
+	 */
+	TEST(WorkerPoolRunsEveryTaskOnceForEachRound) {
+		WorkerPool pool = WorkerPool(WORKER_POOL_TEST_WORKERS);
+		ASSERT_EQUAL( WORKER_POOL_TEST_WORKERS, pool.getWorkersCount() );
+
+		for (unsigned int round = 0; round < WORKER_POOL_TEST_ROUNDS; round++) {
+			unsigned long int tasks_count = round % 17;
+			vector<std::atomic<unsigned int>> executions(tasks_count);
+			pool.run(tasks_count, [&executions](unsigned long int task) {
+				executions[task]++;
+			});
+			for (unsigned long int task = 0; task < tasks_count; task++) {
+				ASSERT_EQUAL( 1, executions[task].load() );
+			}
+		}
+	}
+
+	/**
+	 * Un pool senza worker esegue tutti i compiti sul thread chiamante.
+	 */
+	TEST(WorkerPoolWithoutWorkersRunsOnCallingThread) {
+		WorkerPool pool = WorkerPool(0);
+		std::thread::id caller = std::this_thread::get_id();
+		unsigned long int executed = 0;
+		bool same_thread = true;
+		pool.run(10, [&](unsigned long int) {
+			executed++;
+			same_thread = same_thread && (std::this_thread::get_id() == caller);
+		});
+		ASSERT_EQUAL( 10, executed );
+		ASSERT_TRUE( same_thread );
+	}
+
+} /* namespace translated_automata */
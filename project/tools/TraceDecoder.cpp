@@ -0,0 +1,107 @@
+/*
+ * TraceDecoder.cpp
+ *
+ * Project: TranslatedAutomata
+ *
+ * Tool per la decodifica offline dei file di traccia prodotti dalla libreria Trace.
+ * Stampa gli eventi in formato testuale e, al termine, un riepilogo con il numero di
+ * eventi per tipologia e il numero di applicazioni di ciascuna regola.
+ *
+ * Compilazione: "make trace_decoder"
+ * Utilizzo: "bin/trace_decoder <file di traccia> [--summary]"
+ *
+ */
+
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include "Trace.hpp"
+
+using namespace translated_automata;
+
+/**
+ * Legge un valore binario di tipo T dal file.
+ */
+template <typename T> bool readValue(std::ifstream& file_in, T& value) {
+	file_in.read((char*) &value, sizeof(T));
+	return (bool) file_in;
+}
+
+int main(int argc, char **argv) {
+	if (argc < 2) {
+		std::cerr << "Usage: " << argv[0] << " <trace file> [--summary]" << std::endl;
+		return 1;
+	}
+	bool only_summary = (argc > 2 && strcmp(argv[2], "--summary") == 0);
+
+	std::ifstream file_in(argv[1], std::ios::binary);
+	if (!file_in) {
+		std::cerr << "Unable to open the file \"" << argv[1] << "\"" << std::endl;
+		return 1;
+	}
+
+	// Intestazione
+	char magic[sizeof(TRACE_FILE_MAGIC)] = {};
+	uint32_t version;
+	file_in.read(magic, strlen(TRACE_FILE_MAGIC));
+	if (!file_in || strcmp(magic, TRACE_FILE_MAGIC) != 0 || !readValue(file_in, version) || version != TRACE_FILE_VERSION) {
+		std::cerr << "Invalid trace file (wrong magic number or version)" << std::endl;
+		return 1;
+	}
+
+	// Tabella delle label
+	uint32_t labels_count;
+	readValue(file_in, labels_count);
+	vector<string> labels;
+	for (uint32_t i = 0; i < labels_count; i++) {
+		uint32_t length;
+		readValue(file_in, length);
+		string label(length, '\0');
+		file_in.read(&label[0], length);
+		labels.push_back(label);
+	}
+
+	// Eventi
+	uint64_t recorded, stored;
+	if (!readValue(file_in, recorded) || !readValue(file_in, stored)) {
+		std::cerr << "Truncated trace file" << std::endl;
+		return 1;
+	}
+
+	uint64_t type_counters[TRACE_EVENT_TYPES_COUNT] = {};
+	std::map<int64_t, uint64_t> rule_counters;
+	TraceEvent event;
+	for (uint64_t i = 0; i < stored && readValue(file_in, event); i++) {
+		if (event.type < TRACE_EVENT_TYPES_COUNT) {
+			type_counters[event.type]++;
+		}
+		if (event.type == TRACE_RULE_FIRED) {
+			rule_counters[event.value]++;
+		}
+		if (!only_summary) {
+			string label = (event.label < labels.size()) ? labels[event.label] : "?";
+			printf("[%14.3f us] %-18s state=%" PRIu32 " label=\"%s\" value=%" PRId64 "\n",
+					event.timestamp / 1000.0,
+					TraceBuffer::nameOf((TraceEventType) event.type).c_str(),
+					event.state,
+					label.c_str(),
+					event.value);
+		}
+	}
+
+	// Riepilogo
+	printf("SUMMARY:\n");
+	printf("Events recorded: %" PRIu64 ", stored: %" PRIu64 " (%" PRIu64 " overwritten)\n", recorded, stored, recorded - stored);
+	for (int type = 0; type < TRACE_EVENT_TYPES_COUNT; type++) {
+		printf(" %-18s : %" PRIu64 "\n", TraceBuffer::nameOf((TraceEventType) type).c_str(), type_counters[type]);
+	}
+	for (auto &pair : rule_counters) {
+		printf(" RULE %-13" PRId64 " : %" PRIu64 "\n", pair.first, pair.second);
+	}
+
+	return 0;
+}